@@ -0,0 +1,97 @@
+/**
+ * @file BoundaryMovement.benchmark.cpp
+ * @brief Microbenchmark of moving the droplet boundaries and computing their times until the channel ends.
+ * Compares the loop over the droplets and their boundaries with the structure-of-arrays boundary store of the simulation,
+ * for an emulsion of many droplets in a chain of channels. In each iteration, the times until the channel ends of all
+ * boundaries are computed and the boundaries are moved.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <baseSimulator.h>
+#include <baseSimulator.hh>
+
+using T = double;
+
+namespace {
+
+template<typename F>
+double measure(F&& function, int repetitions) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i) {
+        function();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / repetitions;
+}
+
+}   // namespace
+
+int main() {
+
+    const int nChannels = 1000;
+    const int nDroplets = 10000;
+    const int nIterations = 1000;
+    const T timeStep = 1e-6;
+
+    // Chain of channels with several droplets per channel
+    arch::Network<T> network;
+    std::vector<arch::RectangularChannel<T>*> channels;
+    auto previous = network.addNode(0.0, 0.0, true);
+    for (int i = 0; i < nChannels; ++i) {
+        auto next = network.addNode((i + 1) * 1e-3, 0.0, false);
+        channels.push_back(network.addChannel(previous->getId(), next->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL));
+        previous = next;
+    }
+
+    // The boundaries are created in an object pool, as in the simulation, and either own their positions or are kept in the store
+    sim::Fluid<T> fluid(0, 1e3, 1e-3, 1.0);
+    sim::ObjectPool pool;
+    sim::BoundaryStore<T> store;
+    std::vector<std::unique_ptr<sim::Droplet<T>>> droplets;
+    std::vector<std::unique_ptr<sim::Droplet<T>>> storeDroplets;
+    const int dropletsPerChannel = nDroplets / nChannels;
+    for (int i = 0; i < nDroplets; ++i) {
+        auto channel = channels[i % nChannels];
+        T position = (i / nChannels + 0.25) / dropletsPerChannel;
+        droplets.push_back(std::make_unique<sim::Droplet<T>>(i, 1e-13, &fluid, &pool));
+        storeDroplets.push_back(std::make_unique<sim::Droplet<T>>(i, 1e-13, &fluid, &pool, nullptr, nullptr, &store));
+        for (auto droplet : { droplets.back().get(), storeDroplets.back().get() }) {
+            droplet->addBoundary(channel, position, false, sim::BoundaryState::NORMAL);
+            droplet->addBoundary(channel, position + 0.5 / dropletsPerChannel, true, sim::BoundaryState::NORMAL);
+            droplet->getBoundaries()[0]->setFlowRate(-3e-11);
+            droplet->getBoundaries()[1]->setFlowRate(3e-11);
+            droplet->setDropletState(sim::DropletState::NETWORK);
+        }
+    }
+
+    // Loop over the droplets and their boundaries
+    T loopChecksum = 0.0;
+    double loopTime = measure([&]() {
+        for (auto& droplet : droplets) {
+            for (auto& boundary : droplet->getBoundaries()) {
+                loopChecksum += boundary->getTime();
+                boundary->moveBoundary(timeStep);
+            }
+        }
+    }, nIterations);
+
+    // Structure-of-arrays boundary store
+    T storeChecksum = 0.0;
+    double storeTime = measure([&]() {
+        store.computeTimes();
+        for (size_t slot = 0; slot < store.getSlots(); ++slot) {
+            storeChecksum += store.getTime(slot);
+        }
+        store.move(timeStep);
+    }, nIterations);
+
+    std::cout << "[Benchmark] " << 2 * nDroplets << " boundaries in " << nChannels << " channels, " << nIterations << " iterations." << std::endl;
+    std::cout << "[Benchmark] Loop over droplets and boundaries:\t" << loopTime * 1e3 << " us per iteration\t(checksum " << loopChecksum << ")" << std::endl;
+    std::cout << "[Benchmark] Boundary store:\t" << storeTime * 1e3 << " us per iteration\t(checksum " << storeChecksum << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file EventAllocation.benchmark.cpp
+ * @brief Microbenchmark of the allocations of the events and droplet boundaries of a droplet simulation.
+ * Counts the allocations on the general heap (by replacing the global operator new) while the events of an iteration are
+ * created and discarded, once with std::make_unique and once with the object pool of the simulation, and while the
+ * iterations of a droplet simulation in a channel with a sequence of droplets are stepped, i.e., including the event queue,
+ * the boundary updates and the nodal analysis. Only the initial and the final state are saved, so that the results do not
+ * contribute to the allocations of the iterations.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <baseSimulator.h>
+#include <baseSimulator.hh>
+
+using T = double;
+
+namespace {
+
+size_t heapAllocations = 0;
+
+template<typename F>
+double measure(F&& function, int repetitions) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i) {
+        function();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / repetitions;
+}
+
+}   // namespace
+
+// Count all allocations on the general heap
+void* operator new(std::size_t size) {
+    heapAllocations++;
+    if (void* memory = std::malloc(size > 0 ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+int main() {
+
+    const int nIterations = 100000;
+    const int nBoundaries = 8;
+
+    // Single channel with a droplet, whose boundaries are the targets of the events
+    arch::Network<T> network;
+    auto node0 = network.addNode(0.0, 0.0, true);
+    auto node1 = network.addNode(1e-3, 0.0, false);
+    auto channel = network.addChannel(node0->getId(), node1->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+    sim::Fluid<T> fluid(0, 1e3, 1e-3, 1.0);
+    sim::Droplet<T> droplet(0, 1e-13, &fluid);
+    for (int i = 0; i < nBoundaries; ++i) {
+        droplet.addBoundary(channel, 0.5, i % 2 == 0, sim::BoundaryState::NORMAL);
+    }
+
+    // The pool is declared before the events, so that it outlives them
+    sim::ObjectPool pool;
+    std::vector<std::unique_ptr<sim::Event<T>>> heapEvents;
+    std::vector<sim::PoolPtr<sim::Event<T>>> pooledEvents;
+    heapEvents.reserve(2 * nBoundaries + 1);
+    pooledEvents.reserve(2 * nBoundaries + 1);
+
+    // Events of one iteration with std::make_unique (former computeEvents)
+    size_t allocationsBefore = heapAllocations;
+    double heapTime = measure([&]() {
+        heapEvents.clear();
+        for (auto& boundary : droplet.getBoundaries()) {
+            heapEvents.push_back(std::make_unique<sim::BoundaryHeadEvent<T>>(1.0, droplet, *boundary, network));
+            heapEvents.push_back(std::make_unique<sim::BoundaryTailEvent<T>>(1.0, droplet, *boundary, network));
+        }
+        heapEvents.push_back(std::make_unique<sim::TimeStepEvent<T>>(1.0));
+    }, nIterations);
+    size_t heapEventAllocations = heapAllocations - allocationsBefore;
+
+    // Events of one iteration with the object pool
+    allocationsBefore = heapAllocations;
+    double poolTime = measure([&]() {
+        pooledEvents.clear();
+        for (auto& boundary : droplet.getBoundaries()) {
+            pooledEvents.push_back(pool.create<sim::BoundaryHeadEvent<T>>(1.0, droplet, *boundary, network));
+            pooledEvents.push_back(pool.create<sim::BoundaryTailEvent<T>>(1.0, droplet, *boundary, network));
+        }
+        pooledEvents.push_back(pool.create<sim::TimeStepEvent<T>>(1.0));
+    }, nIterations);
+    size_t poolEventAllocations = heapAllocations - allocationsBefore;
+
+    std::cout << "[Benchmark] " << nIterations << " iterations with " << 2 * nBoundaries + 1 << " events each." << std::endl;
+    std::cout << "[Benchmark] Heap allocations with make_unique:\t" << heapEventAllocations << "\t(" << heapTime * 1e6 << " ns per iteration)" << std::endl;
+    std::cout << "[Benchmark] Heap allocations with object pool:\t" << poolEventAllocations << "\t(" << poolTime * 1e6 << " ns per iteration)" << std::endl;
+    std::cout << "[Benchmark] Objects created by the pool:\t" << pool.getAllocations() << " in " << pool.getHeapAllocations() << " chunks" << std::endl;
+
+    // Droplet simulation in a channel with a sequence of droplets
+    sim::Simulation<T> simulation;
+    simulation.setType(sim::Type::Abstract);
+    simulation.setPlatform(sim::Platform::BigDroplet);
+    simulation.setRecordingPolicy(sim::RecordingPolicy::EventInterval, 1e9);
+
+    arch::Network<T> chain;
+    simulation.setNetwork(&chain);
+    const int nChannels = 20;
+    const int nDroplets = 50;
+    std::vector<arch::RectangularChannel<T>*> channels;
+    auto inlet = chain.addNode(0.0, 0.0, false);
+    auto previous = inlet;
+    for (int i = 0; i < nChannels; ++i) {
+        auto next = chain.addNode((i + 1) * 1e-3, 0.0, false);
+        channels.push_back(chain.addChannel(previous->getId(), next->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL));
+        previous = next;
+    }
+    auto outlet = chain.addNode((nChannels + 1) * 1e-3, 0.0, false);
+    chain.addChannel(previous->getId(), outlet->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+    chain.addFlowRatePump(outlet->getId(), inlet->getId(), 3e-11);
+    chain.setSink(outlet->getId());
+    chain.setGround(outlet->getId());
+
+    auto continuousPhase = simulation.addFluid(1e-3, 1e3, 1.0);
+    auto dispersedPhase = simulation.addFluid(3e-3, 1e3, 1.0);
+    simulation.setContinuousPhase(continuousPhase->getId());
+    for (int i = 0; i < nDroplets; ++i) {
+        auto newDroplet = simulation.addDroplet(dispersedPhase->getId(), 1.5 * 100e-6 * 100e-6 * 30e-6);
+        simulation.addDropletInjection(newDroplet->getId(), i * 0.1, channels.front()->getId(), 0.5);
+    }
+
+    sim::ResistanceModel1D<T> resistanceModel(simulation.getContinuousPhase()->getViscosity());
+    simulation.setResistanceModel(&resistanceModel);
+    chain.isNetworkValid();
+    chain.sortGroups();
+
+    // Allocations of the iterations, without the setup in initialize()
+    simulation.initialize();
+    int nSteps = 0;
+    allocationsBefore = heapAllocations;
+    double simulationTime = measure([&]() {
+        while (simulation.step()) {
+            nSteps++;
+        }
+    }, 1);
+    size_t stepAllocations = heapAllocations - allocationsBefore;
+
+    const auto& simulationPool = simulation.getObjectPool();
+    std::cout << "[Benchmark] Droplet simulation with " << nDroplets << " droplets:\t" << simulationTime << " ms" << std::endl;
+    std::cout << "[Benchmark] Heap allocations of " << nSteps << " iterations:\t" << stepAllocations << "\t(" << static_cast<double>(stepAllocations) / nSteps << " per iteration)" << std::endl;
+    std::cout << "[Benchmark] Events and boundaries created by the pool:\t" << simulationPool.getAllocations() << " in " << simulationPool.getHeapAllocations() << " heap allocations" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file NodalAssembly.benchmark.cpp
+ * @brief Microbenchmark of the assembly of the modified nodal analysis on a 100x100 grid network (10k nodes).
+ * Compares the classification of the nodes by a linear scan over a set of node ids (former nodal::contains) with the
+ * per-row flag array of the nodal analysis, and measures a complete nodal analysis with the sparse solver.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+
+#include <baseSimulator.h>
+#include <baseSimulator.hh>
+
+using T = double;
+
+namespace {
+
+// Membership test of the former nodal analysis, which iterates the whole set
+bool linearContains(const std::unordered_set<int>& set, int key) {
+    bool contain = false;
+    for (auto& nodeId : set) {
+        if (key == nodeId) {
+            contain = true;
+        }
+    }
+    return contain;
+}
+
+template<typename F>
+double measure(F&& function, int repetitions) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; ++i) {
+        function();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / repetitions;
+}
+
+}   // namespace
+
+int main() {
+
+    const int nX = 100;
+    const int nY = 100;
+
+    // Define a grid network with a pressure pump between the ground node and the opposite corner
+    arch::Network<T> network;
+    std::vector<int> nodeIds;
+    for (int j = 0; j < nY; ++j) {
+        for (int i = 0; i < nX; ++i) {
+            nodeIds.push_back(network.addNode(i * 1e-3, j * 1e-3, i == 0 && j == 0)->getId());
+        }
+    }
+    for (int j = 0; j < nY; ++j) {
+        for (int i = 0; i < nX; ++i) {
+            if (i + 1 < nX) {
+                network.addChannel(nodeIds[j*nX + i], nodeIds[j*nX + i + 1], 1.0, arch::ChannelType::NORMAL);
+            }
+            if (j + 1 < nY) {
+                network.addChannel(nodeIds[j*nX + i], nodeIds[(j+1)*nX + i], 1.0, arch::ChannelType::NORMAL);
+            }
+        }
+    }
+    network.addPressurePump(nodeIds.front(), nodeIds.back(), 1e3);
+    network.sortGroups();
+
+    const auto& indexMap = network.getIndexMap();
+    std::cout << "[Benchmark] Grid with " << network.getNodes().size() << " nodes and " << indexMap.channels.size() << " channels." << std::endl;
+
+    // Classification as a set of node ids (former nodal analysis) and as flag array over the rows
+    std::unordered_set<int> conductingNodeIds;
+    std::vector<bool> conductingRows(indexMap.nNodeRows, false);
+    for (const auto& [key, node] : network.getNodes()) {
+        if (!node->getGround()) {
+            conductingNodeIds.emplace(key);
+            conductingRows[indexMap.nodeRows.at(key)] = true;
+        }
+    }
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(4 * indexMap.channels.size());
+
+    // Assembly of matrix G with a linear scan per lookup
+    double linearScan = measure([&]() {
+        triplets.clear();
+        for (size_t i = 0; i < indexMap.channels.size(); ++i) {
+            const int nodeA = indexMap.channels[i]->getNodeA();
+            const int nodeB = indexMap.channels[i]->getNodeB();
+            const T conductance = 1. / indexMap.channels[i]->getResistance();
+            const bool conductingA = linearContains(conductingNodeIds, nodeA);
+            const bool conductingB = linearContains(conductingNodeIds, nodeB);
+            if (conductingA) {
+                triplets.emplace_back(indexMap.channelRowsA[i], indexMap.channelRowsA[i], conductance);
+            }
+            if (conductingB) {
+                triplets.emplace_back(indexMap.channelRowsB[i], indexMap.channelRowsB[i], conductance);
+            }
+            if (conductingA && conductingB) {
+                triplets.emplace_back(indexMap.channelRowsA[i], indexMap.channelRowsB[i], -conductance);
+                triplets.emplace_back(indexMap.channelRowsB[i], indexMap.channelRowsA[i], -conductance);
+            }
+        }
+    }, 3);
+
+    // Assembly of matrix G with the flag array
+    double flagArray = measure([&]() {
+        triplets.clear();
+        for (size_t i = 0; i < indexMap.channels.size(); ++i) {
+            const int rowA = indexMap.channelRowsA[i];
+            const int rowB = indexMap.channelRowsB[i];
+            const T conductance = 1. / indexMap.channels[i]->getResistance();
+            const bool conductingA = rowA >= 0 && conductingRows[rowA];
+            const bool conductingB = rowB >= 0 && conductingRows[rowB];
+            if (conductingA) {
+                triplets.emplace_back(rowA, rowA, conductance);
+            }
+            if (conductingB) {
+                triplets.emplace_back(rowB, rowB, conductance);
+            }
+            if (conductingA && conductingB) {
+                triplets.emplace_back(rowA, rowB, -conductance);
+                triplets.emplace_back(rowB, rowA, -conductance);
+            }
+        }
+    }, 100);
+
+    std::cout << "[Benchmark] Assembly with linear scan lookups:\t" << linearScan << " ms" << std::endl;
+    std::cout << "[Benchmark] Assembly with flag array lookups:\t" << flagArray << " ms" << std::endl;
+    std::cout << "[Benchmark] Speedup:\t\t\t\t" << linearScan / flagArray << std::endl;
+
+    // Complete nodal analysis with the sparse solver (first call includes the symbolic factorization)
+    nodal::NodalAnalysis<T> nodalAnalysis(&network, nodal::SolverType::SparseLU);
+    double firstSolve = measure([&]() { nodalAnalysis.conductNodalAnalysis(); }, 1);
+    double nextSolves = measure([&]() { nodalAnalysis.conductNodalAnalysis(); }, 10);
+
+    std::cout << "[Benchmark] First nodal analysis (SparseLU):\t" << firstSolve << " ms" << std::endl;
+    std::cout << "[Benchmark] Further nodal analyses (SparseLU):\t" << nextSolves << " ms" << std::endl;
+
+    return 0;
+}
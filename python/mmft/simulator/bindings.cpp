@@ -28,6 +28,26 @@ PYBIND11_MODULE(pysimulator, m) {
 		.value("continuous", sim::Platform::Continuous)
 		.value("bigDroplet", sim::Platform::BigDroplet);
 
+	py::enum_<nodal::SolverType>(m, "SolverType")
+		.value("denseQR", nodal::SolverType::DenseQR)
+		.value("sparseLU", nodal::SolverType::SparseLU);
+
+	py::enum_<nodal::AcceleratorType>(m, "AcceleratorType")
+		.value("constant", nodal::AcceleratorType::Constant)
+		.value("aitken", nodal::AcceleratorType::Aitken)
+		.value("anderson", nodal::AcceleratorType::Anderson);
+
+	py::enum_<sim::RecordingPolicy>(m, "RecordingPolicy")
+		.value("all", sim::RecordingPolicy::All)
+		.value("eventInterval", sim::RecordingPolicy::EventInterval)
+		.value("timeInterval", sim::RecordingPolicy::TimeInterval)
+		.value("change", sim::RecordingPolicy::Change);
+
+	py::enum_<arch::VtkOutput>(m, "VtkOutput")
+		.value("disabled", arch::VtkOutput::Disabled)
+		.value("interval", arch::VtkOutput::Interval)
+		.value("final", arch::VtkOutput::Final);
+
 	py::class_<arch::Network<T>>(m, "Network")
 		.def(py::init<>())
 		.def("sort", &arch::Network<T>::sortGroups, "Sort the nodes, channels and modules of the network.")
@@ -51,6 +71,18 @@ PYBIND11_MODULE(pysimulator, m) {
 			return network.addPressurePump(nodeAId, nodeBId, pressure)->getId();
 			}, "Add a new pressure pump to the network.")
 		.def("setPressurePump", &arch::Network<T>::setPressurePump, "Turn a channel into a pressure pump with given pressure.")
+		.def("setPumpFlowRate", [](arch::Network<T> &network, int pumpId, T flowRate) {
+			network.getFlowRatePumps().at(pumpId)->setFlowRate(flowRate);
+			}, "Set the flow rate of a flow rate pump, e.g., between two steps of a simulation.")
+		.def("setPumpPressure", [](arch::Network<T> &network, int pumpId, T pressure) {
+			network.getPressurePumps().at(pumpId)->setPressure(pressure);
+			}, "Set the pressure of a pressure pump, e.g., between two steps of a simulation.")
+		.def("getNodePressure", [](arch::Network<T> &network, int nodeId) {
+			return network.getNode(nodeId)->getPressure();
+			}, "Get the pressure at a node as of the last step of a simulation.")
+		.def("getChannelFlowRate", [](arch::Network<T> &network, int channelId) {
+			return network.getChannel(channelId)->getFlowRate();
+			}, "Get the flow rate of a channel as of the last step of a simulation.")
 		.def("addModule", [](arch::Network<T> &network, 
 								std::string name,
 								std::string stlFile,
@@ -83,6 +115,17 @@ PYBIND11_MODULE(pysimulator, m) {
 									alpha, resolution, epsilon, tau)->getId();
 
 			}, "Add a new node to the network.")
+		.def("setModuleTheta", [](arch::Network<T> &network, int moduleId, int theta) {
+			network.getModules().at(moduleId)->setTheta(theta);
+			}, "Set the number of LBM iterations between two exchanges of boundary values of a module.")
+		.def("setModuleAdaptiveTheta", [](arch::Network<T> &network, int moduleId, bool adaptive, int minTheta, int maxTheta, T tolerance) {
+			network.getModules().at(moduleId)->setAdaptiveTheta(adaptive, minTheta, maxTheta, tolerance);
+			}, "Adapt the number of LBM iterations between two exchanges of boundary values of a module to the change of the boundary values.",
+			"moduleId"_a, "adaptive"_a, "minTheta"_a=1, "maxTheta"_a=1000, "tolerance"_a=1e-3)
+		.def("setModuleVtkOutput", [](arch::Network<T> &network, int moduleId, arch::VtkOutput vtkOutput, int vtkInterval) {
+			network.getModules().at(moduleId)->setVtkOutput(vtkOutput, vtkInterval);
+			}, "Define when the results of a module are written to vtk files.",
+			"moduleId"_a, "vtkOutput"_a, "vtkInterval"_a=1000)
 			.def("loadNetwork", [](arch::Network<T> &network, std::string file) { 
 				porting::networkFromJSON(file, network);
 			});
@@ -92,6 +135,18 @@ PYBIND11_MODULE(pysimulator, m) {
 		.def("setPlatform", &sim::Simulation<T>::setPlatform)
 		.def("setType", &sim::Simulation<T>::setType)
 		.def("setNetwork", &sim::Simulation<T>::setNetwork)
+		.def("setSolverType", &sim::Simulation<T>::setSolverType)
+		.def("setIncrementalNodalUpdates", &sim::Simulation<T>::setIncrementalNodalUpdates)
+		.def("setCFDThreads", &sim::Simulation<T>::setCFDThreads)
+		.def("setDropletThreads", &sim::Simulation<T>::setDropletThreads, "nThreads"_a, "minDropletsPerThread"_a=64)
+		.def("setDeltaHistory", &sim::Simulation<T>::setDeltaHistory, "keyframeInterval"_a, "tolerance"_a=0.0)
+		.def("setCouplingAccelerator", &sim::Simulation<T>::setCouplingAccelerator, "acceleratorType"_a, "andersonDepth"_a=5)
+		.def("setRecordingPolicy", &sim::Simulation<T>::setRecordingPolicy, "policy"_a, "interval"_a=1.0)
+		.def("setRecordedNodes", &sim::Simulation<T>::setRecordedNodes, "nodeIds"_a)
+		.def("setRecordedChannels", &sim::Simulation<T>::setRecordedChannels, "channelIds"_a)
+		.def("setRecordedDroplets", &sim::Simulation<T>::setRecordedDroplets, "dropletIds"_a)
+		.def("setRecordDropletPositions", &sim::Simulation<T>::setRecordDropletPositions, "record"_a)
+		.def("getCouplingIterations", &sim::Simulation<T>::getCouplingIterations)
 		.def("addFluid", [](sim::Simulation<T> &simulation, T density, T viscosity, T concentration) {
 				return simulation.addFluid(viscosity, density, concentration)->getId();
 			})
@@ -101,6 +156,9 @@ PYBIND11_MODULE(pysimulator, m) {
 		.def("injectDroplet", [](sim::Simulation<T> &simulation, int dropletId, T injectionTime, int channelId, T injectionPosition) {
 				simulation.addDropletInjection(dropletId, injectionTime, channelId, injectionPosition);
 			})
+		.def("addDropletGenerator", [](sim::Simulation<T> &simulation, int fluidId, T volume, int channelId, T injectionPosition, T startTime, T period, int count, T endTime) {
+				return simulation.addDropletGenerator(fluidId, volume, channelId, injectionPosition, startTime, period, count, endTime)->getId();
+			}, "fluidId"_a, "volume"_a, "channelId"_a, "injectionPosition"_a, "startTime"_a, "period"_a, "count"_a=-1, "endTime"_a=-1.0)
 		.def("setContinuousPhase", py::overload_cast<int>(&sim::Simulation<T>::setContinuousPhase))
 		.def("setRectangularResistanceModel", [](sim::Simulation<T> & simulation) {
 				sim::ResistanceModel1D<T>* resistanceModel = new sim::ResistanceModel1D<T>(simulation.getContinuousPhase()->getViscosity());
@@ -111,13 +169,29 @@ PYBIND11_MODULE(pysimulator, m) {
 				simulation.setResistanceModel(resistanceModel);
 			})
 		.def("simulate", &sim::Simulation<T>::simulate)
+		.def("initialize", &sim::Simulation<T>::initialize, "Initialize the simulation for a stepwise execution.")
+		.def("step", &sim::Simulation<T>::step, "Conduct the next step of the simulation. Returns false if the simulation is finished.")
+		.def("runEvents", &sim::Simulation<T>::runEvents, "Conduct the next steps (events) of the simulation. Returns the number of conducted steps.", "nSteps"_a)
+		.def("runUntil", &sim::Simulation<T>::runUntil, "Conduct the simulation until a point in time or until it is finished.", "endTime"_a)
+		.def("isFinished", &sim::Simulation<T>::isFinished)
+		.def("getTime", &sim::Simulation<T>::getTime)
 		.def("print", &sim::Simulation<T>::printResults)
 		.def("loadSimulation", [](sim::Simulation<T> &simulation, arch::Network<T> &network, std::string file) { 
 				porting::simulationFromJSON(file, &network, simulation);
 			})
 		.def("saveResult", [](sim::Simulation<T> &simulation, std::string file) {
 				porting::resultToJSON(file, &simulation);
-			});
+			})
+		.def("streamResult", [](sim::Simulation<T> &simulation, std::string file) {
+				simulation.setResultSink(std::make_unique<porting::JsonResultSink<T>>(file, &simulation));
+			}, "file"_a, "Stream the states into a JSON file while simulating, instead of keeping them in memory.")
+		.def("streamBinaryResult", [](sim::Simulation<T> &simulation, std::string file, size_t chunkStates) {
+				simulation.setResultSink(std::make_unique<porting::BinaryResultSink<T>>(file, &simulation, chunkStates));
+			}, "file"_a, "chunkStates"_a=1024, "Stream the states into a binary result file while simulating, instead of keeping them in memory.");
+
+	m.def("binaryResultToJSON", [](std::string binaryFile, std::string jsonFile) {
+			porting::binaryResultToJSON<T>(binaryFile, jsonFile);
+		}, "binaryFile"_a, "jsonFile"_a, "Convert a binary result file into a JSON result file.");
 
 	#ifdef VERSION_INFO
 	m.attr("__version__") = MACRO_STRINGIFY(VERSION_INFO);
@@ -4,6 +4,16 @@
 
 #pragma once
 
+#include <cstddef>
+
+namespace sim {
+
+// Forward declared dependencies
+template<typename T>
+class BoundaryStore;
+
+}
+
 namespace arch {
 
 // Forward declared dependencies
@@ -12,12 +22,16 @@ class RectangularChannel;
 
 /**
  * @brief Class to specify the boundary position of one end of a droplet.
+ * The position of a boundary inside a simulation is a view of its slot in the boundary store of the simulation, which owns the channel and the position.
+ * Other channel positions (e.g., of injections or of saved states) own their channel and position, this also holds for copies of a view.
  */
 template<typename T>
 class ChannelPosition {
   private:
-    RectangularChannel<T>* channel;  ///< Channel in which one end of droplet currently is.
-    T position;   ///< Exact relative position (between 0.0 and 1.0) within the channel.
+    RectangularChannel<T>* channel = nullptr;   ///< Channel in which one end of droplet currently is (only used if the position is not kept in a store).
+    T position = 0.0;                           ///< Exact relative position (between 0.0 and 1.0) within the channel (only used if the position is not kept in a store).
+    sim::BoundaryStore<T>* store = nullptr;     ///< Store that owns the channel and the position (nullptr if this channel position owns them).
+    size_t slot = 0;                            ///< Slot of the boundary in the store.
 
   public:
     /**
@@ -27,6 +41,26 @@ class ChannelPosition {
      */
     ChannelPosition(RectangularChannel<T>* channel, T position);
 
+    /**
+     * @brief Constructor to create a view of the position of a boundary in a boundary store.
+     * @param[in] store Store that owns the channel and the position.
+     * @param[in] slot Slot of the boundary in the store.
+     */
+    ChannelPosition(sim::BoundaryStore<T>* store, size_t slot);
+
+    /**
+     * @brief Copy the channel and the position, the copy owns them.
+     * @param[in] other Channel position to copy.
+     */
+    ChannelPosition(const ChannelPosition& other);
+
+    /**
+     * @brief Set the channel and the position to the ones of another channel position (a view writes them into its slot of the store).
+     * @param[in] other Channel position to copy.
+     * @return This channel position.
+     */
+    ChannelPosition& operator=(const ChannelPosition& other);
+
     /**
      * @brief Change the channel of the channel position (at which one end of the droplet currently is).
      * @param[in] channel New channel to which the position should be set.
@@ -5,18 +5,40 @@ namespace arch {
 template<typename T>
 ChannelPosition<T>::ChannelPosition(RectangularChannel<T>* channel, T position) : channel(channel), position(position) {}
 
+template<typename T>
+ChannelPosition<T>::ChannelPosition(sim::BoundaryStore<T>* store, size_t slot) : store(store), slot(slot) {}
+
+template<typename T>
+ChannelPosition<T>::ChannelPosition(const ChannelPosition& other) : channel(other.getChannel()), position(other.getPosition()) {}
+
+template<typename T>
+ChannelPosition<T>& ChannelPosition<T>::operator=(const ChannelPosition& other) {
+    if (this != &other) {
+        setChannel(other.getChannel());
+        setPosition(other.getPosition());
+    }
+    return *this;
+}
+
 template<typename T>
 void ChannelPosition<T>::setChannel(RectangularChannel<T>* const channel) {
-    this->channel = channel;
+    if (store != nullptr) {
+        store->setChannel(slot, channel);
+    } else {
+        this->channel = channel;
+    }
 }
 
 template<typename T>
 void ChannelPosition<T>::setPosition(T position) {
     // ensure that position stays in range (e.g., due to rounding errors)
     if (position < 0.0) {
-        this->position = 0.0;
+        position = 0.0;
     } else if (position > 1.0) {
-        this->position = 1.0;
+        position = 1.0;
+    }
+    if (store != nullptr) {
+        store->setPosition(slot, position);
     } else {
         this->position = position;
     }
@@ -24,33 +46,33 @@ void ChannelPosition<T>::setPosition(T position) {
 
 template<typename T>
 void ChannelPosition<T>::addToPosition(T volumeShift) {
-    T newPosition = position + volumeShift / channel->getVolume();
+    T newPosition = getPosition() + volumeShift / getChannel()->getVolume();
     setPosition(newPosition);
 }
 
 template<typename T>
 RectangularChannel<T>* ChannelPosition<T>::getChannel() const {
-    return channel;
+    return (store != nullptr) ? store->getChannel(slot) : channel;
 }
 
 template<typename T>
 T ChannelPosition<T>::getPosition() const {
-    return position;
+    return (store != nullptr) ? store->getPosition(slot) : position;
 }
 
 template<typename T>
 T ChannelPosition<T>::getAbsolutePosition() const {
-    return position * channel->getLength();
+    return getPosition() * getChannel()->getLength();
 }
 
 template<typename T>
 T ChannelPosition<T>::getVolumeA() const {
-    return position * channel->getVolume();
+    return getPosition() * getChannel()->getVolume();
 }
 
 template<typename T>
 T ChannelPosition<T>::getVolumeB() const {
-    return (1.0 - position) * channel->getVolume();
+    return (1.0 - getPosition()) * getChannel()->getVolume();
 }
 
 }  // namespace arch
\ No newline at end of file
@@ -4,12 +4,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 #include <queue>
 #include <set>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 
 #include "nlohmann/json.hpp"
 
@@ -74,6 +76,35 @@ struct Group {
     }
 };
 
+/**
+ * @brief Struct that maps the nodes, channels and pumps of the network onto the rows of the modified nodal analysis.
+ * Node rows are compact (0, ..., nNodeRows-1) in ascending order of the node ids, ground nodes do not get a row.
+ * The channels and pumps are stored in flat arrays, together with the rows of their nodes.
+ * The dense solver keeps the rows of the original layout, in which the row of a node is its position in the ascending order
+ * of all node ids, and ground nodes before the last node row leave an empty row.
+ */
+template<typename T>
+struct NodalIndexMap {
+    int version = 0;                                    ///< Incremented with every rebuild of the map.
+    int nNodeRows = 0;                                  ///< Number of node rows, i.e., of nodes that are not ground nodes.
+    std::unordered_map<int, int> nodeRows;              ///< Matrix row of each node <nodeId, row>, -1 for ground nodes.
+    std::vector<Node<T>*> rowNodes;                     ///< Node of each node row.
+    int nDenseRows = 0;                                 ///< Number of node rows of the dense system, including the empty rows.
+    std::vector<int> denseRows;                         ///< Row of each node row in the dense system.
+    std::vector<RectangularChannel<T>*> channels;       ///< Channels of the network.
+    std::unordered_map<int, int> channelIndices;        ///< Position of each channel in the flat arrays <channelId, index>.
+    std::vector<Node<T>*> channelNodesA;                ///< Node A of each channel.
+    std::vector<Node<T>*> channelNodesB;                ///< Node B of each channel.
+    std::vector<int> channelRowsA;                      ///< Row of node A of each channel, -1 for ground.
+    std::vector<int> channelRowsB;                      ///< Row of node B of each channel, -1 for ground.
+    std::vector<PressurePump<T>*> pressurePumps;        ///< Pressure pumps of the network.
+    std::vector<int> pressurePumpRowsA;                 ///< Row of node A of each pressure pump, -1 for ground.
+    std::vector<int> pressurePumpRowsB;                 ///< Row of node B of each pressure pump, -1 for ground.
+    std::vector<FlowRatePump<T>*> flowRatePumps;        ///< Flow rate pumps of the network.
+    std::vector<int> flowRatePumpRowsA;                 ///< Row of node A of each flow rate pump, -1 for ground.
+    std::vector<int> flowRatePumpRowsB;                 ///< Row of node B of each flow rate pump, -1 for ground.
+};
+
 /**
  * @brief Class to specify a Network of Nodes, Channels, and Models for a Platform on a Chip.
 */
@@ -90,6 +121,8 @@ private:
     std::unordered_map<int, std::unique_ptr<Group<T>>> groups;                  ///< Map of ids and pointers to groups that form the (unconnected) 1D parts of the network
     std::unordered_map<int, std::unordered_map<int, RectangularChannel<T>*>> reach; ///< Set of nodes and corresponding channels (reach) at these nodes in the network.
     std::unordered_map<int, lbmModule<T>*> modularReach;                        ///< Set of nodes with corresponding module (or none) at these nodes in the network.
+    NodalIndexMap<T> indexMap;                                                  ///< Rows of the nodes and pumps in the system of the nodal analysis.
+    bool indexMapValid = false;                                                 ///< If the index map corresponds to the current topology of the network.
 
     /**
      * @brief Goes through network and sets all nodes and channels that are visited to true.
@@ -350,10 +383,28 @@ public:
     void toJson(std::string jsonString) const;
 
     /**
-     * @brief Sorts the nodes and channels into detached 1D domain groups
+     * @brief Sorts the nodes and channels into detached 1D domain groups and builds the index map of the nodal analysis.
     */
     void sortGroups();
 
+    /**
+     * @brief Builds the map of nodes, channels and pumps onto the rows of the nodal analysis.
+    */
+    void updateIndexMap();
+
+    /**
+     * @brief Checks if the index map corresponds to the current topology of the network.
+     * Adding nodes, channels, pumps or modules and changing ground nodes invalidates the index map.
+     * @return If the index map is valid.
+    */
+    bool isIndexMapValid() const;
+
+    /**
+     * @brief Get the map of nodes, channels and pumps onto the rows of the nodal analysis.
+     * @returns Index map.
+    */
+    const NodalIndexMap<T>& getIndexMap() const;
+
     /**
      * @brief Checks if chip network is valid.
      * @return If the network is valid.
@@ -194,6 +194,8 @@ Node<T>* Network<T>::addNode(T x_, T y_, bool ground_) {
         groundNodes.emplace(result.first->second.get());
     }
 
+    indexMapValid = false;
+
     // return raw pointer to the node
     return result.first->second.get();
 }
@@ -215,6 +217,8 @@ RectangularChannel<T>* Network<T>::addChannel(int nodeAId, int nodeBId, T height
     // add channel
     channels.try_emplace(id, addChannel);
 
+    indexMapValid = false;
+
     return addChannel;
 }
 
@@ -236,6 +240,8 @@ RectangularChannel<T>* Network<T>::addChannel(int nodeAId, int nodeBId, T height
     // add channel
     channels.try_emplace(id, addChannel);
 
+    indexMapValid = false;
+
     return addChannel;
 }
 
@@ -257,6 +263,8 @@ RectangularChannel<T>* Network<T>::addChannel(int nodeAId, int nodeBId, T resist
     // add channel
     channels.try_emplace(id, addChannel);
 
+    indexMapValid = false;
+
     return addChannel;
 }
 
@@ -269,6 +277,8 @@ FlowRatePump<T>* Network<T>::addFlowRatePump(int nodeAId, int nodeBId, T flowRat
     // add pump
     flowRatePumps.try_emplace(id, addPump);
 
+    indexMapValid = false;
+
     return addPump;
 }
 
@@ -281,6 +291,8 @@ PressurePump<T>* Network<T>::addPressurePump(int nodeAId, int nodeBId, T pressur
     // add pump
     pressurePumps.try_emplace(id, addPump);
 
+    indexMapValid = false;
+
     return addPump;
 }
 
@@ -305,6 +317,8 @@ lbmModule<T>* Network<T>::addModule(std::string name,
     // add module
     modules.try_emplace(id, addModule);
 
+    indexMapValid = false;
+
     return addModule;
 }
 
@@ -323,6 +337,7 @@ template<typename T>
 void Network<T>::setGround(int nodeId_) {
     nodes.at(nodeId_)->setGround(true);
     groundNodes.emplace(nodes.at(nodeId_).get());
+    indexMapValid = false;
 }
 
 template<typename T>
@@ -334,6 +349,7 @@ void Network<T>::setPressurePump(int channelId_, T pressure_) {
     channels.erase(channelId_);
     reach.at(nodeAId).erase(channelId_);
     reach.at(nodeBId).erase(channelId_);
+    indexMapValid = false;
 }
 
 template<typename T>
@@ -345,11 +361,13 @@ void Network<T>::setFlowRatePump(int channelId_, T flowRate_) {
     channels.erase(channelId_);
     reach.at(nodeAId).erase(channelId_);
     reach.at(nodeBId).erase(channelId_);
+    indexMapValid = false;
 }
 
 template<typename T>
 void Network<T>::setModules(std::unordered_map<int, std::unique_ptr<lbmModule<T>>> modules_) {
     this->modules = std::move(modules_);
+    indexMapValid = false;
 }
 
 template<typename T>
@@ -517,6 +535,71 @@ void Network<T>::sortGroups() {
         
         groupId++;
     }
+
+    updateIndexMap();
+}
+
+template<typename T>
+void Network<T>::updateIndexMap() {
+    NodalIndexMap<T> newMap;
+    newMap.version = indexMap.version + 1;
+
+    // Compact rows for all nodes that are not ground nodes, in ascending order of the node ids
+    std::vector<int> nodeIds;
+    nodeIds.reserve(nodes.size());
+    for (auto& [key, node] : nodes) {
+        nodeIds.push_back(key);
+    }
+    std::sort(nodeIds.begin(), nodeIds.end());
+    newMap.nodeRows.reserve(nodeIds.size());
+    for (size_t rank = 0; rank < nodeIds.size(); ++rank) {
+        auto* node = nodes.at(nodeIds[rank]).get();
+        if (node->getGround()) {
+            newMap.nodeRows.try_emplace(nodeIds[rank], -1);
+        } else {
+            newMap.nodeRows.try_emplace(nodeIds[rank], newMap.nNodeRows);
+            newMap.rowNodes.push_back(node);
+            newMap.denseRows.push_back(rank);
+            newMap.nDenseRows = rank + 1;
+            newMap.nNodeRows++;
+        }
+    }
+
+    // Flat arrays of the channels and the rows of their nodes
+    newMap.channels.reserve(channels.size());
+    for (auto& [key, channel] : channels) {
+        newMap.channelIndices.try_emplace(key, newMap.channels.size());
+        newMap.channels.push_back(channel.get());
+        newMap.channelNodesA.push_back(nodes.at(channel->getNodeA()).get());
+        newMap.channelNodesB.push_back(nodes.at(channel->getNodeB()).get());
+        newMap.channelRowsA.push_back(newMap.nodeRows.at(channel->getNodeA()));
+        newMap.channelRowsB.push_back(newMap.nodeRows.at(channel->getNodeB()));
+    }
+
+    // Flat arrays of the pumps and the rows of their nodes
+    for (auto& [key, pump] : pressurePumps) {
+        newMap.pressurePumps.push_back(pump.get());
+        newMap.pressurePumpRowsA.push_back(newMap.nodeRows.at(pump->getNodeA()));
+        newMap.pressurePumpRowsB.push_back(newMap.nodeRows.at(pump->getNodeB()));
+    }
+    for (auto& [key, pump] : flowRatePumps) {
+        newMap.flowRatePumps.push_back(pump.get());
+        newMap.flowRatePumpRowsA.push_back(newMap.nodeRows.at(pump->getNodeA()));
+        newMap.flowRatePumpRowsB.push_back(newMap.nodeRows.at(pump->getNodeB()));
+    }
+
+    indexMap = std::move(newMap);
+    indexMapValid = true;
+}
+
+template<typename T>
+bool Network<T>::isIndexMapValid() const {
+    return indexMapValid;
+}
+
+template<typename T>
+const NodalIndexMap<T>& Network<T>::getIndexMap() const {
+    return indexMap;
 }
 
 template<typename T>
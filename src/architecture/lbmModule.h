@@ -8,7 +8,9 @@
 
 #include <vector>
 #include <unordered_map>
+#include <utility>
 #include <memory>
+#include <mutex>
 #include <math.h>
 #include <iostream>
 
@@ -27,6 +29,15 @@ class Network;
 template<typename T>
 class Node;
 
+/**
+ * @brief Enum to specify when the results of an lbm module are written to vtk files.
+*/
+enum class VtkOutput {
+    Disabled,   ///< No vtk files are written.
+    Interval,   ///< The geometry and the results are written every vtkInterval iterations.
+    Final       ///< The geometry and the results are written once, when the simulation has converged.
+};
+
 /**
  * @brief Struct that defines an opening, which is an in-/outlet of the CFD domain.
 */
@@ -56,6 +67,46 @@ struct Opening {
         }
 };
 
+/**
+ * @brief Analytical functor of a boundary value, i.e., a profile of unit magnitude (e.g., a Poiseuille profile with a maximal
+ * velocity of 1) that is scaled by the coupled value. The value of an opening is changed in place, hence the functor is only
+ * created once per opening.
+*/
+template<typename T>
+class BoundaryValue2D : public olb::AnalyticalF2D<T,T> {
+private:
+    std::shared_ptr<olb::AnalyticalF2D<T,T>> profile;   ///< Profile of unit magnitude.
+    T value;                                            ///< Magnitude of the boundary value.
+
+public:
+    /**
+     * @brief Constructor of a boundary value.
+     * @param[in] profile The profile of unit magnitude.
+     * @param[in] value The magnitude of the boundary value.
+    */
+    BoundaryValue2D(std::shared_ptr<olb::AnalyticalF2D<T,T>> profile, T value=0.0);
+
+    /**
+     * @brief Set the magnitude of the boundary value.
+     * @param[in] value The magnitude.
+    */
+    void setValue(T value);
+
+    /**
+     * @brief Get the magnitude of the boundary value.
+     * @returns The magnitude.
+    */
+    T getValue() const;
+
+    /**
+     * @brief Evaluate the scaled profile at a position.
+     * @param[out] output The boundary value at the position.
+     * @param[in] input The position.
+     * @returns If the evaluation succeeded.
+    */
+    bool operator()(T output[], const T input[]) override;
+};
+
 /**
  * @brief Class that defines the lbm module which is the interface between the 1D solver and OLB.
 */
@@ -68,13 +119,22 @@ using BGKdynamics = olb::BGKdynamics<T,DESCRIPTOR>;
 using BounceBack = olb::BounceBack<T,DESCRIPTOR>;
 
 private:
+    inline static std::mutex outputMutex;   ///< Serializes the vtk and convergence output of modules that are solved concurrently.
     int step = 0;                           ///< Iteration step of this module.
     int stepIter = 1000;                    ///< Number of iterations for the value tracer.
     int maxIter = 1e7;                      ///< Maximum total iterations.
     int theta = 10;                         ///< Number of OLB iterations per communication iteration.
+    bool adaptiveTheta = false;             ///< Is theta adapted to the change of the boundary values between communication iterations?
+    int minTheta = 1;                       ///< Lower bound of the adaptive theta.
+    int maxTheta = 1000;                    ///< Upper bound of the adaptive theta.
+    T thetaTolerance = 1e-3;                ///< Relative change of the boundary values below which the adaptive theta is increased.
     std::unordered_map<int, T> pressures;   ///< Vector of pressure values at module nodes.
     std::unordered_map<int, T> flowRates;   ///< Vector of flowRate values at module nodes.
     std::string vtkFolder = "./tmp/";
+    VtkOutput vtkOutput = VtkOutput::Interval;  ///< When the results are written to vtk files.
+    int vtkInterval = 1000;                 ///< Number of iterations between two vtk outputs.
+    int traceInterval = 1;                  ///< Number of iterations between two values of the convergence tracer.
+    bool geometryWritten = false;           ///< Was the geometry written to the vtk files?
     std::string name;                       ///< Name of the module.
     std::string stlFile;                    ///< The STL file of the CFD domain.
     bool initialized = false;               ///< Is the module initialized?
@@ -99,8 +159,16 @@ private:
     std::shared_ptr<olb::SuperLattice<T, DESCRIPTOR>> lattice;      ///< The LBM lattice on the geometry.
     std::unique_ptr<olb::util::ValueTracer<T>> converge;            ///< Value tracer to track convergence.
 
-    std::unordered_map<int, std::shared_ptr<olb::Poiseuille2D<T>>> flowProfiles;
-    std::unordered_map<int, std::shared_ptr<olb::AnalyticalConst2D<T,T>>> densities;
+    std::unordered_map<int, T> lastPressures;           ///< Pressure values at module nodes at the last communication iteration.
+    std::unordered_map<int, T> lastFlowRates;           ///< Flow rate values at module nodes at the last communication iteration.
+    std::unordered_map<int, T> lastPressureChanges;     ///< Change of the pressure values at module nodes at the last communication iteration.
+    std::unordered_map<int, T> lastFlowRateChanges;     ///< Change of the flow rate values at module nodes at the last communication iteration.
+
+    std::unordered_map<int, std::pair<bool, T>> appliedBoundaryValues;  ///< Type (true for a velocity, false for a density) and lattice value that was last applied at each opening.
+    int nBoundaryUpdates = 0;                           ///< Number of boundary values that were (re-)applied to the lattice.
+
+    std::unordered_map<int, std::shared_ptr<BoundaryValue2D<T>>> flowProfiles;     ///< Velocity profiles at the openings that communicate the pressure.
+    std::unordered_map<int, std::shared_ptr<BoundaryValue2D<T>>> densities;        ///< Densities at the openings that communicate the flow rate.
     std::shared_ptr<const olb::UnitConverterFromResolutionAndRelaxationTime<T, DESCRIPTOR>> converter;      ///< Object that stores conversion factors from phyical to lattice parameters.
     std::unordered_map<int, std::shared_ptr<olb::SuperPlaneIntegralFluxVelocity2D<T>>> fluxes;              ///< Map of fluxes at module nodes. 
     std::unordered_map<int, std::shared_ptr<olb::SuperPlaneIntegralFluxPressure2D<T>>> meanPressures;       ///< Map of mean pressure values at module nodes.
@@ -117,6 +185,15 @@ private:
         return *lattice;
     }
 
+    /**
+     * @brief Record the lattice value that is applied at an opening, if it or the type of the boundary condition changed since it was last applied.
+     * @param[in] key Id of the node of the opening.
+     * @param[in] velocity If a velocity (true) or a density (false) is applied at the opening.
+     * @param[in] value Lattice velocity or density at the opening.
+     * @return If the value or its type changed and it has to be applied to the lattice.
+    */
+    bool updateBoundaryValue(int key, bool velocity, T value);
+
 public:
     /**
      * @brief Constructor of an lbm module.
@@ -155,13 +232,14 @@ public:
     void prepareLattice();
 
     /**
-     * @brief Set the boundary values on the lattice at the module nodes.
+     * @brief Set the boundary values on the lattice at the module nodes. Openings whose value did not change since it
+     * was last applied are skipped.
      * @param[in] iT Iteration step.
     */
     void setBoundaryValues(int iT);
 
     /**
-     * @brief Conducts the collide and stream operations of the lattice.
+     * @brief Conducts theta collide and stream operations of the lattice.
     */
     void solve();
 
@@ -172,11 +250,17 @@ public:
     void getResults(int iT);
 
     /**
-     * @brief Write the vtk file with results of the CFD simulation to file system.
+     * @brief Write the vtk file with results of the CFD simulation to file system. The geometry is written with the first output.
      * @param[in] iT Iteration step.
     */
     void writeVTK(int iT);
 
+    /**
+     * @brief Pass the average energy of the lattice to the convergence tracer every traceInterval iterations and update the convergence status.
+     * @param[in] iT Iteration step.
+    */
+    void traceConvergence(int iT);
+
     /**
      * @brief Set the pressures at the nodes on the module boundary.
      * @param[in] pressure Map of pressures and node ids.
@@ -189,6 +273,14 @@ public:
      */
     void setFlowRates(std::unordered_map<int, T> flowRate);
 
+    /**
+     * @brief Adapt theta to the change of the boundary values since the last communication iteration. Called once per coupling exchange,
+     * after the new pressures and flow rates were set, so that repeated solves with the same boundary values do not change theta.
+     * Theta is doubled while the relative change of the pressures and flow rates stays below thetaTolerance and halved
+     * when a significant change reverses its sign, i.e., when the boundary values oscillate.
+    */
+    void adaptTheta();
+
     /**
      * @brief Set the nodes of the module that communicate the pressure to the 1D solver.
      * @param[in] groundNodes Map of nodes.
@@ -235,6 +327,54 @@ public:
         return stepIter;
     };
 
+    /**
+     * @brief Set the number of OLB iterations per communication iteration.
+     * @param[in] theta Number of OLB iterations.
+    */
+    void setTheta(int theta);
+
+    /**
+     * @brief Get the number of OLB iterations per communication iteration.
+     * @returns Number of OLB iterations.
+    */
+    int getTheta() const {
+        return theta;
+    };
+
+    /**
+     * @brief Define whether theta is adapted to the change of the boundary values between communication iterations.
+     * @param[in] adaptive If theta is adapted.
+     * @param[in] minTheta Lower bound of theta.
+     * @param[in] maxTheta Upper bound of theta.
+     * @param[in] tolerance Relative change of the boundary values below which theta is increased.
+    */
+    void setAdaptiveTheta(bool adaptive, int minTheta=1, int maxTheta=1000, T tolerance=1e-3);
+
+    /**
+     * @brief Returns whether theta is adapted to the change of the boundary values.
+     * @returns Boolean for adaptive theta.
+    */
+    bool getAdaptiveTheta() const {
+        return adaptiveTheta;
+    };
+
+    /**
+     * @brief Get the number of boundary values that were (re-)applied to the lattice.
+     * @returns Number of boundary updates.
+    */
+    int getBoundaryUpdates() const {
+        return nBoundaryUpdates;
+    };
+
+    /**
+     * @brief Get the boundary value that is applied at an opening, i.e., a velocity profile or a density.
+     * @param[in] key Id of the node of the opening.
+     * @returns The boundary value.
+    */
+    const BoundaryValue2D<T>* getBoundaryValue(int key) const {
+        return groundNodes.at(key) ? flowProfiles.at(key).get() : densities.at(key).get();
+    };
+
     /**
      * @brief Returns whether the module is initialized or not.
      * @returns Boolean for initialization.
@@ -260,6 +400,35 @@ public:
 
     void setVtkFolder(std::string vtkFolder);
 
+    /**
+     * @brief Define when the results of this module are written to vtk files.
+     * @param[in] vtkOutput Output policy.
+     * @param[in] vtkInterval Number of iterations between two outputs, for VtkOutput::Interval.
+    */
+    void setVtkOutput(VtkOutput vtkOutput, int vtkInterval=1000);
+
+    /**
+     * @brief Get when the results of this module are written to vtk files.
+     * @returns Output policy.
+    */
+    VtkOutput getVtkOutput() const {
+        return vtkOutput;
+    };
+
+    /**
+     * @brief Set the number of iterations between two values of the convergence tracer.
+     * @param[in] traceInterval Number of iterations.
+    */
+    void setTraceInterval(int traceInterval);
+
+    /**
+     * @brief Get the iteration step of this module.
+     * @returns Iteration step.
+    */
+    int getStep() const {
+        return step;
+    };
+
     /**
      * @brief Get the fully connected graph of this module, that is used for the initial approximation.
      * @return Network of the fully connected graph.
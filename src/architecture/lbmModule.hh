@@ -1,10 +1,36 @@
 #include "lbmModule.h"
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <stdexcept>
 
 namespace arch{
 
 #define VERBOSE
 
+template<typename T>
+BoundaryValue2D<T>::BoundaryValue2D(std::shared_ptr<olb::AnalyticalF2D<T,T>> profile_, T value_) :
+    olb::AnalyticalF2D<T,T>(profile_->getTargetDim()), profile(profile_), value(value_) { }
+
+template<typename T>
+void BoundaryValue2D<T>::setValue(T value_) {
+    this->value = value_;
+}
+
+template<typename T>
+T BoundaryValue2D<T>::getValue() const {
+    return value;
+}
+
+template<typename T>
+bool BoundaryValue2D<T>::operator()(T output[], const T input[]) {
+    bool result = profile->operator()(output, input);
+    for (int i = 0; i < this->getTargetDim(); ++i) {
+        output[i] *= value;
+    }
+    return result;
+}
+
 template<typename T>
 lbmModule<T>::lbmModule (
     int id_, std::string name_, std::string stlFile_, std::vector<T> pos_, std::vector<T> size_, std::unordered_map<int, std::shared_ptr<Node<T>>> nodes_, 
@@ -129,13 +155,16 @@ void lbmModule<T>::prepareLattice () {
             meanPressure = std::make_shared< olb::SuperPlaneIntegralFluxPressure2D<T>> (getLattice(), getConverter(), getGeometry(),
             position, Opening.tangent, materials);
             this->meanPressures.try_emplace(key, meanPressure);
-            flowProfiles.try_emplace(key, std::make_shared<olb::Poiseuille2D<T>>(getGeometry(), 0, (T) 0.0, (T) 0.0));
+            T distance2Wall = getConverter().getConversionFactorLength()/2.;
+            flowProfiles.insert_or_assign(key, std::make_shared<BoundaryValue2D<T>>(
+                std::make_shared<olb::Poiseuille2D<T>>(getGeometry(), key+3, (T) 1.0, distance2Wall)));
         } else {
             std::shared_ptr<olb::SuperPlaneIntegralFluxVelocity2D<T>> flux;
             flux = std::make_shared< olb::SuperPlaneIntegralFluxVelocity2D<T> > (getLattice(), getConverter(), getGeometry(),
             position, Opening.tangent, materials);
             this->fluxes.try_emplace(key, flux);
-            densities.try_emplace(key, std::make_shared<olb::AnalyticalConst2D<T,T>>((T) 0.0));
+            densities.insert_or_assign(key, std::make_shared<BoundaryValue2D<T>>(
+                std::make_shared<olb::AnalyticalConst2D<T,T>>((T) 1.0)));
         }
     }
 
@@ -143,34 +172,43 @@ void lbmModule<T>::prepareLattice () {
     lattice->template setParameter<olb::descriptors::OMEGA>(omega);
     lattice->initialize();
 
+    // The boundary values have to be applied to the new lattice
+    appliedBoundaryValues.clear();
+
     #ifdef VERBOSE
         std::cout << "[lbmModule] prepare lattice " << name << "... OK" << std::endl;
     #endif
 }
 
 template<typename T>
-void lbmModule<T>::setBoundaryValues (int iT) {
-
-    T pressureLow = -1.0;       
-    for (auto& [key, pressure] : pressures) {
-        if ( pressureLow < 0.0 ) {
-            pressureLow = pressure;
-        }
-        if ( pressure < pressureLow ) {
-            pressureLow = pressure;
-        }
+bool lbmModule<T>::updateBoundaryValue(int key, bool velocity, T value) {
+    auto applied = appliedBoundaryValues.find(key);
+    if (applied != appliedBoundaryValues.end() && applied->second.first == velocity && applied->second.second == value) {
+        return false;
     }
+    appliedBoundaryValues[key] = { velocity, value };
+    nBoundaryUpdates++;
+    return true;
+}
+
+template<typename T>
+void lbmModule<T>::setBoundaryValues (int iT) {
 
+    // Only openings whose coupled value changed since it was last applied are redefined on the lattice
     for (auto& [key, Opening] : moduleOpenings) {
         if (groundNodes.at(key)) {
             T maxVelocity = (3./2.)*(flowRates[key]/(Opening.width));
-            T distance2Wall = getConverter().getConversionFactorLength()/2.;
-            this->flowProfiles.at(key) = std::make_shared<olb::Poiseuille2D<T>>(getGeometry(), key+3, getConverter().getLatticeVelocity(maxVelocity), distance2Wall);
-            getLattice().defineU(getGeometry(), key+3, *this->flowProfiles.at(key));
+            T latticeVelocity = getConverter().getLatticeVelocity(maxVelocity);
+            if (updateBoundaryValue(key, true, latticeVelocity)) {
+                this->flowProfiles.at(key)->setValue(latticeVelocity);
+                getLattice().defineU(getGeometry(), key+3, *this->flowProfiles.at(key));
+            }
         } else {
             T rhoV = getConverter().getLatticeDensityFromPhysPressure((pressures[key]));
-            this->densities.at(key) = std::make_shared<olb::AnalyticalConst2D<T,T>>(rhoV);
-            getLattice().defineRho(getGeometry(), key+3, *this->densities.at(key));
+            if (updateBoundaryValue(key, false, rhoV)) {
+                this->densities.at(key)->setValue(rhoV);
+                getLattice().defineRho(getGeometry(), key+3, *this->densities.at(key));
+            }
         }
     }
 
@@ -188,6 +226,7 @@ void lbmModule<T>::getResults (int iT) {
             pressures.at(key) = newPressure;
             if (iT % 1000 == 0) {
                 #ifdef VERBOSE
+                    std::lock_guard<std::mutex> lock(outputMutex);
                     meanPressures.at(key)->print();
                 #endif
             }
@@ -196,6 +235,7 @@ void lbmModule<T>::getResults (int iT) {
             flowRates.at(key) = output[0];
             if (iT % 1000 == 0) {
                 #ifdef VERBOSE
+                    std::lock_guard<std::mutex> lock(outputMutex);
                     fluxes.at(key)->print();
                 #endif
             }
@@ -208,11 +248,13 @@ void lbmModule<T>::lbmInit (T dynViscosity,
                             T density) {
     // Create network with fully connected graph and set initial resistances
 
-    if (!std::filesystem::is_directory(vtkFolder) || !std::filesystem::exists(vtkFolder)) {
-        std::filesystem::create_directory(vtkFolder);
-    }
+    if (vtkOutput != VtkOutput::Disabled) {
+        if (!std::filesystem::is_directory(vtkFolder) || !std::filesystem::exists(vtkFolder)) {
+            std::filesystem::create_directory(vtkFolder);
+        }
 
-    olb::singleton::directories().setOutputDir( this->vtkFolder+"/" );  // set output directory     
+        olb::singleton::directories().setOutputDir( this->vtkFolder+"/" );  // set output directory
+    }
 
     T kinViscosity = dynViscosity/density;
 
@@ -253,39 +295,43 @@ void lbmModule<T>::lbmInit (T dynViscosity,
 template<typename T>
 void lbmModule<T>::writeVTK (int iT) {
 
-    bool print = false;
-    #ifdef VERBOSE
-        print = true;
-    #endif
-
     olb::SuperVTMwriter2D<T> vtmWriter( name );
     // Writes geometry to file system
-    if (iT == 0) {
+    if (!geometryWritten) {
         olb::SuperLatticeGeometry2D<T,DESCRIPTOR> writeGeometry (getLattice(), getGeometry());
         vtmWriter.write(writeGeometry);
         vtmWriter.createMasterFile();
+        geometryWritten = true;
     }
 
-    if (iT % 1000 == 0) {
-        
-        olb::SuperLatticePhysVelocity2D<T,DESCRIPTOR> velocity(getLattice(), getConverter());
-        olb::SuperLatticePhysPressure2D<T,DESCRIPTOR> pressure(getLattice(), getConverter());
-        olb::SuperLatticeDensity2D<T,DESCRIPTOR> latDensity(getLattice());
-        vtmWriter.addFunctor(velocity);
-        vtmWriter.addFunctor(pressure);
-        vtmWriter.addFunctor(latDensity);
-        
-        // write vtk to file system
-        vtmWriter.write(iT);
-        converge->takeValue(getLattice().getStatistics().getAverageEnergy(), print);
-    }
-    if (iT %1000 == 0) {
-        #ifdef VERBOSE
-            std::cout << "[writeVTK] " << name << " currently at timestep " << iT << std::endl;
-        #endif
-    }
+    olb::SuperLatticePhysVelocity2D<T,DESCRIPTOR> velocity(getLattice(), getConverter());
+    olb::SuperLatticePhysPressure2D<T,DESCRIPTOR> pressure(getLattice(), getConverter());
+    olb::SuperLatticeDensity2D<T,DESCRIPTOR> latDensity(getLattice());
+    vtmWriter.addFunctor(velocity);
+    vtmWriter.addFunctor(pressure);
+    vtmWriter.addFunctor(latDensity);
 
-    converge->takeValue(getLattice().getStatistics().getAverageEnergy(), print);
+    // write vtk to file system
+    vtmWriter.write(iT);
+
+    #ifdef VERBOSE
+        std::cout << "[writeVTK] " << name << " currently at timestep " << iT << std::endl;
+    #endif
+}
+
+template<typename T>
+void lbmModule<T>::traceConvergence (int iT) {
+
+    bool print = false;
+    #ifdef VERBOSE
+        print = true;
+    #endif
+
+    if (iT % traceInterval == 0) {
+        T energy = getLattice().getStatistics().getAverageEnergy();
+        std::lock_guard<std::mutex> lock(outputMutex);
+        converge->takeValue(energy, print);
+    }
 
     if (iT%100 == 0) {
         if (converge->hasConverged()) {
@@ -295,12 +341,64 @@ void lbmModule<T>::writeVTK (int iT) {
 
 }
 
+template<typename T>
+void lbmModule<T>::adaptTheta() {
+    if (!adaptiveTheta) {
+        return;
+    }
+
+    bool oscillating = false;
+    bool history = true;
+
+    // Largest change of the values relative to the largest value, and detection of sign reversals of significant changes
+    auto relativeChange = [&](const std::unordered_map<int, T>& values, std::unordered_map<int, T>& lastValues, std::unordered_map<int, T>& lastChanges) {
+        T maxValue = 0.0;
+        T maxChange = 0.0;
+        for (auto& [key, value] : values) {
+            maxValue = std::max(maxValue, std::abs(value));
+        }
+        for (auto& [key, value] : values) {
+            auto last = lastValues.find(key);
+            if (last == lastValues.end()) {
+                history = false;
+                lastValues.try_emplace(key, value);
+                lastChanges.try_emplace(key, (T) 0.0);
+                continue;
+            }
+            T change = value - last->second;
+            if (change * lastChanges.at(key) < 0.0 && std::abs(change) > thetaTolerance * maxValue) {
+                oscillating = true;
+            }
+            maxChange = std::max(maxChange, std::abs(change));
+            last->second = value;
+            lastChanges.at(key) = change;
+        }
+        return (maxValue > 0.0) ? maxChange / maxValue : (T) 0.0;
+    };
+
+    T pressureChange = relativeChange(pressures, lastPressures, lastPressureChanges);
+    T flowRateChange = relativeChange(flowRates, lastFlowRates, lastFlowRateChanges);
+
+    if (!history) {
+        return;
+    }
+    if (oscillating) {
+        theta = std::max(minTheta, theta / 2);
+    } else if (pressureChange < thetaTolerance && flowRateChange < thetaTolerance) {
+        theta = std::min(maxTheta, 2 * theta);
+    }
+}
+
 template<typename T>
 void lbmModule<T>::solve() {
-    // theta = 10
-    for (int iT = 0; iT < 10; ++iT){      
+    for (int iT = 0; iT < theta; ++iT){      
         this->setBoundaryValues(step);
-        writeVTK(step);          
+        if (vtkOutput == VtkOutput::Interval && step % vtkInterval == 0) {
+            // the vtk writers of OpenLB share the output directory and the console
+            std::lock_guard<std::mutex> lock(outputMutex);
+            writeVTK(step);
+        }
+        traceConvergence(step);
         lattice->collideAndStream();
         step += 1;
     }
@@ -328,9 +426,51 @@ void lbmModule<T>::setInitialized(bool initialization_) {
     this->initialized = initialization_;
 }
 
+template<typename T>
+void lbmModule<T>::setTheta(int theta_) {
+    if (theta_ < 1) {
+        throw std::invalid_argument("The number of OLB iterations per communication iteration must be at least 1.");
+    }
+    this->theta = theta_;
+}
+
+template<typename T>
+void lbmModule<T>::setAdaptiveTheta(bool adaptive_, int minTheta_, int maxTheta_, T tolerance_) {
+    if (minTheta_ < 1 || maxTheta_ < minTheta_) {
+        throw std::invalid_argument("The bounds of the adaptive theta must satisfy 1 <= minTheta <= maxTheta.");
+    }
+    if (tolerance_ <= 0.0) {
+        throw std::invalid_argument("The tolerance of the adaptive theta must be positive.");
+    }
+    this->adaptiveTheta = adaptive_;
+    this->minTheta = minTheta_;
+    this->maxTheta = maxTheta_;
+    this->thetaTolerance = tolerance_;
+    if (adaptive_) {
+        this->theta = std::min(maxTheta, std::max(minTheta, theta));
+    }
+}
+
 template<typename T>
 void lbmModule<T>::setVtkFolder(std::string vtkFolder_) {
     this->vtkFolder = vtkFolder_;
 }
 
+template<typename T>
+void lbmModule<T>::setVtkOutput(VtkOutput vtkOutput_, int vtkInterval_) {
+    if (vtkInterval_ < 1) {
+        throw std::invalid_argument("The number of iterations between two vtk outputs must be at least 1.");
+    }
+    this->vtkOutput = vtkOutput_;
+    this->vtkInterval = vtkInterval_;
+}
+
+template<typename T>
+void lbmModule<T>::setTraceInterval(int traceInterval_) {
+    if (traceInterval_ < 1) {
+        throw std::invalid_argument("The number of iterations between two values of the convergence tracer must be at least 1.");
+    }
+    this->traceInterval = traceInterval_;
+}
+
 }   // namespace arch
\ No newline at end of file
@@ -3,17 +3,24 @@
  */
 #pragma once
 
+#include "simulation/BoundaryStore.h"
 #include "simulation/CFDSim.h"
+#include "simulation/ChannelBoundaryIndex.h"
 #include "simulation/Droplet.h"
 #include "simulation/Fluid.h"
 #include "simulation/Injection.h"
+#include "simulation/NodeOccupancyIndex.h"
+#include "simulation/ObjectPool.h"
 #include "simulation/ResistanceModels.h"
 #include "simulation/Simulation.h"
+#include "simulation/ThreadPool.h"
 #include "simulation/events/BoundaryEvent.h"
 #include "simulation/events/Event.h"
+#include "simulation/events/EventQueue.h"
 #include "simulation/events/InjectionEvent.h"
 #include "simulation/events/MergingEvent.h"
 
+#include "nodalAnalysis/CouplingAccelerator.h"
 #include "nodalAnalysis/NodalAnalysis.h"
 
 #include "architecture/Channel.h"
@@ -26,8 +33,14 @@
 #include "architecture/Node.h"
 #include "architecture/PressurePump.h"
 
+#include "porting/binaryResult.h"
+#include "porting/binaryResultSink.h"
 #include "porting/jsonPorter.h"
 #include "porting/jsonReaders.h"
+#include "porting/jsonResultSink.h"
 #include "porting/jsonWriters.h"
 
-#include "result/Results.h"
\ No newline at end of file
+#include "result/DeltaHistory.h"
+#include "result/Results.h"
+#include "result/ResultSink.h"
+#include "result/ResultStore.h"
\ No newline at end of file
@@ -1,13 +1,20 @@
+#include "simulation/BoundaryStore.hh"
 #include "simulation/CFDSim.hh"
+#include "simulation/ChannelBoundaryIndex.hh"
 #include "simulation/Droplet.hh"
 #include "simulation/Fluid.hh"
 #include "simulation/Injection.hh"
+#include "simulation/NodeOccupancyIndex.hh"
+#include "simulation/ObjectPool.hh"
 #include "simulation/ResistanceModels.hh"
 #include "simulation/Simulation.hh"
+#include "simulation/ThreadPool.hh"
 #include "simulation/events/BoundaryEvent.hh"
+#include "simulation/events/EventQueue.hh"
 #include "simulation/events/InjectionEvent.hh"
 #include "simulation/events/MergingEvent.hh"
 
+#include "nodalAnalysis/CouplingAccelerator.hh"
 #include "nodalAnalysis/NodalAnalysis.hh"
 
 #include "architecture/Channel.hh"
@@ -20,8 +27,14 @@
 #include "architecture/Node.hh"
 #include "architecture/PressurePump.hh"
 
+#include "porting/binaryResult.hh"
+#include "porting/binaryResultSink.hh"
 #include "porting/jsonPorter.hh"
 #include "porting/jsonReaders.hh"
+#include "porting/jsonResultSink.hh"
 #include "porting/jsonWriters.hh"
 
-#include "result/Results.hh"
\ No newline at end of file
+#include "result/DeltaHistory.hh"
+#include "result/Results.hh"
+#include "result/ResultSink.hh"
+#include "result/ResultStore.hh"
\ No newline at end of file
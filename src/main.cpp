@@ -24,15 +24,14 @@ int main(int argc, char const* argv []) {
     network.sortGroups();
     network.isNetworkValid();
 
+    // Stream the results into a JSON file, so that long simulations do not keep all states in memory
+    testSimulation.setResultSink(std::make_unique<porting::JsonResultSink<T>>("result.json", &testSimulation));
+
     std::cout << "[Main] Simulation..." << std::endl;
     // Perform simulation and store results
     testSimulation.simulate();
 
-    std::cout << "[Main] Results..." << std::endl;
-    // Print the results
-    testSimulation.getSimulationResults()->printStates();
-
-    porting::resultToJSON<T>("result.json", &testSimulation );
+    std::cout << "[Main] Results written to result.json." << std::endl;
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+/**
+ * @file CouplingAccelerator.h
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+#include "Eigen/Dense"
+
+namespace nodal {
+
+/**
+ * @brief Enum to specify the method that accelerates the fixed-point iteration between the 1D and CFD solvers.
+ */
+enum class AcceleratorType {
+    Constant,   ///< Constant under-relaxation with the relaxation factor of the module.
+    Aitken,     ///< Aitken's dynamic relaxation, adapts a scalar relaxation factor from the last two residuals.
+    Anderson    ///< Anderson mixing, combines the last iterates by a least-squares fit of their residuals.
+};
+
+/**
+ * @brief Virtual class that updates the interface vector of a module, i.e., the pressures and flow rates at its boundary nodes
+ * that are communicated from the 1D solver to the CFD solver. One iteration maps the values x that were set at the module to
+ * the values G(x) computed by the nodal analysis, the accelerator computes the next values from x, G(x) and its history.
+ * The first iteration (after construction or reset) is always a constant relaxation step, entries that were not set before
+ * (x <= 0) take the new value directly.
+ */
+template<typename T>
+class CouplingAccelerator {
+protected:
+    int iterations = 0;     ///< Number of updates since the last reset.
+
+    /**
+     * @brief Constant relaxation step x + w (G(x) - x), entries with x <= 0 are set to G(x).
+     * @param[in] oldValues Values x that were set at the module.
+     * @param[in] newValues Values G(x) computed by the nodal analysis.
+     * @param[in] relaxation Relaxation factor w of each entry.
+     * @return Relaxed values.
+     */
+    std::vector<T> relax(const std::vector<T>& oldValues, const std::vector<T>& newValues, const std::vector<T>& relaxation) const;
+
+public:
+    /**
+     * @brief Virtual default destructor.
+     */
+    virtual ~CouplingAccelerator() = default;
+
+    /**
+     * @brief Compute the next values of the interface vector.
+     * @param[in] oldValues Values x that were set at the module.
+     * @param[in] newValues Values G(x) computed by the nodal analysis.
+     * @param[in] relaxation Constant relaxation factor of each entry.
+     * @param[in] scales Characteristic magnitude of each entry, used to weigh pressures and flow rates against each other.
+     * @return Next values of the interface vector.
+     */
+    virtual std::vector<T> update(const std::vector<T>& oldValues, const std::vector<T>& newValues,
+                                  const std::vector<T>& relaxation, const std::vector<T>& scales) = 0;
+
+    /**
+     * @brief Drop the history, e.g., after the layout of the interface vector changed.
+     */
+    virtual void reset();
+
+    /**
+     * @brief Get the number of updates since the last reset.
+     * @return Number of coupling iterations.
+     */
+    int getIterations() const;
+};
+
+/**
+ * @brief Class that relaxes the interface vector with the constant relaxation factor of the module.
+ */
+template<typename T>
+class ConstantRelaxation : public CouplingAccelerator<T> {
+public:
+    std::vector<T> update(const std::vector<T>& oldValues, const std::vector<T>& newValues,
+                          const std::vector<T>& relaxation, const std::vector<T>& scales) override;
+};
+
+/**
+ * @brief Class that relaxes the interface vector with Aitken's dynamic relaxation factor
+ * w_k = -w_{k-1} r_{k-1}^T (r_k - r_{k-1}) / |r_k - r_{k-1}|^2, applied on top of the constant relaxation factors.
+ */
+template<typename T>
+class AitkenRelaxation : public CouplingAccelerator<T> {
+private:
+    T omega = 1.0;                  ///< Current dynamic relaxation factor, relative to the constant relaxation factors.
+    T omegaMin;                     ///< Lower bound of the dynamic relaxation factor.
+    T omegaMax;                     ///< Upper bound of the dynamic relaxation factor.
+    std::vector<T> lastResiduals;   ///< Scaled residuals of the last iteration.
+
+public:
+    /**
+     * @brief Constructor of the Aitken relaxation.
+     * @param[in] omegaMin Lower bound of the dynamic relaxation factor.
+     * @param[in] omegaMax Upper bound of the dynamic relaxation factor.
+     */
+    AitkenRelaxation(T omegaMin=0.1, T omegaMax=10.0);
+
+    std::vector<T> update(const std::vector<T>& oldValues, const std::vector<T>& newValues,
+                          const std::vector<T>& relaxation, const std::vector<T>& scales) override;
+
+    void reset() override;
+
+    /**
+     * @brief Get the current dynamic relaxation factor.
+     * @return Relaxation factor relative to the constant relaxation factors.
+     */
+    T getOmega() const;
+};
+
+/**
+ * @brief Class that mixes the last iterates of the interface vector (Anderson mixing, type II).
+ * The next values are x + B r - (dX + B dR) g, where dX and dR hold the differences of the last iterates and residuals,
+ * B the constant relaxation factors and g minimizes the scaled residual |r - dR g|.
+ */
+template<typename T>
+class AndersonMixing : public CouplingAccelerator<T> {
+private:
+    int depth;                              ///< Maximal number of differences that are kept in the history.
+    std::deque<std::vector<T>> values;      ///< Last iterates x.
+    std::deque<std::vector<T>> residuals;   ///< Last residuals G(x) - x.
+
+public:
+    /**
+     * @brief Constructor of the Anderson mixing.
+     * @param[in] depth Maximal number of differences that are kept in the history.
+     */
+    AndersonMixing(int depth=5);
+
+    std::vector<T> update(const std::vector<T>& oldValues, const std::vector<T>& newValues,
+                          const std::vector<T>& relaxation, const std::vector<T>& scales) override;
+
+    void reset() override;
+};
+
+}   // namespace nodal
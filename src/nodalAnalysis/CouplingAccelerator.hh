@@ -0,0 +1,176 @@
+#include "CouplingAccelerator.h"
+
+namespace nodal {
+
+// ### CouplingAccelerator ###
+template<typename T>
+std::vector<T> CouplingAccelerator<T>::relax(const std::vector<T>& oldValues, const std::vector<T>& newValues, const std::vector<T>& relaxation) const {
+    std::vector<T> values(oldValues.size());
+    for (size_t i = 0; i < oldValues.size(); ++i) {
+        if (oldValues[i] > 0) {
+            values[i] = oldValues[i] + relaxation[i] * (newValues[i] - oldValues[i]);
+        } else {
+            values[i] = newValues[i];
+        }
+    }
+    return values;
+}
+
+template<typename T>
+void CouplingAccelerator<T>::reset() {
+    iterations = 0;
+}
+
+template<typename T>
+int CouplingAccelerator<T>::getIterations() const {
+    return iterations;
+}
+
+// ### ConstantRelaxation ###
+template<typename T>
+std::vector<T> ConstantRelaxation<T>::update(const std::vector<T>& oldValues, const std::vector<T>& newValues,
+                                             const std::vector<T>& relaxation, const std::vector<T>& scales) {
+    this->iterations++;
+    return this->relax(oldValues, newValues, relaxation);
+}
+
+// ### AitkenRelaxation ###
+template<typename T>
+AitkenRelaxation<T>::AitkenRelaxation(T omegaMin_, T omegaMax_) : omegaMin(omegaMin_), omegaMax(omegaMax_) {
+    if (omegaMin_ <= 0.0 || omegaMax_ < omegaMin_) {
+        throw std::invalid_argument("The bounds of the Aitken relaxation factor must satisfy 0 < omegaMin <= omegaMax.");
+    }
+}
+
+template<typename T>
+std::vector<T> AitkenRelaxation<T>::update(const std::vector<T>& oldValues, const std::vector<T>& newValues,
+                                           const std::vector<T>& relaxation, const std::vector<T>& scales) {
+    const size_t n = oldValues.size();
+
+    // Residuals with the constant relaxation factors, scaled to comparable magnitudes
+    std::vector<T> residuals(n);
+    for (size_t i = 0; i < n; ++i) {
+        residuals[i] = relaxation[i] * (newValues[i] - oldValues[i]) / scales[i];
+    }
+
+    if (lastResiduals.size() != n) {
+        omega = 1.0;
+        lastResiduals = residuals;
+        this->iterations++;
+        return this->relax(oldValues, newValues, relaxation);
+    }
+
+    T numerator = 0.0;
+    T denominator = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const T change = residuals[i] - lastResiduals[i];
+        numerator += lastResiduals[i] * change;
+        denominator += change * change;
+    }
+    if (denominator > 0.0) {
+        omega = std::min(omegaMax, std::max(omegaMin, -omega * numerator / denominator));
+    }
+    lastResiduals = residuals;
+
+    std::vector<T> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = oldValues[i] + omega * relaxation[i] * (newValues[i] - oldValues[i]);
+    }
+    this->iterations++;
+    return values;
+}
+
+template<typename T>
+void AitkenRelaxation<T>::reset() {
+    CouplingAccelerator<T>::reset();
+    omega = 1.0;
+    lastResiduals.clear();
+}
+
+template<typename T>
+T AitkenRelaxation<T>::getOmega() const {
+    return omega;
+}
+
+// ### AndersonMixing ###
+template<typename T>
+AndersonMixing<T>::AndersonMixing(int depth_) : depth(depth_) {
+    if (depth_ < 1) {
+        throw std::invalid_argument("The depth of the Anderson mixing must be at least 1.");
+    }
+}
+
+template<typename T>
+std::vector<T> AndersonMixing<T>::update(const std::vector<T>& oldValues, const std::vector<T>& newValues,
+                                         const std::vector<T>& relaxation, const std::vector<T>& scales) {
+    const size_t n = oldValues.size();
+    if (!values.empty() && values.back().size() != n) {
+        reset();
+    }
+
+    std::vector<T> residual(n);
+    for (size_t i = 0; i < n; ++i) {
+        residual[i] = newValues[i] - oldValues[i];
+    }
+
+    std::vector<T> next;
+    if (values.empty()) {
+        next = this->relax(oldValues, newValues, relaxation);
+    } else {
+        // Differences of consecutive iterates and residuals, the latter scaled for the least-squares fit
+        const int m = values.size();
+        Eigen::MatrixXd dX(n, m);
+        Eigen::MatrixXd dR(n, m);
+        Eigen::VectorXd r(n);
+        for (int j = 0; j < m; ++j) {
+            const std::vector<T>& nextValues = (j + 1 < m) ? values[j + 1] : oldValues;
+            const std::vector<T>& nextResiduals = (j + 1 < m) ? residuals[j + 1] : residual;
+            for (size_t i = 0; i < n; ++i) {
+                dX(i, j) = nextValues[i] - values[j][i];
+                dR(i, j) = nextResiduals[i] - residuals[j][i];
+            }
+        }
+        Eigen::MatrixXd scaledR = dR;
+        for (size_t i = 0; i < n; ++i) {
+            scaledR.row(i) /= scales[i];
+            r(i) = residual[i] / scales[i];
+        }
+        Eigen::VectorXd gamma = scaledR.colPivHouseholderQr().solve(r);
+
+        next.resize(n);
+        bool finite = true;
+        for (size_t i = 0; i < n; ++i) {
+            T correction = 0.0;
+            for (int j = 0; j < m; ++j) {
+                correction += (dX(i, j) + relaxation[i] * dR(i, j)) * gamma(j);
+            }
+            next[i] = oldValues[i] + relaxation[i] * residual[i] - correction;
+            finite = finite && std::isfinite(next[i]);
+        }
+
+        // Fall back to the constant relaxation and restart the history if the fit broke down
+        if (!finite) {
+            values.clear();
+            residuals.clear();
+            next = this->relax(oldValues, newValues, relaxation);
+        }
+    }
+
+    values.push_back(oldValues);
+    residuals.push_back(residual);
+    if (static_cast<int>(values.size()) > depth) {
+        values.pop_front();
+        residuals.pop_front();
+    }
+    this->iterations++;
+    return next;
+}
+
+template<typename T>
+void AndersonMixing<T>::reset() {
+    CouplingAccelerator<T>::reset();
+    values.clear();
+    residuals.clear();
+}
+
+}   // namespace nodal
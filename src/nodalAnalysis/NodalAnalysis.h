@@ -4,10 +4,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 #include "Eigen/Dense"
+#include "Eigen/Sparse"
+
+#include "CouplingAccelerator.h"
 
 using Eigen::MatrixXd;
 using Eigen::VectorXd;
@@ -22,6 +29,14 @@ class Network;
 
 namespace nodal {
 
+/**
+ * @brief Enum to specify the linear solver that is used to solve the system of the modified nodal analysis.
+ */
+enum class SolverType {
+    DenseQR,    ///< Dense matrix, solved with a column-pivoting Householder QR decomposition. Scales with O(n^3) and is meant for small networks.
+    SparseLU    ///< Sparse matrix assembled from triplets, solved with a supernodal LU decomposition (COLAMD ordering). Meant for large networks.
+};
+
 /**
  * @brief Conducts the Modifed Nodal Analysis (e.g., http://qucs.sourceforge.net/tech/node14.html) and computes the pressure levels for each node.
  * Hence, the passed nodes contain the final pressure levels when the function is finished.
@@ -30,11 +45,211 @@ namespace nodal {
  * @param[in] channels List of channels.
  * @param[in,out] pressurePumps List of pressure pumps.
  * @param[in] flowRatePumps List of flowrate pumps.
+ * @param[in] solver The linear solver that is used to solve the system of the modified nodal analysis.
+ * Conducts a single nodal analysis without reusing any factorization, see NodalAnalysis for repeated solves.
  */
 template<typename T>
-bool conductNodalAnalysis( const arch::Network<T>* network);
+bool conductNodalAnalysis( arch::Network<T>* network, SolverType solver=SolverType::DenseQR);
+
+/**
+ * @brief Class that conducts the modified nodal analysis of a network and keeps the linear solver alive between calls.
+ * For the sparse solver, the sparsity pattern and the symbolic factorization (ordering and elimination tree) of the
+ * system matrix are cached. They are only recomputed if the sparsity pattern changes, e.g., after a change in the topology
+ * of the network. Otherwise, only the numerical factorization is recomputed with the new conductance values.
+ */
+template<typename T>
+class NodalAnalysis {
+private:
+    arch::Network<T>* network;                                                          ///< Network on which the nodal analysis is conducted.
+    SolverType solver;                                                                  ///< The linear solver used to solve the system.
+    Eigen::SparseMatrix<double> sparseA;                                                ///< System matrix of the last sparse solve.
+    Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> sparseLU;  ///< Sparse LU decomposition, holds the cached symbolic factorization.
+    std::vector<int> outerIndices;                                                      ///< Outer indices of the sparsity pattern the symbolic factorization was computed for.
+    std::vector<int> innerIndices;                                                      ///< Inner indices of the sparsity pattern the symbolic factorization was computed for.
+    bool patternAnalyzed = false;                                                       ///< If a symbolic factorization is available.
+    int nPatternAnalyses = 0;                                                           ///< Number of symbolic factorizations.
+    int nFactorizations = 0;                                                            ///< Number of numerical factorizations.
+
+    bool incremental = false;                                                           ///< If low-rank updates of the last factorization are used instead of refactorizing.
+    int maxUpdates = 50;                                                                ///< Number of consecutive low-rank updates after which the system is refactorized.
+    int maxUpdateRank = 16;                                                             ///< Maximal number of changed channels that is handled by a low-rank update.
+    double updateTolerance = 1e-10;                                                     ///< Maximal row-wise relative residual |Ax-z|_i/(|A||x|+|z|)_i of a low-rank update before refactorizing.
+    bool factorized = false;                                                            ///< If sparseLU holds a valid numerical factorization.
+    int nUpdates = 0;                                                                   ///< Number of low-rank updates since the last factorization.
+    int nIncrementalSolves = 0;                                                         ///< Total number of solves with a low-rank update.
+    bool classified = false;                                                            ///< If the node classification corresponds to the current groups.
+    int classifiedIndexMap = -1;                                                        ///< Version of the index map of the network for the node classification.
+    std::vector<bool> conductingRows;                                                   ///< If the node of a row is a conducting node (not a ground node of the network or of a group).
+    std::vector<int> groundNodePumps;                                                   ///< Row of the pump that sets the pressure of a group's ground node, -1 for all other nodes.
+    int nGroundNodePumps = 0;                                                           ///< Number of pumps that set the pressure of the groups' ground nodes.
+
+    int factorizedIndexMap = -1;                                                        ///< Version of the index map of the network for the factorized system.
+    std::vector<double> conductances;                                                   ///< Conductances of the channels in the current system, in the order of the index map.
+    std::vector<double> factorizedConductances;                                         ///< Conductances of the channels in the factorized system, in the order of the index map.
+    std::vector<int> reportedChannels;                                                  ///< Ids of the channels that were reported to have changed since the last solve.
+    bool changesReported = false;                                                       ///< If the changed channels were reported since the last solve.
+    bool changesTracked = false;                                                        ///< If all changed channels since the last factorization were reported, so that they are known without comparing all conductances.
+    std::vector<int> updatedChannels;                                                   ///< Channels that were reported to have changed since the last factorization, in the order of the index map.
+    std::vector<bool> channelUpdated;                                                   ///< If a channel is contained in updatedChannels, in the order of the index map.
+
+    AcceleratorType acceleratorType = AcceleratorType::Constant;                        ///< Method that accelerates the coupling with the CFD modules.
+    int andersonDepth = 5;                                                              ///< Depth of the history of the Anderson mixing.
+    std::unordered_map<int, std::unique_ptr<CouplingAccelerator<T>>> accelerators;      ///< Coupling accelerator of each module, by module id.
+
+    /**
+     * @brief Sorts the node rows into conducting nodes and ground nodes of the groups and assigns the pump rows of the latter.
+     * Computed once per change of the topology or the groups and reused by every solve.
+     */
+    void classifyNodes();
+
+    /**
+     * @brief Checks if the node of a row is a conducting node.
+     * @param[in] row Row of the node, -1 for ground nodes of the network.
+     * @return If the node is a conducting node.
+     */
+    bool isConducting(int row) const;
+
+    /**
+     * @brief Checks if the node of a row is the ground node of a group.
+     * @param[in] row Row of the node, -1 for ground nodes of the network.
+     * @return If the node is the ground node of a group.
+     */
+    bool isGroupGround(int row) const;
+
+    /**
+     * @brief Solves the system A x = z with a dense matrix A, that is built from the given triplets.
+     * @param[in] triplets Non-zero entries of matrix A. Duplicate entries are summed up.
+     * @param[in] z Right-hand side vector z.
+     * @return Solution vector x.
+     */
+    VectorXd solveDense(const std::vector<Eigen::Triplet<double>>& triplets, const VectorXd& z);
+
+    /**
+     * @brief Solves the system A x = z with a sparse matrix A, that is built from the given triplets.
+     * Rows without any entry (e.g., rows of ground nodes that are not part of the system) are pinned to zero.
+     * The symbolic factorization is reused if the sparsity pattern did not change since the last call.
+     * @param[in] triplets Non-zero entries of matrix A. Duplicate entries are summed up.
+     * @param[in] z Right-hand side vector z.
+     * @return Solution vector x.
+     */
+    VectorXd solveSparse(const std::vector<Eigen::Triplet<double>>& triplets, const VectorXd& z);
+
+    /**
+     * @brief Adds the channels that were reported since the last solve to the channels that changed since the last factorization.
+     * If the changes of a solve were not reported, the changed channels are unknown until the next factorization.
+     */
+    void trackReportedChannels();
+
+    /**
+     * @brief Solves the system with the Sherman-Morrison-Woodbury formula, using the last factorization and a rank-k correction
+     * for the k channels whose conductance changed since that factorization. If all changes since the factorization were reported,
+     * only the reported channels are compared with the factorized system, otherwise the conductances of all channels.
+     * @param[in] z Right-hand side vector z.
+     * @param[out] x Solution vector x.
+     * @return If the update was applicable and accurate. Otherwise, the system has to be refactorized.
+     */
+    bool solveIncremental(const VectorXd& z, VectorXd& x);
+
+    /**
+     * @brief Get the coupling accelerator of a module, which is created on first use.
+     * @param[in] moduleId Id of the module.
+     * @return Coupling accelerator of the module.
+     */
+    CouplingAccelerator<T>& moduleAccelerator(int moduleId);
+
+    /**
+     * @brief Checks whether the sparsity pattern of sparseA equals the pattern of the cached symbolic factorization.
+     * @return If the pattern is unchanged.
+     */
+    bool samePattern() const;
+
+public:
+    /**
+     * @brief Constructor of the nodal analysis.
+     * @param[in] network Network on which the nodal analysis is conducted.
+     * @param[in] solver The linear solver that is used to solve the system of the modified nodal analysis.
+     */
+    NodalAnalysis(arch::Network<T>* network, SolverType solver=SolverType::DenseQR);
+
+    /**
+     * @brief Conducts the modified nodal analysis and computes the pressure levels for each node and the flow rates of the pressure pumps.
+     * @return If the pressures and flow rates at the boundary nodes of the modules have converged.
+     */
+    bool conductNodalAnalysis();
+
+    /**
+     * @brief Set the linear solver. Drops the cached factorization.
+     * @param[in] solver The linear solver that is used to solve the system of the modified nodal analysis.
+     */
+    void setSolverType(SolverType solver);
+
+    /**
+     * @brief Enable or disable low-rank (Sherman-Morrison-Woodbury) updates of the last factorization. Only used with the sparse solver and for networks without modules.
+     * @param[in] incremental If low-rank updates are used.
+     * @param[in] maxUpdates Number of consecutive updates after which the system is refactorized.
+     * @param[in] maxUpdateRank Maximal number of changed channels per update, above which the system is refactorized.
+     * @param[in] updateTolerance Maximal relative residual of an update in any row, above which the system is refactorized.
+     */
+    void setIncrementalUpdates(bool incremental, int maxUpdates=50, int maxUpdateRank=16, double updateTolerance=1e-10);
+
+    /**
+     * @brief Report the channels whose resistance changed since the last nodal analysis. The low-rank update of the next solve then
+     * only compares these channels with the factorized system instead of the conductances of all channels.
+     * Channels that are not reported must not have changed. Without a report, all channels are compared until the next factorization.
+     * @param[in] channelIds Ids of the changed channels.
+     */
+    void setChangedChannels(const std::vector<int>& channelIds);
+
+    /**
+     * @brief Set the method that accelerates the fixed-point iteration with the CFD modules. Drops the history of all modules.
+     * @param[in] acceleratorType Coupling accelerator.
+     * @param[in] andersonDepth Depth of the history of the Anderson mixing.
+     */
+    void setCouplingAccelerator(AcceleratorType acceleratorType, int andersonDepth=5);
+
+    /**
+     * @brief Get the method that accelerates the fixed-point iteration with the CFD modules.
+     * @return Coupling accelerator.
+     */
+    AcceleratorType getCouplingAccelerator() const;
+
+    /**
+     * @brief Get the coupling accelerator of a module.
+     * @param[in] moduleId Id of the module.
+     * @return Pointer to the coupling accelerator or nullptr if the module was not coupled yet.
+     */
+    const CouplingAccelerator<T>* getCouplingAccelerator(int moduleId) const;
+
+    /**
+     * @brief Get if low-rank updates of the last factorization are used.
+     * @return If low-rank updates are used.
+     */
+    bool getIncrementalUpdates() const;
+
+    /**
+     * @brief Get the linear solver.
+     * @return The linear solver that is used to solve the system of the modified nodal analysis.
+     */
+    SolverType getSolverType() const;
+
+    /**
+     * @brief Get the number of symbolic factorizations (sparsity pattern analyses) that were computed.
+     * @return Number of symbolic factorizations.
+     */
+    int getPatternAnalyses() const;
+
+    /**
+     * @brief Get the number of numerical factorizations that were computed.
+     * @return Number of numerical factorizations.
+     */
+    int getFactorizations() const;
+
+    /**
+     * @brief Get the number of solves that used a low-rank update instead of a factorization.
+     * @return Number of incremental solves.
+     */
+    int getIncrementalSolves() const;
+};
 
-bool contains( const std::unordered_set<int>& set, int key);
-bool contains( const std::unordered_map<int,int>& map, int key);
 
 }   // namespace nodal
\ No newline at end of file
@@ -3,52 +3,61 @@
 namespace nodal {
 
 template<typename T>
-bool conductNodalAnalysis( const arch::Network<T>* network)
-    {
-    const int nNodes = network->getNodes().size() - 1;    // -1 due to ground node
-    std::unordered_set<int> conductingNodeIds;
-    std::unordered_map<int, int> groundNodeIds;
-
-    // Sort nodes into conducting nodes and ground nodes.
-    // First loop, all nodes with id > 0 are conducting nodes.
-    int iPump = nNodes;
-    for (const auto& [key, group] : network->getGroups()) {
-        for (const auto& nodeId : group->nodeIds) {
-            if(!network->getNodes().at(nodeId)->getGround() && nodeId != group->groundNodeId) {
-                conductingNodeIds.emplace(nodeId);
-            } else if (!network->getNodes().at(nodeId)->getGround() && nodeId == group->groundNodeId) {
-                groundNodeIds.emplace(nodeId, iPump);
-                iPump++;
-            }
-        }
+bool conductNodalAnalysis( arch::Network<T>* network, SolverType solver) {
+    NodalAnalysis<T> nodalAnalysis(network, solver);
+    return nodalAnalysis.conductNodalAnalysis();
+}
+
+template<typename T>
+NodalAnalysis<T>::NodalAnalysis(arch::Network<T>* network_, SolverType solver_) : network(network_), solver(solver_) { }
+
+template<typename T>
+bool NodalAnalysis<T>::conductNodalAnalysis() {
+    // Rebuild the index map if the topology changed since it was built in Network::sortGroups()
+    if (!network->isIndexMapValid()) {
+        network->updateIndexMap();
     }
+    const auto& indexMap = network->getIndexMap();
+    const auto& nodeRows = indexMap.nodeRows;
 
-    const int nPressurePumps = network->getPressurePumps().size() + groundNodeIds.size();
+    const int nNodes = indexMap.nNodeRows;
+
+    // Sort nodes into conducting nodes and ground nodes of the groups, if the topology or the groups changed
+    if (!classified || classifiedIndexMap != indexMap.version) {
+        classifyNodes();
+    }
+    int iPump = nNodes + nGroundNodePumps;
+
+    const int nPressurePumps = indexMap.pressurePumps.size() + nGroundNodePumps;
     const int nNodesAndPressurePumps = nNodes + nPressurePumps;
 
-    // Generate empty matrix A and vector z
-    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(nNodesAndPressurePumps, nNodesAndPressurePumps);  // matrix A = [G, B; C, D]
+    // Generate empty list of entries of matrix A and vector z
+    std::vector<Eigen::Triplet<double>> A;                                                      // matrix A = [G, B; C, D]
     Eigen::VectorXd z = Eigen::VectorXd::Zero(nNodesAndPressurePumps);                          // vector z = [i; e]
 
     // loop through channels and build matrix G
-    for (const auto& channel : network->getChannels()) {
-        auto nodeAMatrixId = channel.second->getNodeA();
-        auto nodeBMatrixId = channel.second->getNodeB();
-        const T conductance = 1. / channel.second->getResistance();
-
-        // main diagonal elements of G
-        if (!network->getNodes().at(nodeAMatrixId)->getGround()) {
-            A(nodeAMatrixId, nodeAMatrixId) += conductance;
+    const int nChannels = indexMap.channels.size();
+    A.reserve(4 * nChannels + 2 * nPressurePumps);
+    conductances.resize(nChannels);
+    for (int i = 0; i < nChannels; ++i) {
+        const int rowA = indexMap.channelRowsA[i];
+        const int rowB = indexMap.channelRowsB[i];
+        const T conductance = 1. / indexMap.channels[i]->getResistance();
+        conductances[i] = conductance;
+
+        // main diagonal elements of G (ground nodes have no row)
+        if (rowA >= 0) {
+            A.emplace_back(rowA, rowA, conductance);
         }
 
-        if (!network->getNodes().at(nodeBMatrixId)->getGround()) {
-            A(nodeBMatrixId, nodeBMatrixId) += conductance;
+        if (rowB >= 0) {
+            A.emplace_back(rowB, rowB, conductance);
         }
 
         // minor diagonal elements of G (if no ground node was present)
-        if (!network->getNodes().at(nodeAMatrixId)->getGround() && !network->getNodes().at(nodeBMatrixId)->getGround()) {
-            A(nodeAMatrixId, nodeBMatrixId) -= conductance;
-            A(nodeBMatrixId, nodeAMatrixId) -= conductance;
+        if (rowA >= 0 && rowB >= 0) {
+            A.emplace_back(rowA, rowB, -conductance);
+            A.emplace_back(rowB, rowA, -conductance);
         }
     }
 
@@ -60,23 +69,23 @@ bool conductNodalAnalysis( const arch::Network<T>* network)
         // If module is not initialized (1st loop), loop over channels of fully connected graph
         if ( ! module->getInitialized() ) {
             for (const auto& [key, channel] : module->getNetwork()->getChannels()) {
-                auto nodeAMatrixId = channel->getNodeA();
-                auto nodeBMatrixId = channel->getNodeB();
+                const int rowA = nodeRows.at(channel->getNodeA());
+                const int rowB = nodeRows.at(channel->getNodeB());
                 const T conductance = 1. / channel->getResistance();
 
                 // main diagonal elements of G
-                if (contains(conductingNodeIds, nodeAMatrixId)) {
-                    A(nodeAMatrixId, nodeAMatrixId) += conductance;
+                if (isConducting(rowA)) {
+                    A.emplace_back(rowA, rowA, conductance);
                 }
 
-                if (contains(conductingNodeIds, nodeBMatrixId)) {
-                    A(nodeBMatrixId, nodeBMatrixId) += conductance;
+                if (isConducting(rowB)) {
+                    A.emplace_back(rowB, rowB, conductance);
                 }
 
                 // minor diagonal elements of G (if no ground node was present)
-                if (contains(conductingNodeIds, nodeAMatrixId) && contains(conductingNodeIds, nodeBMatrixId)) {
-                    A(nodeAMatrixId, nodeBMatrixId) -= conductance;
-                    A(nodeBMatrixId, nodeAMatrixId) -= conductance;
+                if (isConducting(rowA) && isConducting(rowB)) {
+                    A.emplace_back(rowA, rowB, -conductance);
+                    A.emplace_back(rowB, rowA, -conductance);
                 }
             }
         }
@@ -86,13 +95,14 @@ bool conductNodalAnalysis( const arch::Network<T>* network)
             */
         else if ( module->getInitialized() ) {
             for (const auto& [key, node] : module->getNodes()) {
+                const int row = nodeRows.at(key);
                 // Write the module's flowrates into vector i if the node is not a group's ground node
-                if (contains(conductingNodeIds, key)) {
+                if (isConducting(row)) {
                     T flowRate = module->getFlowRates().at(key) * module->getOpenings().at(key).height;
-                    z(key) = -flowRate;
+                    z(row) = -flowRate;
                 } 
                 // Write module's pressure into matrix B, C and vector e
-                else if (contains(groundNodeIds, key)) {
+                else if (isGroupGround(row)) {
                     T pressure = module->getPressures().at(key);
                     node->setPressure(pressure);
                 }
@@ -105,130 +115,151 @@ bool conductNodalAnalysis( const arch::Network<T>* network)
         if (group->initialized) {
             auto& node = network->getNodes().at(group->groundNodeId);
             group->pRef = node->getPressure();
-            int pumpId = groundNodeIds.at(group->groundNodeId);
+            const int row = nodeRows.at(group->groundNodeId);
+            const int pumpId = groundNodePumps[row];
 
-            A(group->groundNodeId, pumpId) = 1;   // matrix B
-            A(pumpId, group->groundNodeId) = 1;   // matrix C
+            A.emplace_back(row, pumpId, 1);   // matrix B
+            A.emplace_back(pumpId, row, 1);   // matrix C
 
             z(pumpId) = node->getPressure();
         }
     }
 
     // loop through pressurePumps and build matrix B, C and vector e
-    for (const auto& pressurePump : network->getPressurePumps()) {
-        auto nodeAMatrixId = pressurePump.second->getNodeA();
-        auto nodeBMatrixId = pressurePump.second->getNodeB();
+    for (size_t i = 0; i < indexMap.pressurePumps.size(); ++i) {
+        const auto* pressurePump = indexMap.pressurePumps[i];
 
-        if (contains(conductingNodeIds, nodeAMatrixId)) {
-            A(nodeAMatrixId, iPump) = -1;   // matrix B
-            A(iPump, nodeAMatrixId) = -1;   // matrix C
+        if (isConducting(indexMap.pressurePumpRowsA[i])) {
+            A.emplace_back(indexMap.pressurePumpRowsA[i], iPump, -1);   // matrix B
+            A.emplace_back(iPump, indexMap.pressurePumpRowsA[i], -1);   // matrix C
         }
 
-        if (contains(conductingNodeIds, nodeBMatrixId)) {
-            A(nodeBMatrixId, iPump) = 1;   // matrix B
-            A(iPump, nodeBMatrixId) = 1;   // matrix C
+        if (isConducting(indexMap.pressurePumpRowsB[i])) {
+            A.emplace_back(indexMap.pressurePumpRowsB[i], iPump, 1);   // matrix B
+            A.emplace_back(iPump, indexMap.pressurePumpRowsB[i], 1);   // matrix C
         }
 
-        z(iPump) = pressurePump.second->getPressure();
+        z(iPump) = pressurePump->getPressure();
 
         iPump++;
     }
 
     // loop through flowRatePumps and build vector i
-    for (const auto& flowRatePump : network->getFlowRatePumps()) {
-        auto nodeAMatrixId = flowRatePump.second->getNodeA();
-        auto nodeBMatrixId = flowRatePump.second->getNodeB();
-        const T flowRate = flowRatePump.second->getFlowRate();
+    for (size_t i = 0; i < indexMap.flowRatePumps.size(); ++i) {
+        const auto* flowRatePump = indexMap.flowRatePumps[i];
+        const T flowRate = flowRatePump->getFlowRate();
 
-        if (contains(conductingNodeIds, nodeAMatrixId)){
-            z(nodeAMatrixId) = -flowRate;
+        if (isConducting(indexMap.flowRatePumpRowsA[i])) {
+            z(indexMap.flowRatePumpRowsA[i]) = -flowRate;
         }
-        if (contains(conductingNodeIds, nodeBMatrixId)){
-            z(nodeBMatrixId) = flowRate;
+        if (isConducting(indexMap.flowRatePumpRowsB[i])) {
+            z(indexMap.flowRatePumpRowsB[i]) = flowRate;
         }
     }
 
     // solve equation x = A^(-1) * z
-    VectorXd x = A.colPivHouseholderQr().solve(z);
+    VectorXd x;
+    if (solver == SolverType::SparseLU) {
+        x = solveSparse(A, z);
+    } else {
+        x = solveDense(A, z);
+    }
 
     // set pressure of nodes to result value
-    for (const auto& [key, group] : network->getGroups()) {
-        for (auto nodeMatrixId : group->nodeIds) {
-            auto& node = network->getNodes().at(nodeMatrixId);
-            if (contains(conductingNodeIds, nodeMatrixId)) {
-                node->setPressure(x(nodeMatrixId));
-            } else if (node->getGround()) {
-                node->setPressure(0.0);
-            }
+    for (int row = 0; row < nNodes; ++row) {
+        if (conductingRows[row]) {
+            indexMap.rowNodes[row]->setPressure(x(row));
         }
     }
+    for (auto* node : network->getGroundNodes()) {
+        node->setPressure(0.0);
+    }
 
-    for (auto& channel : network->getChannels()) {
-        auto& nodeA = network->getNodes().at(channel.second->getNodeA());
-        auto& nodeB = network->getNodes().at(channel.second->getNodeB());
-        channel.second->setPressure(nodeA->getPressure() - nodeB->getPressure());
+    for (int i = 0; i < nChannels; ++i) {
+        indexMap.channels[i]->setPressure(indexMap.channelNodesA[i]->getPressure() - indexMap.channelNodesB[i]->getPressure());
     }
 
     bool pressureConvergence = true;
 
     // Set the pressures and flow rates on the boundary nodes of the modules
-    for (auto& module : network->getModules()) {
-        std::unordered_map<int, T> old_pressures = module.second->getPressures();
-        std::unordered_map<int, T> old_flowrates = module.second->getFlowRates();
-        std::unordered_map<int, T> pressures_ = module.second->getPressures();
-        std::unordered_map<int, T> flowRates_ = module.second->getFlowRates();
-        for (auto& [key, node] : module.second->getNodes()){
+    std::vector<int> moduleNodes;
+    std::vector<int> interfaceNodes;
+    std::vector<bool> interfaceFlowRates;
+    std::vector<T> oldValues;
+    std::vector<T> newValues;
+    std::vector<T> relaxation;
+    std::vector<T> scales;
+    for (auto& [moduleId, module] : network->getModules()) {
+        std::unordered_map<int, T> pressures_ = module->getPressures();
+        std::unordered_map<int, T> flowRates_ = module->getFlowRates();
+
+        // Assemble the interface vector of the module in the order of the node ids
+        moduleNodes.clear();
+        for (auto& [key, node] : module->getNodes()) {
+            moduleNodes.push_back(key);
+        }
+        std::sort(moduleNodes.begin(), moduleNodes.end());
+
+        interfaceNodes.clear();
+        interfaceFlowRates.clear();
+        oldValues.clear();
+        newValues.clear();
+        relaxation.clear();
+        T pressureScale = 0.0;
+        T flowRateScale = 0.0;
+        for (int key : moduleNodes) {
+            const int row = indexMap.nodeRows.at(key);
             // Communicate pressure to the module
-            if (contains(conductingNodeIds, key)) {
-                T old_pressure = old_pressures.at(key);
-                T new_pressure = node->getPressure();
-                T set_pressure = 0.0;
-                if (old_pressure > 0 ) {
-                    set_pressure = old_pressure + module.second->getAlpha() * ( new_pressure - old_pressure );
-                } else {
-                    set_pressure = new_pressure;
-                }
-                pressures_.at(key) = set_pressure;
-
-                /* Debug mode
-                std::cout << "[NodalAnalysis] at node " << key << " the pressure 2 is set at " << set_pressure << " [Pa] " <<
-                    " from old " << old_pressure << " and new " << new_pressure << std::endl;
-                */
-                if (abs(old_pressure - new_pressure) > 1e-2) {
-                    pressureConvergence = false;
-                }
+            if (isConducting(row)) {
+                interfaceFlowRates.push_back(false);
+                oldValues.push_back(pressures_.at(key));
+                newValues.push_back(module->getNodes().at(key)->getPressure());
+                relaxation.push_back(module->getAlpha());
+                pressureScale = std::max(pressureScale, std::abs(newValues.back()));
             }
             // Communicate the flow rate to the module
-            else if (contains(groundNodeIds, key)) {
-                T old_flowRate = old_flowrates.at(key) ;
-                T new_flowRate = x(groundNodeIds.at(key)) / module.second->getOpenings().at(key).width;
-                T set_flowRate = 0.0;
-                if (old_flowRate > 0 ) {
-                    set_flowRate = old_flowRate + 5 * module.second->getAlpha() *  ( new_flowRate - old_flowRate );
-                } else {
-                    set_flowRate = new_flowRate;
-                }
-                flowRates_.at(key) = set_flowRate;
+            else if (isGroupGround(row)) {
+                interfaceFlowRates.push_back(true);
+                oldValues.push_back(flowRates_.at(key));
+                newValues.push_back(x(groundNodePumps[row]) / module->getOpenings().at(key).width);
+                relaxation.push_back(5 * module->getAlpha());
+                flowRateScale = std::max(flowRateScale, std::abs(newValues.back()));
+            } else {
+                continue;
+            }
+            interfaceNodes.push_back(key);
 
-                /* Debug mode
-                std::cout << "[NodalAnalysis] at node " << key << " we set flow rate 2 is at " << set_flowRate << " [m^2/s] " <<
-                    " from old " << old_flowRate << " and new " << new_flowRate << std::endl;
-                */
+            /* Debug mode
+            std::cout << "[NodalAnalysis] at node " << key << " the value is " << newValues.back() <<
+                " from old " << oldValues.back() << std::endl;
+            */
+            if (abs(oldValues.back() - newValues.back()) > 1e-2) {
+                pressureConvergence = false;
+            }
+        }
 
-                if (abs(old_flowRate - new_flowRate) > 1e-2) {
-                    pressureConvergence = false;
-                }
+        scales.resize(oldValues.size());
+        for (size_t i = 0; i < oldValues.size(); ++i) {
+            const T scale = interfaceFlowRates[i] ? flowRateScale : pressureScale;
+            scales[i] = (scale > 0.0) ? scale : 1.0;
+        }
+
+        std::vector<T> values = moduleAccelerator(moduleId).update(oldValues, newValues, relaxation, scales);
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (interfaceFlowRates[i]) {
+                flowRates_.at(interfaceNodes[i]) = values[i];
+            } else {
+                pressures_.at(interfaceNodes[i]) = values[i];
             }
         }
-        module.second->setPressures(pressures_);
-        module.second->setFlowRates(flowRates_);
+        module->setPressures(pressures_);
+        module->setFlowRates(flowRates_);
+        module->adaptTheta();
     }
 
     // set flow rate at pressure pumps
-    iPump = nNodes;
-    for (auto& pressurePump : network->getPressurePumps()){
-        pressurePump.second->setFlowRate(x(iPump));
-        iPump++;
+    for (size_t i = 0; i < indexMap.pressurePumps.size(); ++i) {
+        indexMap.pressurePumps[i]->setFlowRate(x(nNodes + i));
     }
 
     // Initialize the ground nodes of the groups
@@ -236,12 +267,13 @@ bool conductNodalAnalysis( const arch::Network<T>* network)
         if (!group->initialized && !group->grounded) {
             T pMin = -1.0;
             for (auto nodeId : group->nodeIds) {
+                const int row = nodeRows.at(nodeId);
                 if (pMin < 0.0) {
-                    pMin = x(nodeId);
+                    pMin = x(row);
                     group->groundNodeId = nodeId;
                 }
-                if (x(nodeId) < pMin) {
-                    pMin = x(nodeId);
+                if (x(row) < pMin) {
+                    pMin = x(row);
                     group->groundNodeId = nodeId;
                 }
             }
@@ -253,8 +285,10 @@ bool conductNodalAnalysis( const arch::Network<T>* network)
                     group->groundChannelId = channelId;
                 }
             }
-            groundNodeIds.emplace(group->groundNodeId, 0);
-            conductingNodeIds.erase(group->groundNodeId);
+            // The pump row of the new ground node is assigned in the next classification
+            conductingRows[nodeRows.at(group->groundNodeId)] = false;
+            groundNodePumps[nodeRows.at(group->groundNodeId)] = 0;
+            classified = false;
             group->initialized = true;
         }
     }
@@ -266,7 +300,7 @@ bool conductNodalAnalysis( const arch::Network<T>* network)
             std::unordered_map<int, bool> groundNodes;
             for (const auto& [nodeId, node] : module->getNodes()) {
                 T flowRate = 0.0;
-                if (contains(groundNodeIds, nodeId)) {
+                if (isGroupGround(nodeRows.at(nodeId))) {
                     groundNodes.try_emplace(nodeId, true);
                     for (auto& [key, group] : network->getGroups()) {
                         if (nodeId == group->groundNodeId) {
@@ -288,24 +322,336 @@ bool conductNodalAnalysis( const arch::Network<T>* network)
     return pressureConvergence;
 }
 
-bool contains( const std::unordered_set<int>& set, int key) {
-    bool contain = false;
-    for (auto& nodeId : set) {
-        if (key == nodeId) {
-            contain = true;
+template<typename T>
+void NodalAnalysis<T>::classifyNodes() {
+    const auto& indexMap = network->getIndexMap();
+
+    conductingRows.assign(indexMap.nNodeRows, false);
+    groundNodePumps.assign(indexMap.nNodeRows, -1);
+    nGroundNodePumps = 0;
+
+    // Nodes of the groups are conducting nodes, except for the ground node of a group, whose pressure is set by a pump.
+    // Ground nodes of the network have no row and are never conducting.
+    for (const auto& [key, group] : network->getGroups()) {
+        for (const auto& nodeId : group->nodeIds) {
+            const int row = indexMap.nodeRows.at(nodeId);
+            if (row < 0) {
+                continue;
+            }
+            if (nodeId != group->groundNodeId) {
+                conductingRows[row] = true;
+            } else {
+                groundNodePumps[row] = indexMap.nNodeRows + nGroundNodePumps;
+                nGroundNodePumps++;
+            }
+        }
+    }
+
+    // The layout of the interface vectors of the modules may have changed
+    for (auto& [moduleId, accelerator] : accelerators) {
+        accelerator->reset();
+    }
+
+    classifiedIndexMap = indexMap.version;
+    classified = true;
+}
+
+template<typename T>
+CouplingAccelerator<T>& NodalAnalysis<T>::moduleAccelerator(int moduleId) {
+    auto accelerator = accelerators.find(moduleId);
+    if (accelerator == accelerators.end()) {
+        std::unique_ptr<CouplingAccelerator<T>> newAccelerator;
+        if (acceleratorType == AcceleratorType::Aitken) {
+            newAccelerator = std::make_unique<AitkenRelaxation<T>>();
+        } else if (acceleratorType == AcceleratorType::Anderson) {
+            newAccelerator = std::make_unique<AndersonMixing<T>>(andersonDepth);
+        } else {
+            newAccelerator = std::make_unique<ConstantRelaxation<T>>();
+        }
+        accelerator = accelerators.try_emplace(moduleId, std::move(newAccelerator)).first;
+    }
+    return *accelerator->second;
+}
+
+template<typename T>
+bool NodalAnalysis<T>::isConducting(int row) const {
+    return row >= 0 && conductingRows[row];
+}
+
+template<typename T>
+bool NodalAnalysis<T>::isGroupGround(int row) const {
+    return row >= 0 && groundNodePumps[row] >= 0;
+}
+
+template<typename T>
+VectorXd NodalAnalysis<T>::solveDense(const std::vector<Eigen::Triplet<double>>& triplets, const VectorXd& z) {
+    const auto& indexMap = network->getIndexMap();
+    const int nNodes = indexMap.nNodeRows;
+
+    // The rows of the dense system keep the original layout (see arch::NodalIndexMap), since the column pivoting of the QR
+    // decomposition depends on the order of the rows of this ill-conditioned system
+    const int n = z.size() - nNodes + indexMap.nDenseRows;
+    auto denseRow = [&](int row) { return (row < nNodes) ? indexMap.denseRows[row] : row - nNodes + indexMap.nDenseRows; };
+
+    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(n, n);
+    for (const auto& triplet : triplets) {
+        A(denseRow(triplet.row()), denseRow(triplet.col())) += triplet.value();
+    }
+    VectorXd denseZ = VectorXd::Zero(n);
+    for (int row = 0; row < z.size(); ++row) {
+        denseZ(denseRow(row)) = z(row);
+    }
+
+    nFactorizations++;
+    VectorXd denseX = A.colPivHouseholderQr().solve(denseZ);
+    VectorXd x(z.size());
+    for (int row = 0; row < z.size(); ++row) {
+        x(row) = denseX(denseRow(row));
+    }
+    return x;
+}
+
+template<typename T>
+VectorXd NodalAnalysis<T>::solveSparse(const std::vector<Eigen::Triplet<double>>& triplets, const VectorXd& z) {
+    const int n = z.size();
+
+    // Rows without entries belong to nodes that are not part of the system (e.g., ground nodes).
+    // The dense QR decomposition sets these unknowns to zero, hence they are pinned to zero here.
+    std::vector<bool> hasEntry(n, false);
+    for (const auto& triplet : triplets) {
+        hasEntry[triplet.row()] = true;
+    }
+    std::vector<Eigen::Triplet<double>> entries(triplets);
+    for (int i = 0; i < n; ++i) {
+        if (!hasEntry[i]) {
+            entries.emplace_back(i, i, 1.0);
+        }
+    }
+
+    sparseA.resize(n, n);
+    sparseA.setFromTriplets(entries.begin(), entries.end());
+    sparseA.makeCompressed();
+
+    // The symbolic factorization only depends on the sparsity pattern, which stays the same as long as the topology does not change.
+    const bool patternChanged = !patternAnalyzed || !samePattern();
+
+    trackReportedChannels();
+
+    // Try to reuse the last factorization with a low-rank update. Modules are excluded, since their boundary conditions change the system beyond channel conductances.
+    if (!patternChanged && incremental && factorized && nUpdates < maxUpdates && network->getModules().empty()
+        && factorizedIndexMap == network->getIndexMap().version) {
+        VectorXd x;
+        if (solveIncremental(z, x)) {
+            nUpdates++;
+            nIncrementalSolves++;
+            return x;
+        }
+    }
+
+    if (patternChanged) {
+        sparseLU.analyzePattern(sparseA);
+        outerIndices.assign(sparseA.outerIndexPtr(), sparseA.outerIndexPtr() + sparseA.outerSize() + 1);
+        innerIndices.assign(sparseA.innerIndexPtr(), sparseA.innerIndexPtr() + sparseA.nonZeros());
+        patternAnalyzed = true;
+        nPatternAnalyses++;
+    }
+
+    sparseLU.factorize(sparseA);
+    nFactorizations++;
+    if (sparseLU.info() != Eigen::Success) {
+        patternAnalyzed = false;
+        factorized = false;
+        throw std::runtime_error("Nodal analysis failed. The sparse LU decomposition of the system matrix was not successful: " + sparseLU.lastErrorMessage());
+    }
+    factorized = true;
+    factorizedConductances = conductances;
+    factorizedIndexMap = network->getIndexMap().version;
+    nUpdates = 0;
+    changesTracked = true;
+    updatedChannels.clear();
+    channelUpdated.assign(conductances.size(), false);
+
+    return sparseLU.solve(z);
+}
+
+template<typename T>
+void NodalAnalysis<T>::trackReportedChannels() {
+    const auto& indexMap = network->getIndexMap();
+    if (!changesReported || !factorized || factorizedIndexMap != indexMap.version) {
+        changesTracked = false;
+    } else if (changesTracked) {
+        for (int channelId : reportedChannels) {
+            auto channel = indexMap.channelIndices.find(channelId);
+            if (channel == indexMap.channelIndices.end()) {
+                changesTracked = false;
+                break;
+            }
+            if (!channelUpdated[channel->second]) {
+                channelUpdated[channel->second] = true;
+                updatedChannels.push_back(channel->second);
+            }
         }
     }
-    return contain;
+    reportedChannels.clear();
+    changesReported = false;
 }
 
-bool contains( const std::unordered_map<int, int>& map, int key) {
-    bool contain = false;
-    for (auto& [nodeId, pumpId] : map) {
-        if (key == nodeId) {
-            contain = true;
+template<typename T>
+bool NodalAnalysis<T>::solveIncremental(const VectorXd& z, VectorXd& x) {
+    // Collect the channels whose conductance differs from the factorized system, only the reported channels can differ if they are tracked
+    const auto& indexMap = network->getIndexMap();
+    std::vector<int> changedChannels;
+    if (changesTracked) {
+        for (int i : updatedChannels) {
+            if (conductances[i] != factorizedConductances[i]) {
+                changedChannels.push_back(i);
+                if (static_cast<int>(changedChannels.size()) > maxUpdateRank) {
+                    return false;
+                }
+            }
         }
+        std::sort(changedChannels.begin(), changedChannels.end());
+    } else {
+        for (size_t i = 0; i < conductances.size(); ++i) {
+            if (conductances[i] != factorizedConductances[i]) {
+                changedChannels.push_back(i);
+                if (static_cast<int>(changedChannels.size()) > maxUpdateRank) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    // y = A0^(-1) * z
+    VectorXd y = sparseLU.solve(z);
+
+    if (changedChannels.empty()) {
+        x = y;
+    } else {
+        // A = A0 + U * D * U^T, where the column u of a channel is e_a - e_b and D holds the conductance changes.
+        // Sherman-Morrison-Woodbury: x = y - W * (I + D * U^T * W)^(-1) * D * U^T * y, with W = A0^(-1) * U
+        const int k = changedChannels.size();
+        Eigen::MatrixXd U = Eigen::MatrixXd::Zero(z.size(), k);
+        Eigen::VectorXd d(k);
+        for (int j = 0; j < k; ++j) {
+            const int rowA = indexMap.channelRowsA[changedChannels[j]];
+            const int rowB = indexMap.channelRowsB[changedChannels[j]];
+            if (rowA >= 0) {
+                U(rowA, j) = 1.0;
+            }
+            if (rowB >= 0) {
+                U(rowB, j) = -1.0;
+            }
+            d(j) = conductances[changedChannels[j]] - factorizedConductances[changedChannels[j]];
+        }
+
+        Eigen::MatrixXd W = sparseLU.solve(U);
+        Eigen::MatrixXd C = Eigen::MatrixXd::Identity(k, k) + d.asDiagonal() * (U.transpose() * W);
+        x = y - W * C.partialPivLu().solve(d.asDiagonal() * (U.transpose() * y));
+    }
+
+    // Fall back to a full factorization if the update lost accuracy. The residual is scaled per row by (|A| * |x| + |z|),
+    // since the pump rows (pressures) would otherwise hide errors in the node rows (conductances times pressures).
+    const VectorXd residual = sparseA * x - z;
+    VectorXd scale = z.cwiseAbs();
+    for (int k = 0; k < sparseA.outerSize(); ++k) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(sparseA, k); it; ++it) {
+            scale(it.row()) += std::abs(it.value() * x(it.col()));
+        }
+    }
+    for (int i = 0; i < residual.size(); ++i) {
+        if (!std::isfinite(residual(i))) {
+            return false;
+        }
+        if (scale(i) > 0.0 && std::abs(residual(i)) > updateTolerance * scale(i)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename T>
+bool NodalAnalysis<T>::samePattern() const {
+    if (static_cast<size_t>(sparseA.outerSize() + 1) != outerIndices.size() || static_cast<size_t>(sparseA.nonZeros()) != innerIndices.size()) {
+        return false;
+    }
+    return std::equal(outerIndices.begin(), outerIndices.end(), sparseA.outerIndexPtr()) &&
+        std::equal(innerIndices.begin(), innerIndices.end(), sparseA.innerIndexPtr());
+}
+
+template<typename T>
+void NodalAnalysis<T>::setSolverType(SolverType solver_) {
+    this->solver = solver_;
+    this->patternAnalyzed = false;
+    this->factorized = false;
+}
+
+template<typename T>
+void NodalAnalysis<T>::setIncrementalUpdates(bool incremental_, int maxUpdates_, int maxUpdateRank_, double updateTolerance_) {
+    if (maxUpdates_ < 0 || maxUpdateRank_ < 0 || updateTolerance_ <= 0.0) {
+        throw std::invalid_argument("Invalid parameters for incremental updates of the nodal analysis.");
+    }
+    this->incremental = incremental_;
+    this->maxUpdates = maxUpdates_;
+    this->maxUpdateRank = maxUpdateRank_;
+    this->updateTolerance = updateTolerance_;
+}
+
+template<typename T>
+void NodalAnalysis<T>::setChangedChannels(const std::vector<int>& channelIds) {
+    // the reports are only consumed by the low-rank updates of the sparse solver
+    if (!incremental || solver != SolverType::SparseLU) {
+        return;
+    }
+    reportedChannels.insert(reportedChannels.end(), channelIds.begin(), channelIds.end());
+    changesReported = true;
+}
+
+template<typename T>
+void NodalAnalysis<T>::setCouplingAccelerator(AcceleratorType acceleratorType_, int andersonDepth_) {
+    if (andersonDepth_ < 1) {
+        throw std::invalid_argument("The depth of the Anderson mixing must be at least 1.");
     }
-    return contain;
+    this->acceleratorType = acceleratorType_;
+    this->andersonDepth = andersonDepth_;
+    this->accelerators.clear();
+}
+
+template<typename T>
+AcceleratorType NodalAnalysis<T>::getCouplingAccelerator() const {
+    return this->acceleratorType;
+}
+
+template<typename T>
+const CouplingAccelerator<T>* NodalAnalysis<T>::getCouplingAccelerator(int moduleId) const {
+    auto accelerator = accelerators.find(moduleId);
+    return (accelerator != accelerators.end()) ? accelerator->second.get() : nullptr;
+}
+
+template<typename T>
+bool NodalAnalysis<T>::getIncrementalUpdates() const {
+    return this->incremental;
+}
+
+template<typename T>
+SolverType NodalAnalysis<T>::getSolverType() const {
+    return this->solver;
+}
+
+template<typename T>
+int NodalAnalysis<T>::getPatternAnalyses() const {
+    return this->nPatternAnalyses;
+}
+
+template<typename T>
+int NodalAnalysis<T>::getFactorizations() const {
+    return this->nFactorizations;
+}
+
+template<typename T>
+int NodalAnalysis<T>::getIncrementalSolves() const {
+    return this->nIncrementalSolves;
 }
 
 }   // namespace nodal
\ No newline at end of file
@@ -0,0 +1,400 @@
+/**
+ * @file binaryResult.h
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "nlohmann/json.hpp"
+
+namespace result {
+
+// Forward declared dependencies
+struct ColumnLayout;
+
+}   // namespace result
+
+namespace porting {
+
+/**
+ * The binary result format stores the states of a simulation in little-endian byte order:
+ * - BinaryHeader, followed by the ids of the nodes and edges (int32) in the order of the columns, padded to 8 bytes.
+ * - Chunks of consecutive states. Each chunk consists of a BinaryChunkHeader, the times of its states, one column per node with
+ *   the pressures of its states, one column per edge with the flow rates of its states and the droplet positions of its states,
+ *   padded to 8 bytes. All values have the fixed width valueSize.
+ * - The chunk index (one BinaryChunkIndex per chunk) and the fluids, which are written when the simulation finished.
+ * The header is updated after every chunk. Hence, the file of an interrupted simulation contains all written chunks and the
+ * chunks are found by their headers, if the chunk index is missing (indexOffset is 0).
+ */
+
+inline constexpr char binaryResultMagic[8] = { 'M', 'M', 'F', 'T', 'R', 'E', 'S', '\0' };    ///< First bytes of a binary result file.
+inline constexpr uint32_t binaryResultVersion = 1;                                          ///< Version of the binary result format.
+
+/**
+ * @brief Header at the beginning of a binary result file.
+ */
+struct BinaryHeader {
+    char magic[8];              ///< Identifies a binary result file, see binaryResultMagic.
+    uint32_t version;           ///< Version of the format.
+    uint32_t valueSize;         ///< Width of the stored values in bytes (4 for float, 8 for double).
+    int32_t fixtureId;          ///< Id of the fixture of the simulation.
+    uint32_t reserved;          ///< Unused.
+    char type[16];              ///< Type of the simulation, as written by writeSimType.
+    char platform[16];          ///< Platform of the simulation, as written by writeSimPlatform.
+    uint64_t nNodes;            ///< Number of nodes (pressure columns).
+    uint64_t nEdges;            ///< Number of edges (flow rate columns).
+    uint64_t nStates;           ///< Number of states in the written chunks.
+    uint64_t nChunks;           ///< Number of written chunks.
+    uint64_t indexOffset;       ///< Position of the chunk index, 0 if it was not written (yet).
+    uint64_t fluidsOffset;      ///< Position of the fluids, 0 if they were not written (yet).
+};
+
+/**
+ * @brief Header at the beginning of each chunk of a binary result file.
+ */
+struct BinaryChunkHeader {
+    uint64_t firstState;        ///< Index of the first state of the chunk.
+    uint64_t nStates;           ///< Number of states of the chunk.
+    uint64_t dropletBytes;      ///< Size of the droplet positions of the chunk in bytes.
+    uint64_t size;              ///< Size of the chunk (including this header and the padding) in bytes.
+};
+
+/**
+ * @brief Entry of the chunk index of a binary result file.
+ */
+struct BinaryChunkIndex {
+    uint64_t offset;            ///< Position of the chunk header in the file.
+    uint64_t firstState;        ///< Index of the first state of the chunk.
+    uint64_t nStates;           ///< Number of states of the chunk.
+    double startTime;           ///< Time of the first state of the chunk in s.
+    double endTime;             ///< Time of the last state of the chunk in s.
+};
+
+static_assert(sizeof(BinaryHeader) == 104, "The binary result header must not contain padding.");
+static_assert(sizeof(BinaryChunkHeader) == 32, "The binary chunk header must not contain padding.");
+static_assert(sizeof(BinaryChunkIndex) == 40, "The binary chunk index must not contain padding.");
+
+/**
+ * @brief Boundary of a droplet, as stored in a binary result file.
+ */
+template<typename T>
+struct BinaryBoundary {
+    int channelId;              ///< Id of the channel of the boundary.
+    T position;                 ///< Relative position of the boundary inside the channel.
+    bool volumeTowardsNodeA;    ///< If the volume of the droplet is located towards node A of the channel.
+    int state;                  ///< State of the boundary, see sim::BoundaryState.
+};
+
+/**
+ * @brief Position of a droplet, as stored in a binary result file.
+ */
+template<typename T>
+struct BinaryDroplet {
+    int id;                                         ///< Id of the droplet.
+    int fluidId;                                    ///< Id of the fluid of the droplet.
+    T volume;                                       ///< Volume of the droplet in m^3.
+    std::vector<BinaryBoundary<T>> boundaries;      ///< Boundaries of the droplet.
+    std::vector<int> channelIds;                    ///< Ids of the channels that are fully occupied by the droplet.
+};
+
+/**
+ * @brief Fluid, as stored in a binary result file.
+ */
+struct BinaryFluid {
+    int id;                     ///< Id of the fluid.
+    std::string name;           ///< Name of the fluid.
+    double concentration;       ///< Concentration of the fluid.
+    double density;             ///< Density of the fluid in kg/m^3.
+    double viscosity;           ///< Viscosity of the fluid in Pa s.
+};
+
+/**
+ * @brief Check if the host stores values in little-endian byte order, which is the byte order of the binary result format.
+ * @return If the host is little-endian.
+ */
+bool isLittleEndian();
+
+/**
+ * @brief Round a size up to a multiple of 8 bytes, so that the following values are aligned.
+ * @param[in] size Size in bytes.
+ * @return Aligned size in bytes.
+ */
+uint64_t alignBinary(uint64_t size);
+
+/**
+ * @brief Get the position of the first chunk of a binary result file, i.e., the size of the header and the ids of the nodes and edges.
+ * @param[in] header Header of the file.
+ * @return Position in bytes.
+ */
+uint64_t binaryDataOffset(const BinaryHeader& header);
+
+/**
+ * @brief Append the bytes of a value to a buffer.
+ * @param[in,out] bytes The buffer.
+ * @param[in] value The value.
+ */
+template<typename V>
+void appendBinary(std::vector<char>& bytes, const V& value);
+
+/**
+ * @brief Read a value from a position in a buffer and advance the position. Throws std::invalid_argument if the value exceeds the
+ * end of the buffer.
+ * @param[in,out] position Position of the value.
+ * @param[in] end End of the buffer.
+ * @return The value.
+ */
+template<typename V>
+V readBinary(const char*& position, const char* end);
+
+/**
+ * @brief Check that a number of bytes can be read from a position in a buffer. Throws std::invalid_argument otherwise.
+ * @param[in] position Position of the bytes.
+ * @param[in] end End of the buffer.
+ * @param[in] bytes Number of bytes.
+ */
+void checkBinary(const char* position, const char* end, uint64_t bytes);
+
+/**
+ * @brief Read-only view of contiguous values inside a memory-mapped binary result file.
+ */
+template<typename T>
+class ValueSpan {
+  private:
+    const T* values = nullptr;      ///< First value.
+    size_t count = 0;               ///< Number of values.
+
+  public:
+    /**
+     * @brief Constructs an empty span.
+     */
+    ValueSpan() = default;
+
+    /**
+     * @brief Constructs a span.
+     * @param[in] values First value.
+     * @param[in] count Number of values.
+     */
+    ValueSpan(const T* values, size_t count);
+
+    const T& operator[](size_t index) const;
+    const T* data() const;
+    size_t size() const;
+    bool empty() const;
+    const T* begin() const;
+    const T* end() const;
+};
+
+/**
+ * @brief Class that reads a binary result file. The file is memory-mapped, so that the columns of single nodes or edges are read
+ * without copying and only the parts of the file that are accessed are loaded, e.g., the flow rates of a few channels.
+ */
+template<typename T>
+class BinaryResultReader {
+  private:
+    std::string path;                                   ///< Location of the file.
+    const char* data = nullptr;                         ///< Begin of the mapped file.
+    size_t fileSize = 0;                                ///< Size of the file in bytes.
+#ifdef _WIN32
+    void* fileHandle = nullptr;                         ///< Handle of the opened file.
+    void* mappingHandle = nullptr;                      ///< Handle of the file mapping.
+#else
+    int fileDescriptor = -1;                            ///< Descriptor of the opened file.
+#endif
+    BinaryHeader header;                                ///< Header of the file.
+    std::unique_ptr<result::ColumnLayout> nodeLayout;   ///< Order of the nodes of the pressure columns.
+    std::unique_ptr<result::ColumnLayout> edgeLayout;   ///< Order of the edges of the flow rate columns.
+    std::vector<BinaryChunkIndex> chunks;               ///< Chunk index.
+    size_t nStates = 0;                                 ///< Number of states in the chunks.
+
+    /**
+     * @brief Map the file into memory.
+     */
+    void map();
+
+    /**
+     * @brief Unmap the file and close it.
+     */
+    void unmap();
+
+    /**
+     * @brief Read the chunk index, or find the chunks by their headers if the index was not written or refers to invalid chunks.
+     */
+    void readChunkIndex();
+
+    /**
+     * @brief Check that a chunk lies inside the file and contains its columns and droplet positions.
+     * @param[in] offset Position of the chunk header in the file.
+     * @param[in] nChunkStates Expected number of states of the chunk.
+     * @return If the chunk is valid.
+     */
+    bool isValidChunk(uint64_t offset, uint64_t nChunkStates) const;
+
+    /**
+     * @brief Get the position of a column of a chunk.
+     * @param[in] chunk Index of the chunk.
+     * @param[in] column Index of the column (0 for the times, followed by the node and the edge columns).
+     * @return Pointer to the first value of the column.
+     */
+    const T* getColumn(size_t chunk, size_t column) const;
+
+  public:
+    /**
+     * @brief Constructs a reader and maps the file. Throws std::invalid_argument if the file is no binary result file or its values
+     * do not have the width of T.
+     * @param[in] file Location of the file.
+     */
+    explicit BinaryResultReader(std::string file);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~BinaryResultReader();
+
+    BinaryResultReader(const BinaryResultReader&) = delete;
+    BinaryResultReader& operator=(const BinaryResultReader&) = delete;
+
+    /**
+     * @brief Check if the file was completed, i.e., the chunk index and the fluids were written.
+     * @return If the file is complete.
+     */
+    bool isComplete() const;
+
+    /**
+     * @brief Get the id of the fixture of the simulation.
+     * @return Fixture id.
+     */
+    int getFixtureId() const;
+
+    /**
+     * @brief Get the type of the simulation.
+     * @return Type, as written by writeSimType.
+     */
+    std::string getType() const;
+
+    /**
+     * @brief Get the platform of the simulation.
+     * @return Platform, as written by writeSimPlatform.
+     */
+    std::string getPlatform() const;
+
+    /**
+     * @brief Get the order of the nodes.
+     * @return Ids of the nodes in the order of the pressure columns.
+     */
+    const std::vector<int>& getNodeIds() const;
+
+    /**
+     * @brief Get the order of the edges.
+     * @return Ids of the edges in the order of the flow rate columns.
+     */
+    const std::vector<int>& getEdgeIds() const;
+
+    /**
+     * @brief Get the number of states.
+     * @return Number of states.
+     */
+    size_t getNumberOfStates() const;
+
+    /**
+     * @brief Get the number of chunks.
+     * @return Number of chunks.
+     */
+    size_t getNumberOfChunks() const;
+
+    /**
+     * @brief Get the index entry of a chunk.
+     * @param[in] chunk Index of the chunk.
+     * @return Position, states and time range of the chunk.
+     */
+    const BinaryChunkIndex& getChunk(size_t chunk) const;
+
+    /**
+     * @brief Find the chunks that contain the states of a time range.
+     * @param[in] startTime Begin of the time range in s.
+     * @param[in] endTime End of the time range in s.
+     * @return Index of the first chunk and index after the last chunk.
+     */
+    std::pair<size_t, size_t> findChunks(T startTime, T endTime) const;
+
+    /**
+     * @brief Get the times of the states of a chunk.
+     * @param[in] chunk Index of the chunk.
+     * @return Times in s.
+     */
+    ValueSpan<T> getTimes(size_t chunk) const;
+
+    /**
+     * @brief Get the pressures at a node of the states of a chunk.
+     * @param[in] chunk Index of the chunk.
+     * @param[in] nodeId Id of the node.
+     * @return Pressures in Pa.
+     */
+    ValueSpan<T> getPressures(size_t chunk, int nodeId) const;
+
+    /**
+     * @brief Get the flow rates of an edge of the states of a chunk.
+     * @param[in] chunk Index of the chunk.
+     * @param[in] edgeId Id of the edge (channel or pump).
+     * @return Flow rates in m^3/s.
+     */
+    ValueSpan<T> getFlowRates(size_t chunk, int edgeId) const;
+
+    /**
+     * @brief Read the droplet positions of the states of a chunk. Throws std::invalid_argument if the droplet positions exceed the
+     * chunk or the file, e.g., if the file is corrupted.
+     * @param[in] chunk Index of the chunk.
+     * @return Droplets inside the network of each state.
+     */
+    std::vector<std::vector<BinaryDroplet<T>>> readDroplets(size_t chunk) const;
+
+    /**
+     * @brief Read the fluids of the simulation. Throws std::invalid_argument if the fluids exceed the file, e.g., if the file is
+     * corrupted.
+     * @return Fluids, empty if the file is not complete.
+     */
+    std::vector<BinaryFluid> readFluids() const;
+};
+
+/**
+ * @brief Convert a binary result file into the JSON format of resultToJSON.
+ * @param[in] binaryFile Location of the binary result file.
+ * @return The json result.
+ */
+template<typename T>
+nlohmann::ordered_json binaryResultToJSON(std::string binaryFile);
+
+/**
+ * @brief Convert a binary result file into a JSON file in the format of resultToJSON.
+ * @param[in] binaryFile Location of the binary result file.
+ * @param[in] jsonFile Location of the JSON file.
+ */
+template<typename T>
+void binaryResultToJSON(std::string binaryFile, std::string jsonFile);
+
+}   // namespace porting
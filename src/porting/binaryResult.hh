@@ -0,0 +1,497 @@
+#include "binaryResult.h"
+
+namespace porting {
+
+inline bool isLittleEndian() {
+    const uint16_t one = 1;
+    unsigned char firstByte;
+    std::memcpy(&firstByte, &one, 1);
+    return firstByte == 1;
+}
+
+inline uint64_t alignBinary(uint64_t size) {
+    return (size + 7) / 8 * 8;
+}
+
+inline uint64_t binaryDataOffset(const BinaryHeader& header) {
+    return alignBinary(sizeof(BinaryHeader) + sizeof(int32_t) * (header.nNodes + header.nEdges));
+}
+
+template<typename V>
+void appendBinary(std::vector<char>& bytes, const V& value) {
+    const size_t size = bytes.size();
+    bytes.resize(size + sizeof(V));
+    std::memcpy(bytes.data() + size, &value, sizeof(V));
+}
+
+inline void checkBinary(const char* position, const char* end, uint64_t bytes) {
+    if (position > end || static_cast<uint64_t>(end - position) < bytes) {
+        throw std::invalid_argument("The binary result file is truncated or corrupted.");
+    }
+}
+
+template<typename V>
+V readBinary(const char*& position, const char* end) {
+    checkBinary(position, end, sizeof(V));
+    V value;
+    std::memcpy(&value, position, sizeof(V));
+    position += sizeof(V);
+    return value;
+}
+
+template<typename T>
+ValueSpan<T>::ValueSpan(const T* values_, size_t count_) : values(values_), count(count_) { }
+
+template<typename T>
+const T& ValueSpan<T>::operator[](size_t index) const {
+    return values[index];
+}
+
+template<typename T>
+const T* ValueSpan<T>::data() const {
+    return values;
+}
+
+template<typename T>
+size_t ValueSpan<T>::size() const {
+    return count;
+}
+
+template<typename T>
+bool ValueSpan<T>::empty() const {
+    return count == 0;
+}
+
+template<typename T>
+const T* ValueSpan<T>::begin() const {
+    return values;
+}
+
+template<typename T>
+const T* ValueSpan<T>::end() const {
+    return values + count;
+}
+
+template<typename T>
+void BinaryResultReader<T>::map() {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::invalid_argument("The result file " + path + " cannot be opened.");
+    }
+    fileHandle = file;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        unmap();
+        throw std::invalid_argument("The result file " + path + " is empty.");
+    }
+    fileSize = static_cast<size_t>(size.QuadPart);
+    mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle != nullptr) {
+        data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (data == nullptr) {
+        unmap();
+        throw std::invalid_argument("The result file " + path + " cannot be mapped.");
+    }
+#else
+    fileDescriptor = ::open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        throw std::invalid_argument("The result file " + path + " cannot be opened.");
+    }
+    struct stat status;
+    if (::fstat(fileDescriptor, &status) != 0 || status.st_size == 0) {
+        unmap();
+        throw std::invalid_argument("The result file " + path + " is empty.");
+    }
+    fileSize = static_cast<size_t>(status.st_size);
+    void* address = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (address == MAP_FAILED) {
+        unmap();
+        throw std::invalid_argument("The result file " + path + " cannot be mapped.");
+    }
+    data = static_cast<const char*>(address);
+#endif
+}
+
+template<typename T>
+void BinaryResultReader<T>::unmap() {
+#ifdef _WIN32
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != nullptr) {
+        CloseHandle(fileHandle);
+    }
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (data != nullptr) {
+        ::munmap(const_cast<char*>(data), fileSize);
+    }
+    if (fileDescriptor >= 0) {
+        ::close(fileDescriptor);
+    }
+    fileDescriptor = -1;
+#endif
+    data = nullptr;
+}
+
+template<typename T>
+bool BinaryResultReader<T>::isValidChunk(uint64_t offset, uint64_t nChunkStates) const {
+    if (offset > fileSize || fileSize - offset < sizeof(BinaryChunkHeader)) {
+        return false;
+    }
+    BinaryChunkHeader chunkHeader;
+    std::memcpy(&chunkHeader, data + offset, sizeof(BinaryChunkHeader));
+    if (chunkHeader.nStates == 0 || chunkHeader.nStates != nChunkStates || chunkHeader.size < sizeof(BinaryChunkHeader)
+        || chunkHeader.size > fileSize - offset) {
+        return false;
+    }
+    const uint64_t stateBytes = sizeof(T) * (1 + header.nNodes + header.nEdges);
+    const uint64_t chunkBytes = chunkHeader.size - sizeof(BinaryChunkHeader);
+    return chunkHeader.nStates <= chunkBytes / stateBytes
+        && chunkHeader.dropletBytes <= chunkBytes - chunkHeader.nStates * stateBytes;
+}
+
+template<typename T>
+void BinaryResultReader<T>::readChunkIndex() {
+    chunks.clear();
+    nStates = 0;
+    if (header.indexOffset != 0 && header.indexOffset <= fileSize && header.nChunks <= (fileSize - header.indexOffset) / sizeof(BinaryChunkIndex)) {
+        chunks.resize(header.nChunks);
+        std::memcpy(chunks.data(), data + header.indexOffset, header.nChunks * sizeof(BinaryChunkIndex));
+        if (!std::all_of(chunks.begin(), chunks.end(), [this](const BinaryChunkIndex& chunk) { return isValidChunk(chunk.offset, chunk.nStates); })) {
+            chunks.clear();
+        }
+    }
+    if (chunks.empty()) {
+        // the simulation was interrupted, hence the chunks are found by their headers
+        uint64_t offset = binaryDataOffset(header);
+        for (uint64_t c = 0; c < header.nChunks && offset + sizeof(BinaryChunkHeader) <= fileSize; ++c) {
+            BinaryChunkHeader chunkHeader;
+            std::memcpy(&chunkHeader, data + offset, sizeof(BinaryChunkHeader));
+            if (!isValidChunk(offset, chunkHeader.nStates)) {
+                break;
+            }
+            const T* times = reinterpret_cast<const T*>(data + offset + sizeof(BinaryChunkHeader));
+            chunks.push_back({ offset, chunkHeader.firstState, chunkHeader.nStates, static_cast<double>(times[0]), static_cast<double>(times[chunkHeader.nStates - 1]) });
+            offset += chunkHeader.size;
+        }
+    }
+    for (auto& chunk : chunks) {
+        nStates += chunk.nStates;
+    }
+}
+
+template<typename T>
+const T* BinaryResultReader<T>::getColumn(size_t chunk, size_t column) const {
+    const T* values = reinterpret_cast<const T*>(data + chunks.at(chunk).offset + sizeof(BinaryChunkHeader));
+    return values + column * chunks[chunk].nStates;
+}
+
+template<typename T>
+BinaryResultReader<T>::BinaryResultReader(std::string file) : path(std::move(file)) {
+    if (!isLittleEndian()) {
+        throw std::invalid_argument("Binary result files can only be read on little-endian hosts.");
+    }
+    map();
+    if (fileSize < sizeof(BinaryHeader)) {
+        unmap();
+        throw std::invalid_argument("The file " + path + " is no binary result file.");
+    }
+    std::memcpy(&header, data, sizeof(BinaryHeader));
+    if (std::memcmp(header.magic, binaryResultMagic, sizeof(header.magic)) != 0 || header.version != binaryResultVersion
+        || binaryDataOffset(header) > fileSize) {
+        unmap();
+        throw std::invalid_argument("The file " + path + " is no binary result file.");
+    }
+    if (header.valueSize != sizeof(T)) {
+        unmap();
+        throw std::invalid_argument("The values of the binary result file " + path + " have a width of " + std::to_string(header.valueSize) + " bytes.");
+    }
+
+    const char* position = data + sizeof(BinaryHeader);
+    std::vector<int> nodeIds;
+    std::vector<int> edgeIds;
+    for (uint64_t i = 0; i < header.nNodes; ++i) {
+        nodeIds.push_back(readBinary<int32_t>(position, data + fileSize));
+    }
+    for (uint64_t i = 0; i < header.nEdges; ++i) {
+        edgeIds.push_back(readBinary<int32_t>(position, data + fileSize));
+    }
+    nodeLayout = std::make_unique<result::ColumnLayout>(std::move(nodeIds));
+    edgeLayout = std::make_unique<result::ColumnLayout>(std::move(edgeIds));
+
+    readChunkIndex();
+}
+
+template<typename T>
+BinaryResultReader<T>::~BinaryResultReader() {
+    unmap();
+}
+
+template<typename T>
+bool BinaryResultReader<T>::isComplete() const {
+    return header.indexOffset != 0 && header.fluidsOffset != 0;
+}
+
+template<typename T>
+int BinaryResultReader<T>::getFixtureId() const {
+    return header.fixtureId;
+}
+
+template<typename T>
+std::string BinaryResultReader<T>::getType() const {
+    return std::string(header.type, strnlen(header.type, sizeof(header.type)));
+}
+
+template<typename T>
+std::string BinaryResultReader<T>::getPlatform() const {
+    return std::string(header.platform, strnlen(header.platform, sizeof(header.platform)));
+}
+
+template<typename T>
+const std::vector<int>& BinaryResultReader<T>::getNodeIds() const {
+    return nodeLayout->ids;
+}
+
+template<typename T>
+const std::vector<int>& BinaryResultReader<T>::getEdgeIds() const {
+    return edgeLayout->ids;
+}
+
+template<typename T>
+size_t BinaryResultReader<T>::getNumberOfStates() const {
+    return nStates;
+}
+
+template<typename T>
+size_t BinaryResultReader<T>::getNumberOfChunks() const {
+    return chunks.size();
+}
+
+template<typename T>
+const BinaryChunkIndex& BinaryResultReader<T>::getChunk(size_t chunk) const {
+    return chunks.at(chunk);
+}
+
+template<typename T>
+std::pair<size_t, size_t> BinaryResultReader<T>::findChunks(T startTime, T endTime) const {
+    // the states are ordered by their times
+    auto first = std::partition_point(chunks.begin(), chunks.end(), [startTime](const BinaryChunkIndex& chunk) { return chunk.endTime < startTime; });
+    auto last = std::partition_point(first, chunks.end(), [endTime](const BinaryChunkIndex& chunk) { return chunk.startTime <= endTime; });
+    return { static_cast<size_t>(first - chunks.begin()), static_cast<size_t>(last - chunks.begin()) };
+}
+
+template<typename T>
+ValueSpan<T> BinaryResultReader<T>::getTimes(size_t chunk) const {
+    return ValueSpan<T>(getColumn(chunk, 0), chunks.at(chunk).nStates);
+}
+
+template<typename T>
+ValueSpan<T> BinaryResultReader<T>::getPressures(size_t chunk, int nodeId) const {
+    auto index = nodeLayout->indices.find(nodeId);
+    if (index == nodeLayout->indices.end()) {
+        throw std::out_of_range("Node " + std::to_string(nodeId) + " is not part of the binary result.");
+    }
+    return ValueSpan<T>(getColumn(chunk, 1 + index->second), chunks.at(chunk).nStates);
+}
+
+template<typename T>
+ValueSpan<T> BinaryResultReader<T>::getFlowRates(size_t chunk, int edgeId) const {
+    auto index = edgeLayout->indices.find(edgeId);
+    if (index == edgeLayout->indices.end()) {
+        throw std::out_of_range("Edge " + std::to_string(edgeId) + " is not part of the binary result.");
+    }
+    return ValueSpan<T>(getColumn(chunk, 1 + header.nNodes + index->second), chunks.at(chunk).nStates);
+}
+
+template<typename T>
+std::vector<std::vector<BinaryDroplet<T>>> BinaryResultReader<T>::readDroplets(size_t chunk) const {
+    const uint64_t nChunkStates = chunks.at(chunk).nStates;
+    const char* fileEnd = data + fileSize;
+    const char* chunkBegin = data + chunks[chunk].offset;
+    checkBinary(chunkBegin, fileEnd, sizeof(BinaryChunkHeader));
+    BinaryChunkHeader chunkHeader;
+    std::memcpy(&chunkHeader, chunkBegin, sizeof(BinaryChunkHeader));
+
+    // the droplet positions follow the columns and must lie inside the chunk and the file
+    const uint64_t valueBytes = sizeof(T) * nChunkStates * (1 + header.nNodes + header.nEdges);
+    checkBinary(chunkBegin, fileEnd, chunkHeader.size);
+    checkBinary(chunkBegin, chunkBegin + chunkHeader.size, sizeof(BinaryChunkHeader) + valueBytes);
+    const char* position = chunkBegin + sizeof(BinaryChunkHeader) + valueBytes;
+    checkBinary(position, chunkBegin + chunkHeader.size, chunkHeader.dropletBytes);
+    const char* end = position + chunkHeader.dropletBytes;
+
+    // the counts are checked against the remaining bytes before the droplets are allocated
+    const uint64_t dropletBytes = 2 * sizeof(int32_t) + sizeof(T) + 2 * sizeof(uint32_t);
+    const uint64_t boundaryBytes = sizeof(int32_t) + sizeof(T) + 2 * sizeof(uint8_t);
+    std::vector<std::vector<BinaryDroplet<T>>> states(nChunkStates);
+    for (auto& droplets : states) {
+        const uint32_t nDroplets = readBinary<uint32_t>(position, end);
+        checkBinary(position, end, nDroplets * dropletBytes);
+        droplets.resize(nDroplets);
+        for (auto& droplet : droplets) {
+            droplet.id = readBinary<int32_t>(position, end);
+            droplet.fluidId = readBinary<int32_t>(position, end);
+            droplet.volume = readBinary<T>(position, end);
+            const uint32_t nBoundaries = readBinary<uint32_t>(position, end);
+            const uint32_t nChannels = readBinary<uint32_t>(position, end);
+            checkBinary(position, end, nBoundaries * boundaryBytes + nChannels * sizeof(int32_t));
+            droplet.boundaries.resize(nBoundaries);
+            droplet.channelIds.resize(nChannels);
+            for (auto& boundary : droplet.boundaries) {
+                boundary.channelId = readBinary<int32_t>(position, end);
+                boundary.position = readBinary<T>(position, end);
+                boundary.volumeTowardsNodeA = readBinary<uint8_t>(position, end) != 0;
+                boundary.state = readBinary<uint8_t>(position, end);
+            }
+            for (auto& channelId : droplet.channelIds) {
+                channelId = readBinary<int32_t>(position, end);
+            }
+        }
+    }
+    return states;
+}
+
+template<typename T>
+std::vector<BinaryFluid> BinaryResultReader<T>::readFluids() const {
+    std::vector<BinaryFluid> fluids;
+    if (header.fluidsOffset == 0) {
+        return fluids;
+    }
+    const char* end = data + fileSize;
+    checkBinary(data, end, header.fluidsOffset);
+    const char* position = data + header.fluidsOffset;
+
+    // the number of fluids is checked against the remaining bytes before the fluids are allocated
+    const uint64_t nFluids = readBinary<uint64_t>(position, end);
+    const uint64_t fluidBytes = sizeof(int32_t) + sizeof(uint32_t) + 3 * sizeof(double);
+    if (nFluids > static_cast<uint64_t>(end - position) / fluidBytes) {
+        throw std::invalid_argument("The binary result file is truncated or corrupted.");
+    }
+    fluids.resize(nFluids);
+    for (auto& fluid : fluids) {
+        fluid.id = readBinary<int32_t>(position, end);
+        const uint32_t nameLength = readBinary<uint32_t>(position, end);
+        checkBinary(position, end, nameLength);
+        fluid.name = std::string(position, nameLength);
+        position += nameLength;
+        fluid.concentration = readBinary<double>(position, end);
+        fluid.density = readBinary<double>(position, end);
+        fluid.viscosity = readBinary<double>(position, end);
+    }
+    return fluids;
+}
+
+template<typename T>
+nlohmann::ordered_json binaryResultToJSON(std::string binaryFile) {
+    BinaryResultReader<T> reader(binaryFile);
+    const bool writeDroplets = reader.getPlatform() == "BigDroplet" && reader.getType() == "Abstract";
+
+    auto jsonResult = nlohmann::ordered_json::object();
+    auto jsonStates = nlohmann::ordered_json::array();
+
+    // the nodes and channels are written in the order of their ids, as in writePressures and writeFlowRates
+    auto& nodeIds = reader.getNodeIds();
+    auto& edgeIds = reader.getEdgeIds();
+    const bool writeNodeIds = !nodeIds.empty() && nodeIds.back() != static_cast<int>(nodeIds.size()) - 1;
+    const bool writeEdgeIds = !edgeIds.empty() && edgeIds.back() != static_cast<int>(edgeIds.size()) - 1;
+
+    for (size_t chunk = 0; chunk < reader.getNumberOfChunks(); ++chunk) {
+        auto times = reader.getTimes(chunk);
+        std::vector<ValueSpan<T>> pressures;
+        std::vector<ValueSpan<T>> flowRates;
+        for (int nodeId : nodeIds) {
+            pressures.push_back(reader.getPressures(chunk, nodeId));
+        }
+        for (int edgeId : edgeIds) {
+            flowRates.push_back(reader.getFlowRates(chunk, edgeId));
+        }
+        std::vector<std::vector<BinaryDroplet<T>>> droplets;
+        if (writeDroplets) {
+            droplets = reader.readDroplets(chunk);
+        }
+
+        for (size_t s = 0; s < times.size(); ++s) {
+            auto jsonState = nlohmann::ordered_json::object();
+            jsonState["time"] = times[s];
+            jsonState["nodes"] = nlohmann::ordered_json::array();
+            for (size_t i = 0; i < pressures.size(); ++i) {
+                if (writeNodeIds) {
+                    jsonState["nodes"].push_back({{"id", nodeIds[i]}, {"pressure", pressures[i][s]}});
+                } else {
+                    jsonState["nodes"].push_back({{"pressure", pressures[i][s]}});
+                }
+            }
+            jsonState["channels"] = nlohmann::ordered_json::array();
+            for (size_t i = 0; i < flowRates.size(); ++i) {
+                if (writeEdgeIds) {
+                    jsonState["channels"].push_back({{"id", edgeIds[i]}, {"flowRate", flowRates[i][s]}});
+                } else {
+                    jsonState["channels"].push_back({{"flowRate", flowRates[i][s]}});
+                }
+            }
+            if (writeDroplets) {
+                auto BigDroplets = nlohmann::ordered_json::array();
+                for (auto& droplet : droplets[s]) {
+                    auto BigDroplet = nlohmann::ordered_json::object();
+                    BigDroplet["id"] = droplet.id;
+                    BigDroplet["fluid"] = droplet.fluidId;
+                    BigDroplet["volume"] = droplet.volume;
+                    BigDroplet["boundaries"] = nlohmann::ordered_json::array();
+                    for (auto& boundary : droplet.boundaries) {
+                        BigDroplet["boundaries"].push_back({
+                            {"volumeTowards1", boundary.volumeTowardsNodeA},
+                            {"position", {
+                                {"channel", boundary.channelId},
+                                {"position", boundary.position}}
+                            }
+                        });
+                    }
+                    BigDroplet["channels"] = nlohmann::ordered_json::array();
+                    for (auto channelId : droplet.channelIds) {
+                        BigDroplet["channels"].push_back(channelId);
+                    }
+                    BigDroplets.push_back(BigDroplet);
+                }
+                jsonState["bigDroplets"] = BigDroplets;
+            }
+            jsonStates.push_back(jsonState);
+        }
+    }
+
+    auto jsonFluids = nlohmann::ordered_json::array();
+    for (auto& fluid : reader.readFluids()) {
+        auto Fluid = nlohmann::ordered_json::object();
+        Fluid["id"] = fluid.id;
+        Fluid["name"] = fluid.name;
+        Fluid["concentration"] = fluid.concentration;
+        Fluid["density"] = fluid.density;
+        Fluid["viscosity"] = fluid.viscosity;
+        jsonFluids.push_back(Fluid);
+    }
+
+    jsonResult["fixture"] = reader.getFixtureId();
+    jsonResult["type"] = reader.getType();
+    jsonResult["platform"] = reader.getPlatform();
+    jsonResult["fluids"] = jsonFluids;
+    jsonResult.push_back({"network", jsonStates});
+
+    return jsonResult;
+}
+
+template<typename T>
+void binaryResultToJSON(std::string binaryFile, std::string jsonFile) {
+    std::ofstream file(jsonFile);
+
+    nlohmann::ordered_json jsonString = binaryResultToJSON<T>(binaryFile);
+
+    file << jsonString.dump(4) << std::endl;
+}
+
+}   // namespace porting
@@ -0,0 +1,117 @@
+/**
+ * @file binaryResultSink.h
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "binaryResult.h"
+
+namespace sim {
+
+// Forward declared dependencies
+template<typename T>
+class DropletPosition;
+
+template<typename T>
+class Simulation;
+
+}   // namespace sim
+
+namespace result {
+
+// Forward declared dependencies
+template<typename T>
+class ResultSink;
+
+}   // namespace result
+
+namespace porting {
+
+/**
+ * @brief Result sink that writes the states of a simulation into a binary result file (see binaryResult.h), as they are produced.
+ * The states are buffered in the column order of a chunk and each full chunk is appended to the file, hence at most one chunk
+ * of states is kept in memory. The chunk index and the fluids are written when the simulation finished. If the simulation is
+ * interrupted, the file contains all states of the completed chunks.
+ */
+template<typename T>
+class BinaryResultSink : public result::ResultSink<T> {
+  private:
+    std::string path;                               ///< Location of the binary result file.
+    std::ofstream file;                             ///< The binary result file.
+    sim::Simulation<T>* simulation;                 ///< Simulation of the states.
+    size_t chunkStates;                             ///< Number of states per chunk.
+    BinaryHeader header;                            ///< Header of the file.
+    std::vector<int> nodeIds;                       ///< Ids of the nodes in the order of the pressure columns.
+    std::vector<int> edgeIds;                       ///< Ids of the edges in the order of the flow rate columns.
+    bool layout = false;                            ///< If the layout was defined.
+    std::vector<T> times;                           ///< Times of the buffered states.
+    std::vector<T> pressures;                       ///< Pressures of the buffered states, one column of chunkStates values per node.
+    std::vector<T> flowRates;                       ///< Flow rates of the buffered states, one column of chunkStates values per edge.
+    std::vector<char> droplets;                     ///< Droplet positions of the buffered states.
+    std::vector<BinaryChunkIndex> chunks;           ///< Index of the written chunks.
+    uint64_t dataEnd = 0;                           ///< Position in the file after the last chunk.
+
+    /**
+     * @brief Write the header at the beginning of the file.
+     */
+    void writeHeader();
+
+    /**
+     * @brief Append the buffered states as chunk to the file and update the header.
+     */
+    void writeChunk();
+
+  public:
+    /**
+     * @brief Constructs a sink and creates (or truncates) the binary result file.
+     * @param[in] path Location of the binary result file.
+     * @param[in] simulation Simulation of the states.
+     * @param[in] chunkStates Number of states per chunk.
+     */
+    BinaryResultSink(std::string path, sim::Simulation<T>* simulation, size_t chunkStates = 1024);
+
+    /**
+     * @brief Completes the file.
+     */
+    ~BinaryResultSink();
+
+    /**
+     * @brief Define the order of the nodes and edges and write the beginning of the file, as long as no state was written.
+     * @param[in] nodeIds Ids of the nodes.
+     * @param[in] edgeIds Ids of the edges (channels and pumps).
+     */
+    void setLayout(std::vector<int> nodeIds, std::vector<int> edgeIds) override;
+
+    bool hasLayout() const override;
+
+    /**
+     * @brief Add a state to the current chunk, which is written once it is full.
+     * @param[in] time Time of the state in s.
+     * @param[in] pressures Pressures at the nodes in the order of the layout in Pa.
+     * @param[in] flowRates Flow rates of the edges in the order of the layout in m^3/s.
+     * @param[in] dropletPositions Positions of the droplets inside the network.
+     */
+    void addState(T time, const std::vector<T>& pressures, const std::vector<T>& flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions) override;
+
+    /**
+     * @brief Write the buffered states, the chunk index and the fluids. Further states overwrite the chunk index and the fluids,
+     * which are written again by the next call.
+     */
+    void finish() override;
+
+    /**
+     * @brief Get the number of added states, including the buffered states.
+     * @return Number of states.
+     */
+    size_t getNumberOfStates() const;
+};
+
+}   // namespace porting
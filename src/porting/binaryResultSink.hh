@@ -0,0 +1,196 @@
+#include "binaryResultSink.h"
+
+namespace porting {
+
+template<typename T>
+BinaryResultSink<T>::BinaryResultSink(std::string path_, sim::Simulation<T>* simulation_, size_t chunkStates_) :
+    path(std::move(path_)), simulation(simulation_), chunkStates(chunkStates_) {
+    if (!isLittleEndian()) {
+        throw std::invalid_argument("Binary result files can only be written on little-endian hosts.");
+    }
+    if (chunkStates < 1) {
+        throw std::invalid_argument("A chunk of the binary result must contain at least one state.");
+    }
+    file.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) {
+        throw std::invalid_argument("The result file " + path + " cannot be opened.");
+    }
+    std::memset(&header, 0, sizeof(BinaryHeader));
+    std::memcpy(header.magic, binaryResultMagic, sizeof(header.magic));
+    header.version = binaryResultVersion;
+    header.valueSize = sizeof(T);
+}
+
+template<typename T>
+BinaryResultSink<T>::~BinaryResultSink() {
+    if (layout) {
+        finish();
+    }
+}
+
+template<typename T>
+void BinaryResultSink<T>::writeHeader() {
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+}
+
+template<typename T>
+void BinaryResultSink<T>::writeChunk() {
+    const uint64_t nStates = times.size();
+    if (nStates == 0) {
+        return;
+    }
+    const uint64_t valueBytes = sizeof(T) * nStates * (1 + nodeIds.size() + edgeIds.size());
+    BinaryChunkHeader chunkHeader;
+    chunkHeader.firstState = header.nStates;
+    chunkHeader.nStates = nStates;
+    chunkHeader.dropletBytes = droplets.size();
+    chunkHeader.size = alignBinary(sizeof(BinaryChunkHeader) + valueBytes + droplets.size());
+
+    // the columns of the chunk only contain the buffered states
+    file.seekp(dataEnd);
+    file.write(reinterpret_cast<const char*>(&chunkHeader), sizeof(BinaryChunkHeader));
+    file.write(reinterpret_cast<const char*>(times.data()), sizeof(T) * nStates);
+    for (size_t i = 0; i < nodeIds.size(); ++i) {
+        file.write(reinterpret_cast<const char*>(pressures.data() + i * chunkStates), sizeof(T) * nStates);
+    }
+    for (size_t i = 0; i < edgeIds.size(); ++i) {
+        file.write(reinterpret_cast<const char*>(flowRates.data() + i * chunkStates), sizeof(T) * nStates);
+    }
+    file.write(droplets.data(), droplets.size());
+    const char padding[8] = { 0 };
+    file.write(padding, chunkHeader.size - sizeof(BinaryChunkHeader) - valueBytes - droplets.size());
+
+    chunks.push_back({ dataEnd, header.nStates, nStates, static_cast<double>(times.front()), static_cast<double>(times.back()) });
+    dataEnd += chunkHeader.size;
+    times.clear();
+    droplets.clear();
+
+    // the header only refers to completely written chunks
+    header.nStates += nStates;
+    header.nChunks = chunks.size();
+    header.indexOffset = 0;
+    header.fluidsOffset = 0;
+    file.flush();
+    writeHeader();
+    file.flush();
+}
+
+template<typename T>
+void BinaryResultSink<T>::setLayout(std::vector<int> nodeIds_, std::vector<int> edgeIds_) {
+    if (layout && nodeIds_ == nodeIds && edgeIds_ == edgeIds) {
+        return;
+    }
+    if (getNumberOfStates() > 0) {
+        throw std::invalid_argument("The nodes and edges of the stored states cannot change during a simulation.");
+    }
+    nodeIds = std::move(nodeIds_);
+    edgeIds = std::move(edgeIds_);
+    layout = true;
+    pressures.resize(chunkStates * nodeIds.size());
+    flowRates.resize(chunkStates * edgeIds.size());
+
+    // the simulation is defined once the first state is saved
+    header.fixtureId = simulation->getFixtureId();
+    std::memset(header.type, 0, sizeof(header.type));
+    std::memset(header.platform, 0, sizeof(header.platform));
+    std::string type = writeSimType(simulation);
+    std::string platform = writeSimPlatform(simulation);
+    std::memcpy(header.type, type.data(), std::min(type.size(), sizeof(header.type) - 1));
+    std::memcpy(header.platform, platform.data(), std::min(platform.size(), sizeof(header.platform) - 1));
+    header.nNodes = nodeIds.size();
+    header.nEdges = edgeIds.size();
+    writeHeader();
+
+    std::vector<char> ids;
+    for (int id : nodeIds) {
+        appendBinary<int32_t>(ids, id);
+    }
+    for (int id : edgeIds) {
+        appendBinary<int32_t>(ids, id);
+    }
+    ids.resize(binaryDataOffset(header) - sizeof(BinaryHeader), 0);
+    file.write(ids.data(), ids.size());
+    file.flush();
+    dataEnd = binaryDataOffset(header);
+}
+
+template<typename T>
+bool BinaryResultSink<T>::hasLayout() const {
+    return layout;
+}
+
+template<typename T>
+void BinaryResultSink<T>::addState(T time, const std::vector<T>& pressures_, const std::vector<T>& flowRates_, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions) {
+    const size_t state = times.size();
+    times.push_back(time);
+    for (size_t i = 0; i < nodeIds.size(); ++i) {
+        pressures[i * chunkStates + state] = pressures_[i];
+    }
+    for (size_t i = 0; i < edgeIds.size(); ++i) {
+        flowRates[i * chunkStates + state] = flowRates_[i];
+    }
+
+    appendBinary<uint32_t>(droplets, dropletPositions.size());
+    for (auto& [id, dropletPosition] : dropletPositions) {
+        auto droplet = simulation->getDroplet(id);
+        appendBinary<int32_t>(droplets, id);
+        appendBinary<int32_t>(droplets, droplet->getFluid()->getId());
+        appendBinary<T>(droplets, droplet->getVolume());
+        appendBinary<uint32_t>(droplets, dropletPosition.boundaries.size());
+        appendBinary<uint32_t>(droplets, dropletPosition.channelIds.size());
+        for (auto& boundary : dropletPosition.boundaries) {
+            appendBinary<int32_t>(droplets, boundary.getChannelPosition().getChannel()->getId());
+            appendBinary<T>(droplets, boundary.getChannelPosition().getPosition());
+            appendBinary<uint8_t>(droplets, boundary.isVolumeTowardsNodeA());
+            appendBinary<uint8_t>(droplets, static_cast<uint8_t>(boundary.getState()));
+        }
+        for (int channelId : dropletPosition.channelIds) {
+            appendBinary<int32_t>(droplets, channelId);
+        }
+    }
+
+    if (times.size() == chunkStates) {
+        writeChunk();
+    }
+}
+
+template<typename T>
+void BinaryResultSink<T>::finish() {
+    if (!layout) {
+        return;
+    }
+    writeChunk();
+
+    // chunk index and fluids after the last chunk
+    file.seekp(dataEnd);
+    file.write(reinterpret_cast<const char*>(chunks.data()), sizeof(BinaryChunkIndex) * chunks.size());
+
+    std::vector<char> fluids;
+    auto const& simFluids = simulation->getFluids();
+    appendBinary<uint64_t>(fluids, simFluids.size());
+    for (size_t i = 0; i < simFluids.size(); ++i) {
+        auto& fluid = simFluids.at(i);
+        std::string name = fluid->getName();
+        appendBinary<int32_t>(fluids, fluid->getId());
+        appendBinary<uint32_t>(fluids, name.size());
+        fluids.insert(fluids.end(), name.begin(), name.end());
+        appendBinary<double>(fluids, fluid->getConcentration());
+        appendBinary<double>(fluids, fluid->getDensity());
+        appendBinary<double>(fluids, fluid->getViscosity());
+    }
+    file.write(fluids.data(), fluids.size());
+
+    header.indexOffset = dataEnd;
+    header.fluidsOffset = dataEnd + sizeof(BinaryChunkIndex) * chunks.size();
+    file.flush();
+    writeHeader();
+    file.flush();
+}
+
+template<typename T>
+size_t BinaryResultSink<T>::getNumberOfStates() const {
+    return header.nStates + times.size();
+}
+
+}   // namespace porting
@@ -83,6 +83,7 @@ void simulationFromJSON(std::string jsonFile, arch::Network<T>* network_, sim::S
     if (simType == sim::Type::Hybrid) {
         readSimulators<T>(jsonString, network_);
         network_->sortGroups();
+        readCouplingAccelerator<T>(jsonString, simulation);
     }
 
     if (simType == sim::Type::CFD) {
@@ -94,6 +95,7 @@ void simulationFromJSON(std::string jsonFile, arch::Network<T>* network_, sim::S
     readContinuousPhase<T>(jsonString, simulation, activeFixture);
     readPumps<T>(jsonString, network_);
     readResistanceModel<T>(jsonString, simulation);
+    readRecording<T>(jsonString, simulation);
 }
 
 template<typename T>
@@ -131,6 +133,7 @@ sim::Simulation<T> simulationFromJSON(json jsonString, arch::Network<T>* network
     if (simType == sim::Type::Hybrid) {
         readSimulators<T>(jsonString, network_);
         network_->sortGroups();
+        readCouplingAccelerator<T>(jsonString, simulation);
     }
 
     if (simType == sim::Type::CFD) {
@@ -142,6 +145,7 @@ sim::Simulation<T> simulationFromJSON(json jsonString, arch::Network<T>* network
     readContinuousPhase<T>(jsonString, simulation, activeFixture);
     readPumps<T>(jsonString, network_);
     readResistanceModel<T>(jsonString, simulation);
+    readRecording<T>(jsonString, simulation);
 
     return simulation;
 }
@@ -161,15 +165,27 @@ nlohmann::ordered_json resultToJSON(sim::Simulation<T>* simulation) {
     auto jsonResult = ordered_json::object();
     auto jsonStates = ordered_json::array();
 
-    for (auto const& state : simulation->getSimulationResults()->getStates()) {
+    auto writeState = [&](result::State<T>* state) {
         auto jsonState = ordered_json::object();
         jsonState["time"] = state->getTime();
-        jsonState["nodes"] = writePressures(state.get());
-        jsonState["channels"] = writeFlowRates(state.get());
+        jsonState["nodes"] = writePressures(state);
+        jsonState["channels"] = writeFlowRates(state);
         if (simulation->getPlatform() == sim::Platform::BigDroplet && simulation->getType() == sim::Type::Abstract) {
-            jsonState["bigDroplets"] = writeDroplets(state.get(), simulation);
+            jsonState["bigDroplets"] = writeDroplets(state, simulation);
         }
         jsonStates.push_back(jsonState);
+    };
+
+    // delta-encoded states are reconstructed one after another
+    auto results = simulation->getSimulationResults();
+    if (results->getDeltaHistory() != nullptr) {
+        for (size_t key = 0; key < results->getNumberOfStates(); ++key) {
+            writeState(results->getState(key).get());
+        }
+    } else {
+        for (auto const& state : results->getStates()) {
+            writeState(state.get());
+        }
     }
 
     jsonResult["fixture"] = simulation->getFixtureId();
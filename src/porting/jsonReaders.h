@@ -86,7 +86,7 @@ template<typename T>
 void readDroplets (json jsonString, sim::Simulation<T>& simulation);
 
 /**
- * @brief Construct and store the droplet injections in the simulation as defined by the json string
+ * @brief Construct and store the droplet injections and droplet generators in the simulation as defined by the json string
  * @param[in] jsonString json string
  * @param[in] simulation simulation object
  * @param[in] activeFixture active fixture
@@ -121,6 +121,14 @@ void readContinuousPhase (json jsonString, sim::Simulation<T>& simulation, int a
 template<typename T>
 void readSimulators (json jsonString, arch::Network<T>* network);
 
+/**
+ * @brief Set the method that accelerates the coupling between the 1D and CFD solvers as defined by the json string
+ * @param[in] jsonString json string
+ * @param[in] simulation simulation object
+*/
+template<typename T>
+void readCouplingAccelerator (json jsonString, sim::Simulation<T>& simulation);
+
 /**
  * @brief Sets channels in the network to pressure or flow rate pump, as defined by the json string
  * @param[in] jsonString json string
@@ -138,6 +146,14 @@ void readPumps (json jsonString, arch::Network<T>* network);
 template<typename T>
 void readResistanceModel (json jsonString, sim::Simulation<T>& simulation);
 
+/**
+ * @brief Set which states, nodes and channels of the simulation are saved as defined by the json string
+ * @param[in] jsonString json string
+ * @param[in] simulation simulation object
+*/
+template<typename T>
+void readRecording (json jsonString, sim::Simulation<T>& simulation);
+
 /**
  * @brief Returns the id of the active fixture as defined in the json string
  * @returns The id of the active fixture
@@ -98,8 +98,12 @@ void readDroplets(json jsonString, sim::Simulation<T>& simulation) {
 
 template<typename T>
 void readDropletInjections(json jsonString, sim::Simulation<T>& simulation, int activeFixture) {
-    if (jsonString["simulation"]["fixtures"][activeFixture].contains("bigDropletInjections")) {
-        for (auto& injection : jsonString["simulation"]["fixtures"][activeFixture]["bigDropletInjections"]) {
+    auto& fixture = jsonString["simulation"]["fixtures"][activeFixture];
+    if (!fixture.contains("bigDropletInjections") && !fixture.contains("bigDropletGenerators")) {
+        throw std::invalid_argument("Please define at least one droplet injection or choose a different platform.");
+    }
+    if (fixture.contains("bigDropletInjections")) {
+        for (auto& injection : fixture["bigDropletInjections"]) {
             int fluid = injection["fluid"];
             T volume = injection["volume"];
             auto newDroplet = simulation.addDroplet(fluid, volume);
@@ -109,8 +113,19 @@ void readDropletInjections(json jsonString, sim::Simulation<T>& simulation, int
             T injectionPosition = injection["pos"];
             simulation.addDropletInjection(newDroplet->getId(), injectionTime, channelId, injectionPosition);
         }
-    } else {
-        throw std::invalid_argument("Please define at least one droplet injection or choose a different platform.");
+    }
+    if (fixture.contains("bigDropletGenerators")) {
+        for (auto& generator : fixture["bigDropletGenerators"]) {
+            int fluid = generator["fluid"];
+            T volume = generator["volume"];
+            int channelId = generator["channel"];
+            T injectionPosition = generator["pos"];
+            T startTime = generator["t0"];
+            T period = generator["period"];
+            int count = generator.contains("count") ? int(generator["count"]) : -1;
+            T endTime = generator.contains("tEnd") ? T(generator["tEnd"]) : -1.0;
+            simulation.addDropletGenerator(fluid, volume, channelId, injectionPosition, startTime, period, count, endTime);
+        }
     }
 }
 
@@ -148,7 +163,50 @@ void readSimulators(json jsonString, arch::Network<T>* network) {
             auto mod = network->addModule(name, stlFile, position, size, Nodes, Openings, charPhysLength, charPhysVelocity,
                                 alpha, resolution, epsilon, tau);
             mod->setVtkFolder(vtkFolder);
+            if (module.contains("theta")) {
+                mod->setTheta(module["theta"]);
+            }
+            if (module.contains("vtkOutput")) {
+                int vtkInterval = module.contains("vtkInterval") ? module["vtkInterval"].get<int>() : 1000;
+                if (module["vtkOutput"] == "Disabled") {
+                    mod->setVtkOutput(arch::VtkOutput::Disabled, vtkInterval);
+                } else if (module["vtkOutput"] == "Interval") {
+                    mod->setVtkOutput(arch::VtkOutput::Interval, vtkInterval);
+                } else if (module["vtkOutput"] == "Final") {
+                    mod->setVtkOutput(arch::VtkOutput::Final, vtkInterval);
+                } else {
+                    throw std::invalid_argument("Invalid vtk output. The following outputs are possible:\nDisabled\nInterval\nFinal");
+                }
+            }
+            if (module.contains("traceInterval")) {
+                mod->setTraceInterval(module["traceInterval"]);
+            }
+            if (module.contains("adaptiveTheta")) {
+                int minTheta = module.contains("minTheta") ? module["minTheta"].get<int>() : 1;
+                int maxTheta = module.contains("maxTheta") ? module["maxTheta"].get<int>() : 1000;
+                T thetaTolerance = module.contains("thetaTolerance") ? module["thetaTolerance"].get<T>() : 1e-3;
+                mod->setAdaptiveTheta(module["adaptiveTheta"], minTheta, maxTheta, thetaTolerance);
+            }
+        }
+}
+
+template<typename T>
+void readCouplingAccelerator(json jsonString, sim::Simulation<T>& simulation) {
+    if (jsonString["simulation"]["settings"].contains("couplingAccelerator")) {
+        int andersonDepth = 5;
+        if (jsonString["simulation"]["settings"].contains("andersonDepth")) {
+            andersonDepth = jsonString["simulation"]["settings"]["andersonDepth"];
         }
+        if (jsonString["simulation"]["settings"]["couplingAccelerator"] == "Constant") {
+            simulation.setCouplingAccelerator(nodal::AcceleratorType::Constant, andersonDepth);
+        } else if (jsonString["simulation"]["settings"]["couplingAccelerator"] == "Aitken") {
+            simulation.setCouplingAccelerator(nodal::AcceleratorType::Aitken, andersonDepth);
+        } else if (jsonString["simulation"]["settings"]["couplingAccelerator"] == "Anderson") {
+            simulation.setCouplingAccelerator(nodal::AcceleratorType::Anderson, andersonDepth);
+        } else {
+            throw std::invalid_argument("Invalid coupling accelerator. The following accelerators are possible:\nConstant\nAitken\nAnderson");
+        }
+    }
 }
 
 template<typename T>
@@ -215,6 +273,45 @@ void readResistanceModel(json jsonString, sim::Simulation<T>& simulation) {
     simulation.setResistanceModel(resistanceModel);
 }
 
+template<typename T>
+void readRecording(json jsonString, sim::Simulation<T>& simulation) {
+    if (!jsonString["simulation"].contains("recording")) {
+        return;
+    }
+    auto& recording = jsonString["simulation"]["recording"];
+    if (recording.contains("policy")) {
+        T interval = 1.0;
+        if (recording.contains("interval")) {
+            interval = recording["interval"];
+        }
+        if (recording["policy"] == "All") {
+            simulation.setRecordingPolicy(sim::RecordingPolicy::All, interval);
+        } else if (recording["policy"] == "EventInterval") {
+            simulation.setRecordingPolicy(sim::RecordingPolicy::EventInterval, interval);
+        } else if (recording["policy"] == "TimeInterval") {
+            simulation.setRecordingPolicy(sim::RecordingPolicy::TimeInterval, interval);
+        } else if (recording["policy"] == "Change") {
+            simulation.setRecordingPolicy(sim::RecordingPolicy::Change, interval);
+        } else {
+            throw std::invalid_argument("Invalid recording policy. The following policies are possible:\nAll\nEventInterval\nTimeInterval\nChange");
+        }
+    }
+    if (recording.contains("nodes")) {
+        simulation.setRecordedNodes(recording["nodes"].get<std::vector<int>>());
+    }
+    if (recording.contains("channels")) {
+        simulation.setRecordedChannels(recording["channels"].get<std::vector<int>>());
+    }
+    // either a list of the recorded droplets or a switch to save the positions of all or no droplets
+    if (recording.contains("droplets")) {
+        if (recording["droplets"].is_boolean()) {
+            simulation.setRecordDropletPositions(recording["droplets"].get<bool>());
+        } else {
+            simulation.setRecordedDroplets(recording["droplets"].get<std::vector<int>>());
+        }
+    }
+}
+
 template<typename T>
 int readActiveFixture(json jsonString) {
     unsigned int activeFixture = 0;
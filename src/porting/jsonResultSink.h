@@ -0,0 +1,114 @@
+/**
+ * @file jsonResultSink.h
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+namespace sim {
+
+// Forward declared dependencies
+template<typename T>
+class DropletPosition;
+
+template<typename T>
+class Simulation;
+
+}   // namespace sim
+
+namespace result {
+
+// Forward declared dependencies
+struct ColumnLayout;
+
+template<typename T>
+class ResultSink;
+
+}   // namespace result
+
+namespace porting {
+
+/**
+ * @brief Result sink that streams the states of a simulation into a JSON file, as they are produced. The file has the format of
+ * resultToJSON: each state is appended to the "network" array and the closing part of the file, which contains the fluids, is
+ * written after every tailStates states and when the simulation finished. Hence, the file is valid at these states, i.e., also if
+ * the simulation is interrupted afterwards, and an interrupted file misses at most the last tailStates - 1 states. Only the current
+ * state is kept in memory. The file is written in place, since the states are appended to it, hence it is not valid while the
+ * closing part is written.
+ */
+template<typename T>
+class JsonResultSink : public result::ResultSink<T> {
+  private:
+    std::string path;                                       ///< Location of the JSON file.
+    std::ofstream file;                                     ///< The JSON file.
+    sim::Simulation<T>* simulation;                         ///< Simulation of the states.
+    std::unique_ptr<result::ColumnLayout> nodeLayout;       ///< Order of the nodes of the pressures.
+    std::unique_ptr<result::ColumnLayout> edgeLayout;       ///< Order of the edges (channels and pumps) of the flow rates.
+    size_t tailStates;                                      ///< Number of states after which the closing part is written.
+    int nStates = 0;                                        ///< Number of written states.
+    size_t nFluids = 0;                                     ///< Number of fluids of the serialized fluids.
+    std::string fluids;                                     ///< Serialized fluids, which only change when fluids are added.
+    std::streamoff statesEnd = 0;                           ///< Position in the file after the last state.
+    std::streamoff fileEnd = 0;                             ///< Size of the file.
+
+    /**
+     * @brief Write the closing part of the file after the last state and flush the file. The fluids are only serialized again if
+     * fluids were added.
+     */
+    void writeTail();
+
+  public:
+    /**
+     * @brief Constructs a sink and creates (or truncates) the JSON file.
+     * @param[in] path Location of the JSON file.
+     * @param[in] simulation Simulation of the states.
+     * @param[in] tailStates Number of states after which the closing part is written, i.e., after which the file is valid.
+     */
+    JsonResultSink(std::string path, sim::Simulation<T>* simulation, size_t tailStates = 1);
+
+    /**
+     * @brief Completes the file.
+     */
+    ~JsonResultSink();
+
+    /**
+     * @brief Define the order of the nodes and edges and write the beginning of the file, as long as no state was written.
+     * @param[in] nodeIds Ids of the nodes.
+     * @param[in] edgeIds Ids of the edges (channels and pumps).
+     */
+    void setLayout(std::vector<int> nodeIds, std::vector<int> edgeIds) override;
+
+    bool hasLayout() const override;
+
+    /**
+     * @brief Append a state to the file and write the closing part after every tailStates states.
+     * @param[in] time Time of the state in s.
+     * @param[in] pressures Pressures at the nodes in the order of the layout in Pa.
+     * @param[in] flowRates Flow rates of the edges in the order of the layout in m^3/s.
+     * @param[in] dropletPositions Positions of the droplets inside the network.
+     */
+    void addState(T time, const std::vector<T>& pressures, const std::vector<T>& flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions) override;
+
+    /**
+     * @brief Write the closing part of the file after the last state. Further states overwrite it, which is written again by the
+     * next call.
+     */
+    void finish() override;
+
+    /**
+     * @brief Get the number of written states.
+     * @return Number of states.
+     */
+    int getNumberOfStates() const;
+};
+
+}   // namespace porting
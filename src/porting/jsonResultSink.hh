@@ -0,0 +1,105 @@
+#include "jsonResultSink.h"
+
+namespace porting {
+
+template<typename T>
+JsonResultSink<T>::JsonResultSink(std::string path_, sim::Simulation<T>* simulation_, size_t tailStates_) :
+    path(std::move(path_)), simulation(simulation_), tailStates(tailStates_) {
+    if (tailStates < 1) {
+        throw std::invalid_argument("The closing part of the result file must be written after at least every state.");
+    }
+    file.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) {
+        throw std::invalid_argument("The result file " + path + " cannot be opened.");
+    }
+}
+
+template<typename T>
+JsonResultSink<T>::~JsonResultSink() {
+    if (hasLayout()) {
+        finish();
+    }
+}
+
+template<typename T>
+void JsonResultSink<T>::writeTail() {
+    // the fluids are written last, since fluids are added during the simulation (e.g., when droplets merge)
+    if (fluids.empty() || simulation->getFluids().size() != nFluids) {
+        nFluids = simulation->getFluids().size();
+        fluids = writeFluids(simulation).dump();
+    }
+    file.seekp(statesEnd);
+    file << "\n],\n\"fluids\": " << fluids << "\n}\n";
+    file.flush();
+
+    // a shorter tail leaves the end of the previous tail behind
+    std::streamoff end = file.tellp();
+    if (end < fileEnd) {
+        std::filesystem::resize_file(path, end);
+    }
+    fileEnd = end;
+}
+
+template<typename T>
+void JsonResultSink<T>::setLayout(std::vector<int> nodeIds, std::vector<int> edgeIds) {
+    if (hasLayout() && nodeIds == nodeLayout->ids && edgeIds == edgeLayout->ids) {
+        return;
+    }
+    if (nStates > 0) {
+        throw std::invalid_argument("The nodes and edges of the stored states cannot change during a simulation.");
+    }
+    nodeLayout = std::make_unique<result::ColumnLayout>(std::move(nodeIds));
+    edgeLayout = std::make_unique<result::ColumnLayout>(std::move(edgeIds));
+
+    // the simulation is defined once the first state is saved
+    file.seekp(0);
+    file << "{\n\"fixture\": " << simulation->getFixtureId()
+         << ",\n\"type\": " << ordered_json(writeSimType(simulation)).dump()
+         << ",\n\"platform\": " << ordered_json(writeSimPlatform(simulation)).dump()
+         << ",\n\"network\": [";
+    statesEnd = file.tellp();
+    writeTail();
+}
+
+template<typename T>
+bool JsonResultSink<T>::hasLayout() const {
+    return nodeLayout != nullptr;
+}
+
+template<typename T>
+void JsonResultSink<T>::addState(T time, const std::vector<T>& pressures, const std::vector<T>& flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions) {
+    std::vector<T> values(pressures);
+    values.insert(values.end(), flowRates.begin(), flowRates.end());
+    result::State<T> state(nStates, time, nodeLayout.get(), edgeLayout.get(), std::move(values), std::move(dropletPositions));
+
+    auto jsonState = ordered_json::object();
+    jsonState["time"] = state.getTime();
+    jsonState["nodes"] = writePressures(&state);
+    jsonState["channels"] = writeFlowRates(&state);
+    if (simulation->getPlatform() == sim::Platform::BigDroplet && simulation->getType() == sim::Type::Abstract) {
+        jsonState["bigDroplets"] = writeDroplets(&state, simulation);
+    }
+
+    // the state overwrites the tail, which is written again after the state
+    file.seekp(statesEnd);
+    file << ((nStates > 0) ? ",\n" : "\n") << jsonState.dump();
+    statesEnd = file.tellp();
+    nStates++;
+    if (static_cast<size_t>(nStates) % tailStates == 0) {
+        writeTail();
+    }
+}
+
+template<typename T>
+void JsonResultSink<T>::finish() {
+    if (hasLayout()) {
+        writeTail();
+    }
+}
+
+template<typename T>
+int JsonResultSink<T>::getNumberOfStates() const {
+    return nStates;
+}
+
+}   // namespace porting
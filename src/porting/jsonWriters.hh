@@ -6,8 +6,14 @@ template<typename T>
 auto writePressures(result::State<T>* state) {
     auto nodes = ordered_json::array();
     auto const& pressures = state->getPressures();
-    for (long unsigned int i=0; i<pressures.size(); ++i) {
-        nodes.push_back({{"pressure", pressures.at(i)}});
+    // if only a subset of the nodes was recorded, the ids are written as well
+    bool writeIds = !pressures.empty() && pressures.ids().back() != static_cast<int>(pressures.size()) - 1;
+    for (auto const& [id, pressure] : pressures) {
+        if (writeIds) {
+            nodes.push_back({{"id", id}, {"pressure", pressure}});
+        } else {
+            nodes.push_back({{"pressure", pressure}});
+        }
     }
     return nodes;
 }
@@ -16,8 +22,14 @@ template<typename T>
 auto writeFlowRates(result::State<T>* state) {      
     auto channels = ordered_json::array();
     auto const& flowRates = state->getFlowRates();
-    for (long unsigned int i=0; i<flowRates.size(); ++i) {
-        channels.push_back({{"flowRate", flowRates.at(i)}});
+    // if only a subset of the channels was recorded, the ids are written as well
+    bool writeIds = !flowRates.empty() && flowRates.ids().back() != static_cast<int>(flowRates.size()) - 1;
+    for (auto const& [id, flowRate] : flowRates) {
+        if (writeIds) {
+            channels.push_back({{"id", id}, {"flowRate", flowRate}});
+        } else {
+            channels.push_back({{"flowRate", flowRate}});
+        }
     }
     return channels;
 }
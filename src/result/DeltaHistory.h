@@ -0,0 +1,196 @@
+/**
+ * @file DeltaHistory.h
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ResultStore.h"
+
+namespace sim {
+
+// Forward declared dependencies
+template<typename T>
+class DropletPosition;
+
+}
+
+namespace result {
+
+// Forward declared dependencies
+template<typename T>
+struct State;
+
+/**
+ * @brief Class that stores the states of a simulation as a delta-encoded history. Every keyframeInterval-th state is a keyframe that
+ * contains all pressures, flow rates and droplet positions. All other states only contain the values that changed with respect to
+ * the previous state, i.e., the pressures and flow rates whose relative change exceeds the tolerance, the droplets whose position
+ * changed and the droplets that left the network. Any state can be reconstructed from its keyframe and the following changes.
+ * The changes are compared against the recorded (reconstructed) values, so that the error of a reconstructed value never exceeds
+ * the tolerance, regardless of the number of changes since the keyframe.
+ */
+template<typename T>
+class DeltaHistory {
+  private:
+    std::unique_ptr<ColumnLayout> nodeLayout;                               ///< Order of the nodes of the pressures.
+    std::unique_ptr<ColumnLayout> edgeLayout;                               ///< Order of the edges (channels and pumps) of the flow rates.
+    int keyframeInterval;                                                   ///< Number of states per keyframe.
+    T tolerance;                                                            ///< Relative change of a value, above which it is stored (0.0 stores every change).
+    std::vector<T> times;                                                   ///< Time of each state.
+
+    std::vector<T> keyframePressures;                                       ///< Pressures of the keyframes, one row per keyframe in the order of the layout.
+    std::vector<T> keyframeFlowRates;                                       ///< Flow rates of the keyframes, one row per keyframe in the order of the layout.
+    std::vector<std::unordered_map<int, sim::DropletPosition<T>>> keyframeDroplets;    ///< Droplet positions of the keyframes.
+
+    std::vector<size_t> pressureOffsets;                                    ///< Index of the first changed pressure of each state (and the number of changes at the end).
+    std::vector<uint32_t> pressureIndices;                                  ///< Layout index of each changed pressure.
+    std::vector<T> pressureValues;                                          ///< Value of each changed pressure.
+    std::vector<size_t> flowRateOffsets;                                    ///< Index of the first changed flow rate of each state (and the number of changes at the end).
+    std::vector<uint32_t> flowRateIndices;                                  ///< Layout index of each changed flow rate.
+    std::vector<T> flowRateValues;                                          ///< Value of each changed flow rate.
+    std::vector<size_t> dropletOffsets;                                     ///< Index of the first changed droplet of each state (and the number of changes at the end).
+    std::vector<std::pair<int, sim::DropletPosition<T>>> dropletValues;     ///< Id and position of each changed droplet.
+    std::vector<size_t> removedOffsets;                                     ///< Index of the first removed droplet of each state (and the number of removals at the end).
+    std::vector<int> removedDroplets;                                       ///< Id of each droplet that left the network.
+
+    std::vector<T> currentPressures;                                        ///< Recorded pressures of the last state.
+    std::vector<T> currentFlowRates;                                        ///< Recorded flow rates of the last state.
+    std::unordered_map<int, sim::DropletPosition<T>> currentDroplets;       ///< Droplet positions of the last state.
+
+    /**
+     * @brief Check if a value changed with respect to its recorded value.
+     * @param[in] recorded Recorded value.
+     * @param[in] value New value.
+     * @return If the relative change exceeds the tolerance.
+     */
+    bool changed(T recorded, T value) const;
+
+    /**
+     * @brief Check if two droplet positions are equal, i.e., they have the same boundaries and fully occupied channels.
+     * @param[in] a First droplet position.
+     * @param[in] b Second droplet position.
+     * @return If the positions are equal.
+     */
+    static bool equal(sim::DropletPosition<T>& a, sim::DropletPosition<T>& b);
+
+    /**
+     * @brief Store the changed values of one quantity of a state and update its recorded values.
+     * @param[in] values New values in the order of the layout.
+     * @param[in,out] current Recorded values.
+     * @param[out] indices Layout indices of the changed values.
+     * @param[out] changedValues Changed values.
+     */
+    void addChanges(const T* values, std::vector<T>& current, std::vector<uint32_t>& indices, std::vector<T>& changedValues);
+
+  public:
+    /**
+     * @brief Constructs an empty delta-encoded history without layout.
+     * @param[in] keyframeInterval Number of states per keyframe, i.e., the maximal number of changes that are applied to reconstruct a state.
+     * @param[in] tolerance Relative change of a value, above which it is stored (0.0 stores every change, i.e., the history is lossless).
+     */
+    DeltaHistory(int keyframeInterval = 64, T tolerance = 0.0);
+
+    /**
+     * @brief Define the order of the nodes and edges. The layout can only be changed as long as no state was stored.
+     * @param[in] nodeIds Ids of the nodes in the order of the pressures.
+     * @param[in] edgeIds Ids of the edges (channels and pumps) in the order of the flow rates.
+     */
+    void setLayout(std::vector<int> nodeIds, std::vector<int> edgeIds);
+
+    /**
+     * @brief Check if the layout was defined.
+     * @return If the history has a layout.
+     */
+    bool hasLayout() const;
+
+    /**
+     * @brief Get the order of the nodes.
+     * @return Ids of the nodes in the order of the pressures.
+     */
+    const std::vector<int>& getNodeIds() const;
+
+    /**
+     * @brief Get the order of the edges.
+     * @return Ids of the edges in the order of the flow rates.
+     */
+    const std::vector<int>& getEdgeIds() const;
+
+    /**
+     * @brief Add a state, either as keyframe or as the changes with respect to the previous state.
+     * @param[in] time Time of the state in s.
+     * @param[in] pressures Pressures at the nodes in the order of the layout in Pa.
+     * @param[in] flowRates Flow rates of the edges in the order of the layout in m^3/s.
+     * @param[in] dropletPositions Positions of the droplets inside the network.
+     * @return Index of the state.
+     */
+    size_t addState(T time, const T* pressures, const T* flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions);
+
+    /**
+     * @brief Reconstruct the values of a state from its keyframe and the following changes.
+     * @param[in] state Index of the state.
+     * @param[out] pressures Pressures at the nodes in the order of the layout (must hold the number of nodes).
+     * @param[out] flowRates Flow rates of the edges in the order of the layout (must hold the number of edges).
+     * @param[out] dropletPositions Positions of the droplets inside the network (nullptr if they are not needed).
+     */
+    void reconstruct(size_t state, T* pressures, T* flowRates, std::unordered_map<int, sim::DropletPosition<T>>* dropletPositions) const;
+
+    /**
+     * @brief Reconstruct a state, which owns its values.
+     * @param[in] state Index of the state.
+     * @return The reconstructed state.
+     */
+    std::unique_ptr<State<T>> getState(size_t state) const;
+
+    /**
+     * @brief Get the times of all states.
+     * @return Time of each state in s.
+     */
+    const std::vector<T>& getTimes() const;
+
+    /**
+     * @brief Get the number of stored states.
+     * @return Number of states.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Get the number of states per keyframe.
+     * @return Keyframe interval.
+     */
+    int getKeyframeInterval() const;
+
+    /**
+     * @brief Get the relative tolerance of the stored changes.
+     * @return Tolerance.
+     */
+    T getTolerance() const;
+
+    /**
+     * @brief Get the number of stored pressures and flow rates, i.e., the values of the keyframes and the changed values.
+     * @return Number of values.
+     */
+    size_t getStoredValues() const;
+
+    /**
+     * @brief Get the number of stored droplet positions, i.e., the positions of the keyframes and the changed positions.
+     * @return Number of droplet positions.
+     */
+    size_t getStoredDropletPositions() const;
+
+    /**
+     * @brief Remove all states and the layout.
+     */
+    void clear();
+};
+
+}   // namespace result
@@ -0,0 +1,234 @@
+#include "DeltaHistory.h"
+
+namespace result {
+
+template<typename T>
+DeltaHistory<T>::DeltaHistory(int keyframeInterval_, T tolerance_) : keyframeInterval(keyframeInterval_), tolerance(tolerance_) {
+    if (keyframeInterval < 1) {
+        throw std::invalid_argument("The keyframe interval of the history must be at least 1.");
+    }
+    if (tolerance < 0.0) {
+        throw std::invalid_argument("The tolerance of the history cannot be negative.");
+    }
+    clear();
+}
+
+template<typename T>
+bool DeltaHistory<T>::changed(T recorded, T value) const {
+    return std::abs(value - recorded) > tolerance * std::max(std::abs(recorded), std::abs(value));
+}
+
+template<typename T>
+bool DeltaHistory<T>::equal(sim::DropletPosition<T>& a, sim::DropletPosition<T>& b) {
+    if (a.boundaries.size() != b.boundaries.size() || a.channelIds != b.channelIds) {
+        return false;
+    }
+    for (size_t i = 0; i < a.boundaries.size(); ++i) {
+        auto& boundaryA = a.boundaries[i];
+        auto& boundaryB = b.boundaries[i];
+        if (boundaryA.getChannelPosition().getChannel()->getId() != boundaryB.getChannelPosition().getChannel()->getId() ||
+            boundaryA.getChannelPosition().getPosition() != boundaryB.getChannelPosition().getPosition() ||
+            boundaryA.isVolumeTowardsNodeA() != boundaryB.isVolumeTowardsNodeA() ||
+            boundaryA.getState() != boundaryB.getState()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+void DeltaHistory<T>::addChanges(const T* values, std::vector<T>& current, std::vector<uint32_t>& indices, std::vector<T>& changedValues) {
+    for (size_t i = 0; i < current.size(); ++i) {
+        if (changed(current[i], values[i])) {
+            indices.push_back(static_cast<uint32_t>(i));
+            changedValues.push_back(values[i]);
+            current[i] = values[i];
+        }
+    }
+}
+
+template<typename T>
+void DeltaHistory<T>::setLayout(std::vector<int> nodeIds, std::vector<int> edgeIds) {
+    if (hasLayout() && nodeIds == nodeLayout->ids && edgeIds == edgeLayout->ids) {
+        return;
+    }
+    if (!times.empty()) {
+        throw std::invalid_argument("The nodes and edges of the stored states cannot change during a simulation.");
+    }
+    nodeLayout = std::make_unique<ColumnLayout>(std::move(nodeIds));
+    edgeLayout = std::make_unique<ColumnLayout>(std::move(edgeIds));
+}
+
+template<typename T>
+bool DeltaHistory<T>::hasLayout() const {
+    return nodeLayout != nullptr;
+}
+
+template<typename T>
+const std::vector<int>& DeltaHistory<T>::getNodeIds() const {
+    return nodeLayout->ids;
+}
+
+template<typename T>
+const std::vector<int>& DeltaHistory<T>::getEdgeIds() const {
+    return edgeLayout->ids;
+}
+
+template<typename T>
+size_t DeltaHistory<T>::addState(T time, const T* pressures, const T* flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions) {
+    if (!hasLayout()) {
+        throw std::invalid_argument("The layout of the history must be defined before states are added.");
+    }
+    const size_t state = times.size();
+    const size_t nNodes = nodeLayout->ids.size();
+    const size_t nEdges = edgeLayout->ids.size();
+
+    if (state % keyframeInterval == 0) {
+        // keyframe
+        keyframePressures.insert(keyframePressures.end(), pressures, pressures + nNodes);
+        keyframeFlowRates.insert(keyframeFlowRates.end(), flowRates, flowRates + nEdges);
+        currentPressures.assign(pressures, pressures + nNodes);
+        currentFlowRates.assign(flowRates, flowRates + nEdges);
+        currentDroplets = dropletPositions;
+        keyframeDroplets.push_back(std::move(dropletPositions));
+    } else {
+        // pressures and flow rates that changed
+        addChanges(pressures, currentPressures, pressureIndices, pressureValues);
+        addChanges(flowRates, currentFlowRates, flowRateIndices, flowRateValues);
+
+        // droplets that left the network
+        const size_t firstRemoved = removedDroplets.size();
+        for (auto& [id, position] : currentDroplets) {
+            if (dropletPositions.count(id) == 0) {
+                removedDroplets.push_back(id);
+            }
+        }
+        for (size_t i = firstRemoved; i < removedDroplets.size(); ++i) {
+            currentDroplets.erase(removedDroplets[i]);
+        }
+
+        // droplets that were injected or moved
+        for (auto& [id, position] : dropletPositions) {
+            auto current = currentDroplets.find(id);
+            if (current == currentDroplets.end()) {
+                currentDroplets.try_emplace(id, position);
+                dropletValues.emplace_back(id, position);
+            } else if (!equal(current->second, position)) {
+                current->second = position;
+                dropletValues.emplace_back(id, position);
+            }
+        }
+    }
+
+    pressureOffsets.push_back(pressureIndices.size());
+    flowRateOffsets.push_back(flowRateIndices.size());
+    dropletOffsets.push_back(dropletValues.size());
+    removedOffsets.push_back(removedDroplets.size());
+    times.push_back(time);
+
+    return state;
+}
+
+template<typename T>
+void DeltaHistory<T>::reconstruct(size_t state, T* pressures, T* flowRates, std::unordered_map<int, sim::DropletPosition<T>>* dropletPositions) const {
+    if (state >= times.size()) {
+        throw std::out_of_range("State " + std::to_string(state) + " is not part of the history.");
+    }
+    const size_t nNodes = nodeLayout->ids.size();
+    const size_t nEdges = edgeLayout->ids.size();
+    const size_t keyframe = state / keyframeInterval;
+
+    std::copy(keyframePressures.begin() + keyframe * nNodes, keyframePressures.begin() + (keyframe + 1) * nNodes, pressures);
+    std::copy(keyframeFlowRates.begin() + keyframe * nEdges, keyframeFlowRates.begin() + (keyframe + 1) * nEdges, flowRates);
+    if (dropletPositions != nullptr) {
+        *dropletPositions = keyframeDroplets[keyframe];
+    }
+
+    // apply the changes of the states after the keyframe in their order
+    for (size_t s = keyframe * keyframeInterval + 1; s <= state; ++s) {
+        for (size_t i = pressureOffsets[s]; i < pressureOffsets[s + 1]; ++i) {
+            pressures[pressureIndices[i]] = pressureValues[i];
+        }
+        for (size_t i = flowRateOffsets[s]; i < flowRateOffsets[s + 1]; ++i) {
+            flowRates[flowRateIndices[i]] = flowRateValues[i];
+        }
+        if (dropletPositions != nullptr) {
+            for (size_t i = removedOffsets[s]; i < removedOffsets[s + 1]; ++i) {
+                dropletPositions->erase(removedDroplets[i]);
+            }
+            for (size_t i = dropletOffsets[s]; i < dropletOffsets[s + 1]; ++i) {
+                dropletPositions->insert_or_assign(dropletValues[i].first, dropletValues[i].second);
+            }
+        }
+    }
+}
+
+template<typename T>
+std::unique_ptr<State<T>> DeltaHistory<T>::getState(size_t state) const {
+    const size_t nNodes = nodeLayout->ids.size();
+    std::vector<T> values(nNodes + edgeLayout->ids.size());
+    std::unordered_map<int, sim::DropletPosition<T>> dropletPositions;
+    reconstruct(state, values.data(), values.data() + nNodes, &dropletPositions);
+    return std::make_unique<State<T>>(state, times[state], nodeLayout.get(), edgeLayout.get(), std::move(values), std::move(dropletPositions));
+}
+
+template<typename T>
+const std::vector<T>& DeltaHistory<T>::getTimes() const {
+    return times;
+}
+
+template<typename T>
+size_t DeltaHistory<T>::size() const {
+    return times.size();
+}
+
+template<typename T>
+int DeltaHistory<T>::getKeyframeInterval() const {
+    return keyframeInterval;
+}
+
+template<typename T>
+T DeltaHistory<T>::getTolerance() const {
+    return tolerance;
+}
+
+template<typename T>
+size_t DeltaHistory<T>::getStoredValues() const {
+    return keyframePressures.size() + keyframeFlowRates.size() + pressureValues.size() + flowRateValues.size();
+}
+
+template<typename T>
+size_t DeltaHistory<T>::getStoredDropletPositions() const {
+    size_t count = dropletValues.size();
+    for (auto& dropletPositions : keyframeDroplets) {
+        count += dropletPositions.size();
+    }
+    return count;
+}
+
+template<typename T>
+void DeltaHistory<T>::clear() {
+    nodeLayout = nullptr;
+    edgeLayout = nullptr;
+    times.clear();
+    keyframePressures.clear();
+    keyframeFlowRates.clear();
+    keyframeDroplets.clear();
+    pressureIndices.clear();
+    pressureValues.clear();
+    flowRateIndices.clear();
+    flowRateValues.clear();
+    dropletValues.clear();
+    removedDroplets.clear();
+    currentPressures.clear();
+    currentFlowRates.clear();
+    currentDroplets.clear();
+
+    // the changes of state i are located between the offsets i and i+1
+    pressureOffsets.assign(1, 0);
+    flowRateOffsets.assign(1, 0);
+    dropletOffsets.assign(1, 0);
+    removedOffsets.assign(1, 0);
+}
+
+}   // namespace result
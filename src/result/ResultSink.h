@@ -0,0 +1,87 @@
+/**
+ * @file ResultSink.h
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sim {
+
+// Forward declared dependencies
+template<typename T>
+class DropletPosition;
+
+}
+
+namespace result {
+
+// Forward declared dependencies
+template<typename T>
+struct SimulationResult;
+
+/**
+ * @brief Interface for the destinations of the states of a simulation. The simulation passes every saved state to its result sink,
+ * which either keeps the state (see MemorySink) or writes it out (e.g., porting::JsonResultSink).
+ */
+template<typename T>
+class ResultSink {
+  public:
+    /**
+     * @brief Virtual default destructor.
+     */
+    virtual ~ResultSink() = default;
+
+    /**
+     * @brief Define the order of the nodes and edges in which the pressures and flow rates of the states are passed.
+     * @param[in] nodeIds Ids of the nodes.
+     * @param[in] edgeIds Ids of the edges (channels and pumps).
+     */
+    virtual void setLayout(std::vector<int> nodeIds, std::vector<int> edgeIds) = 0;
+
+    /**
+     * @brief Check if the order of the nodes and edges was defined.
+     * @return If the layout was defined.
+     */
+    virtual bool hasLayout() const = 0;
+
+    /**
+     * @brief Add a state.
+     * @param[in] time Time of the state in s.
+     * @param[in] pressures Pressures at the nodes in the order of the layout in Pa.
+     * @param[in] flowRates Flow rates of the edges in the order of the layout in m^3/s.
+     * @param[in] dropletPositions Positions of the droplets inside the network.
+     */
+    virtual void addState(T time, const std::vector<T>& pressures, const std::vector<T>& flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions) = 0;
+
+    /**
+     * @brief Complete the result after the simulation finished, e.g., write buffered states. States can still be added afterwards.
+     */
+    virtual void finish();
+};
+
+/**
+ * @brief Result sink that keeps all states in the simulation result, i.e., in its result store or its delta-encoded history.
+ */
+template<typename T>
+class MemorySink : public ResultSink<T> {
+  private:
+    SimulationResult<T>* result;            ///< Simulation result that keeps the states.
+
+  public:
+    /**
+     * @brief Constructs a memory sink.
+     * @param[in] result Simulation result that keeps the states.
+     */
+    explicit MemorySink(SimulationResult<T>* result);
+
+    void setLayout(std::vector<int> nodeIds, std::vector<int> edgeIds) override;
+
+    bool hasLayout() const override;
+
+    void addState(T time, const std::vector<T>& pressures, const std::vector<T>& flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions) override;
+};
+
+}   // namespace result
@@ -0,0 +1,26 @@
+#include "ResultSink.h"
+
+namespace result {
+
+template<typename T>
+void ResultSink<T>::finish() { }
+
+template<typename T>
+MemorySink<T>::MemorySink(SimulationResult<T>* result_) : result(result_) { }
+
+template<typename T>
+void MemorySink<T>::setLayout(std::vector<int> nodeIds, std::vector<int> edgeIds) {
+    result->setLayout(std::move(nodeIds), std::move(edgeIds));
+}
+
+template<typename T>
+bool MemorySink<T>::hasLayout() const {
+    return result->hasLayout();
+}
+
+template<typename T>
+void MemorySink<T>::addState(T time, const std::vector<T>& pressures, const std::vector<T>& flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions) {
+    result->addState(time, pressures, flowRates, std::move(dropletPositions));
+}
+
+}   // namespace result
@@ -0,0 +1,229 @@
+/**
+ * @file ResultStore.h
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace result {
+
+/**
+ * @brief Struct that contains a fixed order of the ids of the nodes or edges, in which their values are stored in the result store.
+ */
+struct ColumnLayout {
+    std::vector<int> ids;                           ///< Ids in the order of the stored values.
+    std::unordered_map<int, size_t> indices;        ///< Index of the value of each id.
+
+    /**
+     * @brief Constructs a layout.
+     * @param[in] ids Ids in the order of the stored values.
+     */
+    explicit ColumnLayout(std::vector<int> ids);
+};
+
+/**
+ * @brief Class for a read-only view of the values of one quantity of a state in the result store, e.g., of the pressures at the nodes.
+ * The view can be used like a map from the ids of the nodes or edges to their values.
+ */
+template<typename T>
+class ColumnView {
+  private:
+    const ColumnLayout* layout = nullptr;           ///< Order of the ids of the values.
+    const T* values = nullptr;                      ///< Values in the order of the layout.
+
+  public:
+    /**
+     * @brief Iterator over the (id, value) pairs of a view in the order of the layout.
+     */
+    class Iterator {
+      private:
+        const ColumnView* view;                     ///< The view.
+        size_t index;                               ///< Index of the current value.
+        std::pair<int, T> current;                  ///< Current (id, value) pair.
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<int, T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        /**
+         * @brief Constructs an iterator.
+         * @param[in] view The view.
+         * @param[in] index Index of the current value.
+         */
+        Iterator(const ColumnView* view, size_t index);
+
+        reference operator*() const;
+        pointer operator->() const;
+        Iterator& operator++();
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+    };
+
+    /**
+     * @brief Constructs an empty view.
+     */
+    ColumnView() = default;
+
+    /**
+     * @brief Constructs a view.
+     * @param[in] layout Order of the ids of the values.
+     * @param[in] values Values in the order of the layout.
+     */
+    ColumnView(const ColumnLayout* layout, const T* values);
+
+    /**
+     * @brief Get the value of a node or edge.
+     * @param[in] id Id of the node or edge.
+     * @return Value of the node or edge, throws std::out_of_range if the id is not part of the view.
+     */
+    const T& at(int id) const;
+
+    /**
+     * @brief Check if the view contains the value of a node or edge.
+     * @param[in] id Id of the node or edge.
+     * @return 1 if the view contains the value, 0 otherwise.
+     */
+    size_t count(int id) const;
+
+    /**
+     * @brief Get the number of values.
+     * @return Number of values.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Check if the view has no values.
+     * @return If the view is empty.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Get the values in the order of the layout.
+     * @return Pointer to the contiguous values.
+     */
+    const T* data() const;
+
+    /**
+     * @brief Get the ids in the order of the values.
+     * @return Ids of the nodes or edges.
+     */
+    const std::vector<int>& ids() const;
+
+    Iterator begin() const;
+    Iterator end() const;
+};
+
+/**
+ * @brief Class that stores the pressures and flow rates of all states of a simulation in columns, i.e., one contiguous row of values
+ * per state in a fixed node and edge order, and the times of the states in a vector. The rows are allocated in chunks of several
+ * states, so that the store grows without copying the values of earlier states and views of the states stay valid.
+ */
+template<typename T>
+class ResultStore {
+  private:
+    std::unique_ptr<ColumnLayout> nodeLayout;               ///< Order of the nodes of the pressures.
+    std::unique_ptr<ColumnLayout> edgeLayout;               ///< Order of the edges (channels and pumps) of the flow rates.
+    size_t chunkValues;                                     ///< Minimal number of values of a quantity per chunk.
+    size_t chunkStates = 1;                                 ///< Number of states per chunk, based on the layout.
+    std::vector<T> times;                                   ///< Time of each state.
+    std::vector<std::unique_ptr<T[]>> pressureChunks;       ///< Chunks of the rows of the pressures.
+    std::vector<std::unique_ptr<T[]>> flowRateChunks;       ///< Chunks of the rows of the flow rates.
+
+  public:
+    /**
+     * @brief Constructs an empty store without layout.
+     * @param[in] chunkValues Minimal number of values of a quantity per chunk, a chunk holds at least one state.
+     */
+    explicit ResultStore(size_t chunkValues = 65536);
+
+    /**
+     * @brief Define the order of the nodes and edges. The layout can only be changed as long as no state was stored.
+     * @param[in] nodeIds Ids of the nodes in the order of the pressures.
+     * @param[in] edgeIds Ids of the edges (channels and pumps) in the order of the flow rates.
+     */
+    void setLayout(std::vector<int> nodeIds, std::vector<int> edgeIds);
+
+    /**
+     * @brief Check if the layout was defined.
+     * @return If the store has a layout.
+     */
+    bool hasLayout() const;
+
+    /**
+     * @brief Get the order of the nodes.
+     * @return Ids of the nodes in the order of the pressures.
+     */
+    const std::vector<int>& getNodeIds() const;
+
+    /**
+     * @brief Get the order of the edges.
+     * @return Ids of the edges in the order of the flow rates.
+     */
+    const std::vector<int>& getEdgeIds() const;
+
+    /**
+     * @brief Add a state and copy its values.
+     * @param[in] time Time of the state in s.
+     * @param[in] pressures Pressures at the nodes in the order of the layout in Pa.
+     * @param[in] flowRates Flow rates of the edges in the order of the layout in m^3/s.
+     * @return Index of the state.
+     */
+    size_t addState(T time, const T* pressures, const T* flowRates);
+
+    /**
+     * @brief Get the pressures of a state.
+     * @param[in] state Index of the state.
+     * @return View of the pressures at the nodes.
+     */
+    ColumnView<T> getPressures(size_t state) const;
+
+    /**
+     * @brief Get the flow rates of a state.
+     * @param[in] state Index of the state.
+     * @return View of the flow rates of the edges.
+     */
+    ColumnView<T> getFlowRates(size_t state) const;
+
+    /**
+     * @brief Get the times of all states.
+     * @return Time of each state in s.
+     */
+    const std::vector<T>& getTimes() const;
+
+    /**
+     * @brief Get the number of stored states.
+     * @return Number of states.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Get the number of allocated chunks per quantity.
+     * @return Number of chunks.
+     */
+    size_t getChunks() const;
+
+    /**
+     * @brief Get the number of states per chunk.
+     * @return Number of states.
+     */
+    size_t getChunkStates() const;
+
+    /**
+     * @brief Remove all states and the layout.
+     */
+    void clear();
+};
+
+}   // namespace result
@@ -0,0 +1,197 @@
+#include "ResultStore.h"
+
+namespace result {
+
+inline ColumnLayout::ColumnLayout(std::vector<int> ids_) : ids(std::move(ids_)) {
+    indices.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        indices.try_emplace(ids[i], i);
+    }
+}
+
+template<typename T>
+ColumnView<T>::Iterator::Iterator(const ColumnView* view_, size_t index_) : view(view_), index(index_) {
+    if (index < view->size()) {
+        current = { view->layout->ids[index], view->values[index] };
+    }
+}
+
+template<typename T>
+typename ColumnView<T>::Iterator::reference ColumnView<T>::Iterator::operator*() const {
+    return current;
+}
+
+template<typename T>
+typename ColumnView<T>::Iterator::pointer ColumnView<T>::Iterator::operator->() const {
+    return &current;
+}
+
+template<typename T>
+typename ColumnView<T>::Iterator& ColumnView<T>::Iterator::operator++() {
+    ++index;
+    if (index < view->size()) {
+        current = { view->layout->ids[index], view->values[index] };
+    }
+    return *this;
+}
+
+template<typename T>
+bool ColumnView<T>::Iterator::operator==(const Iterator& other) const {
+    return index == other.index;
+}
+
+template<typename T>
+bool ColumnView<T>::Iterator::operator!=(const Iterator& other) const {
+    return index != other.index;
+}
+
+template<typename T>
+ColumnView<T>::ColumnView(const ColumnLayout* layout_, const T* values_) : layout(layout_), values(values_) { }
+
+template<typename T>
+const T& ColumnView<T>::at(int id) const {
+    if (layout == nullptr) {
+        throw std::out_of_range("Id " + std::to_string(id) + " is not part of the state.");
+    }
+    auto index = layout->indices.find(id);
+    if (index == layout->indices.end()) {
+        throw std::out_of_range("Id " + std::to_string(id) + " is not part of the state.");
+    }
+    return values[index->second];
+}
+
+template<typename T>
+size_t ColumnView<T>::count(int id) const {
+    return (layout != nullptr) ? layout->indices.count(id) : 0;
+}
+
+template<typename T>
+size_t ColumnView<T>::size() const {
+    return (layout != nullptr) ? layout->ids.size() : 0;
+}
+
+template<typename T>
+bool ColumnView<T>::empty() const {
+    return size() == 0;
+}
+
+template<typename T>
+const T* ColumnView<T>::data() const {
+    return values;
+}
+
+template<typename T>
+const std::vector<int>& ColumnView<T>::ids() const {
+    static const std::vector<int> noIds;
+    return (layout != nullptr) ? layout->ids : noIds;
+}
+
+template<typename T>
+typename ColumnView<T>::Iterator ColumnView<T>::begin() const {
+    return Iterator(this, 0);
+}
+
+template<typename T>
+typename ColumnView<T>::Iterator ColumnView<T>::end() const {
+    return Iterator(this, size());
+}
+
+template<typename T>
+ResultStore<T>::ResultStore(size_t chunkValues_) : chunkValues(std::max<size_t>(1, chunkValues_)) { }
+
+template<typename T>
+void ResultStore<T>::setLayout(std::vector<int> nodeIds, std::vector<int> edgeIds) {
+    if (hasLayout() && nodeIds == nodeLayout->ids && edgeIds == edgeLayout->ids) {
+        return;
+    }
+    if (!times.empty()) {
+        throw std::invalid_argument("The nodes and edges of the stored states cannot change during a simulation.");
+    }
+    nodeLayout = std::make_unique<ColumnLayout>(std::move(nodeIds));
+    edgeLayout = std::make_unique<ColumnLayout>(std::move(edgeIds));
+
+    // a chunk holds as many states as fit into the chunk size of the larger quantity
+    const size_t rowSize = std::max<size_t>(1, std::max(nodeLayout->ids.size(), edgeLayout->ids.size()));
+    chunkStates = std::max<size_t>(1, chunkValues / rowSize);
+}
+
+template<typename T>
+bool ResultStore<T>::hasLayout() const {
+    return nodeLayout != nullptr;
+}
+
+template<typename T>
+const std::vector<int>& ResultStore<T>::getNodeIds() const {
+    return nodeLayout->ids;
+}
+
+template<typename T>
+const std::vector<int>& ResultStore<T>::getEdgeIds() const {
+    return edgeLayout->ids;
+}
+
+template<typename T>
+size_t ResultStore<T>::addState(T time, const T* pressures, const T* flowRates) {
+    if (!hasLayout()) {
+        throw std::invalid_argument("The layout of the result store must be defined before states are added.");
+    }
+    const size_t state = times.size();
+    const size_t nNodes = nodeLayout->ids.size();
+    const size_t nEdges = edgeLayout->ids.size();
+
+    // allocate the next chunk, the earlier chunks are not moved
+    if (state % chunkStates == 0) {
+        pressureChunks.push_back(std::make_unique<T[]>(chunkStates * nNodes));
+        flowRateChunks.push_back(std::make_unique<T[]>(chunkStates * nEdges));
+    }
+    const size_t row = state % chunkStates;
+    std::copy(pressures, pressures + nNodes, pressureChunks.back().get() + row * nNodes);
+    std::copy(flowRates, flowRates + nEdges, flowRateChunks.back().get() + row * nEdges);
+    times.push_back(time);
+
+    return state;
+}
+
+template<typename T>
+ColumnView<T> ResultStore<T>::getPressures(size_t state) const {
+    const size_t nNodes = nodeLayout->ids.size();
+    return ColumnView<T>(nodeLayout.get(), pressureChunks.at(state / chunkStates).get() + (state % chunkStates) * nNodes);
+}
+
+template<typename T>
+ColumnView<T> ResultStore<T>::getFlowRates(size_t state) const {
+    const size_t nEdges = edgeLayout->ids.size();
+    return ColumnView<T>(edgeLayout.get(), flowRateChunks.at(state / chunkStates).get() + (state % chunkStates) * nEdges);
+}
+
+template<typename T>
+const std::vector<T>& ResultStore<T>::getTimes() const {
+    return times;
+}
+
+template<typename T>
+size_t ResultStore<T>::size() const {
+    return times.size();
+}
+
+template<typename T>
+size_t ResultStore<T>::getChunks() const {
+    return pressureChunks.size();
+}
+
+template<typename T>
+size_t ResultStore<T>::getChunkStates() const {
+    return chunkStates;
+}
+
+template<typename T>
+void ResultStore<T>::clear() {
+    nodeLayout = nullptr;
+    edgeLayout = nullptr;
+    chunkStates = 1;
+    times.clear();
+    pressureChunks.clear();
+    flowRateChunks.clear();
+}
+
+}   // namespace result
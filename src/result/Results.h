@@ -11,6 +11,9 @@
 #include <utility>
 #include <vector>
 
+#include "DeltaHistory.h"
+#include "ResultStore.h"
+
 namespace arch {
     
 // Forward declared dependencies
@@ -35,15 +38,17 @@ class Fluid;
 namespace result {
 
 /**
- * @brief Struct to contain a state specified by time, an unordered map of pressures, an unordered map of flow rates, a vector of clogged channel ids, an unordered map of droplet positions.
+ * @brief Struct to contain a state specified by time, a view of the pressures, a view of the flow rates and an unordered map of droplet positions.
+ * The pressures and flow rates are stored in the columnar result store of the simulation result, the state only contains views of them.
  */
 template<typename T>
 struct State {
     int id;                                                             ///< Sequential id of the state
     T time;                                                             ///< Simulation time at which the following values were calculated.
-    std::unordered_map<int, T> pressures;                               ///< Keys are the nodeIds.
-    std::unordered_map<int, T> flowRates;                               ///< Keys are the edgeIds (channels and pumps).
+    ColumnView<T> pressures;                                            ///< Keys are the nodeIds.
+    ColumnView<T> flowRates;                                            ///< Keys are the edgeIds (channels and pumps).
     std::unordered_map<int, sim::DropletPosition<T>> dropletPositions;  ///< Only contains the position of droplets that are currently inside the network (key is the droplet id).
+    std::shared_ptr<const std::vector<T>> values;                       ///< Pressures followed by flow rates of a reconstructed state, which owns its values (nullptr for states in the result store).
     
     /**
      * @brief Constructs a state, which represent a time step during a simulation.
@@ -56,31 +61,34 @@ struct State {
      * @brief Constructs a state, which represent a time step during a simulation.
      * @param[in] id Id of the state
      * @param[in] time Value of the current time step.
-     * @param[in] pressures The pressure values at the nodes at the current time step.
-     * @param[in] flowRates The flowRate values at the nodes at the current time step.
+     * @param[in] pressures View of the pressure values at the nodes at the current time step.
+     * @param[in] flowRates View of the flowRate values at the edges at the current time step.
+     * @param[in] dropletPositions The positions of the droplets inside the network at the current time step.
      */
-    State(int id, T time, std::unordered_map<int, T> pressures, std::unordered_map<int, T> flowRates);
+    State(int id, T time, ColumnView<T> pressures, ColumnView<T> flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions = {});
 
     /**
-     * @brief Constructs a state, which represent a time step during a simulation.
+     * @brief Constructs a state that owns its values, e.g., a state that was reconstructed from a delta-encoded history.
      * @param[in] id Id of the state
      * @param[in] time Value of the current time step.
-     * @param[in] pressures The pressure values at the nodes at the current time step.
-     * @param[in] flowRates The flowRate values at the nodes at the current time step.
+     * @param[in] nodeLayout Order of the nodes of the pressures.
+     * @param[in] edgeLayout Order of the edges of the flow rates.
+     * @param[in] values The pressure values at the nodes followed by the flowRate values at the edges.
+     * @param[in] dropletPositions The positions of the droplets inside the network at the current time step.
      */
-    State(int id, T time, std::unordered_map<int, T> pressures, std::unordered_map<int, T> flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions);
+    State(int id, T time, const ColumnLayout* nodeLayout, const ColumnLayout* edgeLayout, std::vector<T> values, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions = {});
 
     /**
      * @brief Function to get pressure at a specific node.
      * @returns Pressures of this state in Pa.
      */
-    const std::unordered_map<int, T>& getPressures() const;
+    const ColumnView<T>& getPressures() const;
 
     /**
      * @brief Function to get flow rate at a specific channel.
      * @returns Flowrates of this state in m^3/s.
      */
-    const std::unordered_map<int, T>& getFlowRates() const;
+    const ColumnView<T>& getFlowRates() const;
 
     /**
      * @brief Function to get flow rate at a specific channel.
@@ -109,6 +117,8 @@ struct SimulationResult {
     std::unordered_map<int, sim::Fluid<T>>* fluids;                 /// Contains all fluids which were defined (i.e., also the fluids which were created when droplets merged).
     std::unordered_map<int, sim::Droplet<T>>* droplets;             /// Contains all droplets that occurred during the simulation not only the once that were injected (i.e., also merged and splitted droplets)
     std::vector<std::unique_ptr<State<T>>> states;                  /// Contains all states ordered according to their simulation time (beginning at the start of the simulation).    
+    ResultStore<T> store;                                           /// Contains the pressures and flow rates of all states in columns.
+    std::unique_ptr<DeltaHistory<T>> history = nullptr;             /// Contains the delta-encoded states instead of states and store, if enabled.
 
     int continuousPhaseId;              /// Fluid id which served as the continuous phase.
     T maximalAdaptiveTimeStep;     /// Value for the maximal adaptive time step that was used.
@@ -129,6 +139,54 @@ struct SimulationResult {
                         std::unordered_map<int, sim::Fluid<T>>* fluids, 
                         std::unordered_map<int, sim::Droplet<T>>* droplets);
 
+    /**
+     * @brief Define the order of the nodes and edges in which the pressures and flow rates of the states are stored.
+     * @param[in] nodeIds Ids of the nodes.
+     * @param[in] edgeIds Ids of the edges (channels and pumps).
+     */
+    void setLayout(std::vector<int> nodeIds, std::vector<int> edgeIds);
+
+    /**
+     * @brief Store the states in a delta-encoded history instead of the result store, i.e., keyframes and the changes in between.
+     * The states are then not part of getStates(), but are reconstructed by getState(). Can only be set before states are added.
+     * @param[in] keyframeInterval Number of states per keyframe.
+     * @param[in] tolerance Relative change of a pressure or flow rate, above which it is stored (0.0 stores every change).
+     */
+    void setDeltaHistory(int keyframeInterval, T tolerance);
+
+    /**
+     * @brief Get the delta-encoded history.
+     * @returns Pointer to the history, nullptr if the states are not delta-encoded.
+     */
+    const DeltaHistory<T>* getDeltaHistory() const;
+
+    /**
+     * @brief Get the order of the nodes of the pressures.
+     * @returns Ids of the nodes.
+     */
+    const std::vector<int>& getNodeIds() const;
+
+    /**
+     * @brief Get the order of the edges of the flow rates.
+     * @returns Ids of the edges.
+     */
+    const std::vector<int>& getEdgeIds() const;
+
+    /**
+     * @brief Check if the order of the nodes and edges was defined.
+     * @return If the layout was defined.
+     */
+    bool hasLayout() const;
+
+    /**
+     * @brief Adds a state to the simulation results.
+     * @param[in] time Time of the state in s.
+     * @param[in] pressures Pressures at the nodes in the order of the layout.
+     * @param[in] flowRates Flow rates of the edges in the order of the layout.
+     * @param[in] dropletPositions Positions of the droplets inside the network.
+     */
+    void addState(T time, const std::vector<T>& pressures, const std::vector<T>& flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions = {});
+
     /**
      * @brief Adds a state to the simulation results.
      * @param[in] state
@@ -165,6 +223,25 @@ struct SimulationResult {
      */
     const std::vector<std::unique_ptr<State<T>>>& getStates() const;
 
+    /**
+     * @brief Get the number of states, either in the result store or in the delta-encoded history.
+     * @returns Number of states.
+     */
+    size_t getNumberOfStates() const;
+
+    /**
+     * @brief Get a copy of a state, which is reconstructed if the states are delta-encoded.
+     * @param[in] key The key of the state.
+     * @returns The state.
+     */
+    std::unique_ptr<State<T>> getState(size_t key) const;
+
+    /**
+     * @brief Get the columnar store of the pressures and flow rates of all states.
+     * @returns Result store
+     */
+    const ResultStore<T>& getStore() const;
+
     /**
      * @brief Print all the states that were stored during simulation.
     */
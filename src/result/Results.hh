@@ -6,20 +6,24 @@ template<typename T>
 State<T>::State(int id_, T time_) : id(id_), time(time_) { }
 
 template<typename T>
-State<T>::State(int id_, T time_, std::unordered_map<int, T> pressures_, std::unordered_map<int, T> flowRates_) 
-    : id(id_), time(time_), pressures(pressures_), flowRates(flowRates_) { }
+State<T>::State(int id_, T time_, ColumnView<T> pressures_, ColumnView<T> flowRates_, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions_) 
+    : id(id_), time(time_), pressures(pressures_), flowRates(flowRates_), dropletPositions(std::move(dropletPositions_)) { }
 
 template<typename T>
-State<T>::State(int id_, T time_, std::unordered_map<int, T> pressures_, std::unordered_map<int, T> flowRates_, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions_) 
-    : id(id_), time(time_), pressures(pressures_), flowRates(flowRates_), dropletPositions(dropletPositions_) { }
+State<T>::State(int id_, T time_, const ColumnLayout* nodeLayout, const ColumnLayout* edgeLayout, std::vector<T> values_, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions_) 
+    : id(id_), time(time_), dropletPositions(std::move(dropletPositions_)), values(std::make_shared<const std::vector<T>>(std::move(values_))) {
+    // the views refer to the shared values, hence they stay valid for copies of the state
+    pressures = ColumnView<T>(nodeLayout, values->data());
+    flowRates = ColumnView<T>(edgeLayout, values->data() + nodeLayout->ids.size());
+}
 
 template<typename T>
-const std::unordered_map<int, T>& State<T>::getPressures() const {
+const ColumnView<T>& State<T>::getPressures() const {
     return pressures;
 }
 
 template<typename T>
-const std::unordered_map<int, T>& State<T>::getFlowRates() const {
+const ColumnView<T>& State<T>::getFlowRates() const {
     return flowRates;
 }
 
@@ -76,18 +80,87 @@ SimulationResult<T>::SimulationResult(  arch::Network<T>* network_,
                                         std::unordered_map<int, sim::Droplet<T>>* droplets_) :
                                         network(network_), fluids(fluids_), droplets(droplets_) { }
 
+template<typename T>
+void SimulationResult<T>::setDeltaHistory(int keyframeInterval, T tolerance) {
+    if (getNumberOfStates() > 0) {
+        throw std::invalid_argument("The delta-encoded history can only be set before states are stored.");
+    }
+    history = std::make_unique<DeltaHistory<T>>(keyframeInterval, tolerance);
+}
+
+template<typename T>
+const DeltaHistory<T>* SimulationResult<T>::getDeltaHistory() const {
+    return history.get();
+}
+
+template<typename T>
+void SimulationResult<T>::setLayout(std::vector<int> nodeIds, std::vector<int> edgeIds) {
+    if (history != nullptr) {
+        history->setLayout(std::move(nodeIds), std::move(edgeIds));
+    } else {
+        store.setLayout(std::move(nodeIds), std::move(edgeIds));
+    }
+}
+
+template<typename T>
+bool SimulationResult<T>::hasLayout() const {
+    return (history != nullptr) ? history->hasLayout() : store.hasLayout();
+}
+
+template<typename T>
+const std::vector<int>& SimulationResult<T>::getNodeIds() const {
+    return (history != nullptr) ? history->getNodeIds() : store.getNodeIds();
+}
+
+template<typename T>
+const std::vector<int>& SimulationResult<T>::getEdgeIds() const {
+    return (history != nullptr) ? history->getEdgeIds() : store.getEdgeIds();
+}
+
+template<typename T>
+void SimulationResult<T>::addState(T time, const std::vector<T>& pressures, const std::vector<T>& flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions) {
+    if (pressures.size() != getNodeIds().size() || flowRates.size() != getEdgeIds().size()) {
+        throw std::invalid_argument("The pressures and flow rates of a state must match the layout of the results.");
+    }
+    if (history != nullptr) {
+        history->addState(time, pressures.data(), flowRates.data(), std::move(dropletPositions));
+        return;
+    }
+    size_t index = store.addState(time, pressures.data(), flowRates.data());
+    states.push_back(std::make_unique<State<T>>(index, time, store.getPressures(index), store.getFlowRates(index), std::move(dropletPositions)));
+}
+
 template<typename T>
 void SimulationResult<T>::addState(T time, std::unordered_map<int, T> pressures, std::unordered_map<int, T> flowRates) {
-    int id = states.size();
-    std::unique_ptr<State<T>> newState = std::make_unique<State<T>>(id, time, pressures, flowRates);
-    states.push_back(std::move(newState));
+    addState(time, std::move(pressures), std::move(flowRates), std::unordered_map<int, sim::DropletPosition<T>>());
 }
 
 template<typename T>
 void SimulationResult<T>::addState(T time, std::unordered_map<int, T> pressures, std::unordered_map<int, T> flowRates, std::unordered_map<int, sim::DropletPosition<T>> dropletPositions) {
-    int id = states.size();
-    std::unique_ptr<State<T>> newState = std::make_unique<State<T>>(id, time, pressures, flowRates, dropletPositions);
-    states.push_back(std::move(newState));
+    // the ids of the first state define the layout, sorted by their ids
+    if (!hasLayout()) {
+        std::vector<int> nodeIds;
+        std::vector<int> edgeIds;
+        for (auto& [id, pressure] : pressures) {
+            nodeIds.push_back(id);
+        }
+        for (auto& [id, flowRate] : flowRates) {
+            edgeIds.push_back(id);
+        }
+        std::sort(nodeIds.begin(), nodeIds.end());
+        std::sort(edgeIds.begin(), edgeIds.end());
+        setLayout(std::move(nodeIds), std::move(edgeIds));
+    }
+
+    std::vector<T> pressureValues;
+    std::vector<T> flowRateValues;
+    for (int id : getNodeIds()) {
+        pressureValues.push_back(pressures.at(id));
+    }
+    for (int id : getEdgeIds()) {
+        flowRateValues.push_back(flowRates.at(id));
+    }
+    addState(time, pressureValues, flowRateValues, std::move(dropletPositions));
 }
 
 template<typename T>
@@ -95,21 +168,39 @@ const std::vector<std::unique_ptr<State<T>>>& SimulationResult<T>::getStates() c
     return states;
 }
 
+template<typename T>
+size_t SimulationResult<T>::getNumberOfStates() const {
+    return (history != nullptr) ? history->size() : states.size();
+}
+
+template<typename T>
+std::unique_ptr<State<T>> SimulationResult<T>::getState(size_t key) const {
+    if (history != nullptr) {
+        return history->getState(key);
+    }
+    return std::make_unique<State<T>>(*states.at(key));
+}
+
+template<typename T>
+const ResultStore<T>& SimulationResult<T>::getStore() const {
+    return store;
+}
+
 template<typename T>
 const void SimulationResult<T>::printStates() const {
-    for ( auto& state : states ) {
-        state->printState();
+    for (size_t key = 0; key < getNumberOfStates(); ++key) {
+        getState(key)->printState();
     }
 }
 
 template<typename T>
 const void SimulationResult<T>::printLastState() const {
-    states.back()->printState();
+    getState(getNumberOfStates() - 1)->printState();
 }
 
 template<typename T>
 const void SimulationResult<T>::printState(int key) const {
-    states.at(key)->printState();
+    getState(key)->printState();
 }
 
 }  // namespace droplet
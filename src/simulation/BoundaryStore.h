@@ -0,0 +1,148 @@
+/**
+ * @file BoundaryStore.h
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace arch {
+
+// Forward declared dependencies
+template<typename T>
+class RectangularChannel;
+
+}
+
+namespace sim {
+
+/**
+ * @brief Class that owns the channels, positions, flow rates and directions of the droplet boundaries of a simulation as a structure of arrays.
+ * Each boundary keeps a slot in the store for its lifetime, its channel position (see arch::ChannelPosition) and its flow rate are views of this slot.
+ * Moving all boundaries and computing their times until they reach the end of their channels are plain loops over the arrays, which can be
+ * vectorized by the compiler. The slots of removed boundaries are reused by new boundaries, hence the index of a slot is stable.
+ */
+template<typename T>
+class BoundaryStore {
+  private:
+    std::vector<arch::RectangularChannel<T>*> channels;    ///< Channel of the boundary in each slot (nullptr for free slots).
+    std::vector<T> positions;                               ///< Relative position of the boundary in each slot inside its channel (between 0.0 and 1.0).
+    std::vector<T> flowRates;                               ///< Flow rate of the boundary in each slot (if <0 the boundary moves towards the droplet center, >0 otherwise).
+    std::vector<T> channelVolumes;                          ///< Volume of the channel of each slot, when the boundary was moved into the channel.
+    std::vector<T> directions;                              ///< 1.0 if the volume of the boundary in a slot is located towards node A of its channel, -1.0 otherwise.
+    std::vector<T> mobilities;                              ///< 1.0 if the boundary in a slot is moved (i.e., its droplet is inside the network), 0.0 otherwise.
+    std::vector<T> times;                                   ///< Time until the boundary in each slot reaches the end of its channel, see computeTimes.
+    std::vector<size_t> freeSlots;                          ///< Slots of removed boundaries, which are reused by the next inserted boundaries.
+
+  public:
+    /**
+     * @brief Insert a boundary into a free slot. The boundary does not move until it is set to moving.
+     * @param[in] channel Channel of the boundary.
+     * @param[in] position Relative position (between 0.0 and 1.0) of the boundary inside the channel.
+     * @param[in] volumeTowardsNodeA Direction in which the volume of the boundary is located (true if it is towards node A).
+     * @return Slot of the boundary.
+     */
+    size_t insert(arch::RectangularChannel<T>* channel, T position, bool volumeTowardsNodeA);
+
+    /**
+     * @brief Remove a boundary from the store, its slot can be reused by the next inserted boundary.
+     * @param[in] slot Slot of the boundary.
+     */
+    void erase(size_t slot);
+
+    /**
+     * @brief Get the channel of a boundary.
+     * @param[in] slot Slot of the boundary.
+     * @return Channel in which the boundary currently is.
+     */
+    arch::RectangularChannel<T>* getChannel(size_t slot) const;
+
+    /**
+     * @brief Move a boundary into another channel.
+     * @param[in] slot Slot of the boundary.
+     * @param[in] channel New channel of the boundary.
+     */
+    void setChannel(size_t slot, arch::RectangularChannel<T>* channel);
+
+    /**
+     * @brief Get the relative position of a boundary inside its channel.
+     * @param[in] slot Slot of the boundary.
+     * @return Relative position (between 0.0 and 1.0).
+     */
+    T getPosition(size_t slot) const;
+
+    /**
+     * @brief Set the relative position of a boundary inside its channel.
+     * @param[in] slot Slot of the boundary.
+     * @param[in] position Relative position (between 0.0 and 1.0).
+     */
+    void setPosition(size_t slot, T position);
+
+    /**
+     * @brief Get the flow rate of a boundary.
+     * @param[in] slot Slot of the boundary.
+     * @return Flow rate of the boundary.
+     */
+    T getFlowRate(size_t slot) const;
+
+    /**
+     * @brief Set the flow rate of a boundary.
+     * @param[in] slot Slot of the boundary.
+     * @param[in] flowRate Flow rate of the boundary.
+     */
+    void setFlowRate(size_t slot, T flowRate);
+
+    /**
+     * @brief Get the direction in which the volume of a boundary is located.
+     * @param[in] slot Slot of the boundary.
+     * @return true if the volume is located towards node A of the channel, false otherwise.
+     */
+    bool isVolumeTowardsNodeA(size_t slot) const;
+
+    /**
+     * @brief Set the direction in which the volume of a boundary is located.
+     * @param[in] slot Slot of the boundary.
+     * @param[in] volumeTowardsNodeA true if the volume is located towards node A of the channel, false otherwise.
+     */
+    void setVolumeTowardsNodeA(size_t slot, bool volumeTowardsNodeA);
+
+    /**
+     * @brief Define if a boundary is moved by move, i.e., if its droplet is inside the network.
+     * @param[in] slot Slot of the boundary.
+     * @param[in] moving If the boundary is moved.
+     */
+    void setMoving(size_t slot, bool moving);
+
+    /**
+     * @brief Move all moving boundaries according to their flow rates, see DropletBoundary::moveBoundary.
+     * @param[in] timeStep Time step in s for which the boundaries are moved.
+     */
+    void move(T timeStep);
+
+    /**
+     * @brief Compute the time until each boundary reaches the end of its channel, see DropletBoundary::getTime.
+     */
+    void computeTimes();
+
+    /**
+     * @brief Get the time until a boundary reaches the end of its channel, as of the last call of computeTimes.
+     * @param[in] slot Slot of the boundary.
+     * @return Time in s (0.0 if the boundary does not move).
+     */
+    T getTime(size_t slot) const;
+
+    /**
+     * @brief Get the number of boundaries in the store.
+     * @return Number of boundaries.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Get the number of slots, i.e., the length of the arrays, including the free slots.
+     * @return Number of slots.
+     */
+    size_t getSlots() const;
+};
+
+}   // namespace sim
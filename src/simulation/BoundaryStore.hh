@@ -0,0 +1,134 @@
+#include "BoundaryStore.h"
+
+namespace sim {
+
+template<typename T>
+size_t BoundaryStore<T>::insert(arch::RectangularChannel<T>* channel, T position, bool volumeTowardsNodeA) {
+    size_t slot;
+    if (freeSlots.empty()) {
+        slot = channels.size();
+        channels.push_back(nullptr);
+        positions.push_back(0.0);
+        flowRates.push_back(0.0);
+        channelVolumes.push_back(1.0);
+        directions.push_back(1.0);
+        mobilities.push_back(0.0);
+        times.push_back(0.0);
+    } else {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    setChannel(slot, channel);
+    positions[slot] = position;
+    setVolumeTowardsNodeA(slot, volumeTowardsNodeA);
+    return slot;
+}
+
+template<typename T>
+void BoundaryStore<T>::erase(size_t slot) {
+    // free slots keep a flow rate and a mobility of 0.0, so that they are not moved
+    channels[slot] = nullptr;
+    flowRates[slot] = 0.0;
+    channelVolumes[slot] = 1.0;
+    mobilities[slot] = 0.0;
+    times[slot] = 0.0;
+    freeSlots.push_back(slot);
+}
+
+template<typename T>
+arch::RectangularChannel<T>* BoundaryStore<T>::getChannel(size_t slot) const {
+    return channels[slot];
+}
+
+template<typename T>
+void BoundaryStore<T>::setChannel(size_t slot, arch::RectangularChannel<T>* channel) {
+    channels[slot] = channel;
+    channelVolumes[slot] = channel->getVolume();
+}
+
+template<typename T>
+T BoundaryStore<T>::getPosition(size_t slot) const {
+    return positions[slot];
+}
+
+template<typename T>
+void BoundaryStore<T>::setPosition(size_t slot, T position) {
+    positions[slot] = position;
+}
+
+template<typename T>
+T BoundaryStore<T>::getFlowRate(size_t slot) const {
+    return flowRates[slot];
+}
+
+template<typename T>
+void BoundaryStore<T>::setFlowRate(size_t slot, T flowRate) {
+    flowRates[slot] = flowRate;
+}
+
+template<typename T>
+bool BoundaryStore<T>::isVolumeTowardsNodeA(size_t slot) const {
+    return directions[slot] > 0.0;
+}
+
+template<typename T>
+void BoundaryStore<T>::setVolumeTowardsNodeA(size_t slot, bool volumeTowardsNodeA) {
+    directions[slot] = volumeTowardsNodeA ? 1.0 : -1.0;
+}
+
+template<typename T>
+void BoundaryStore<T>::setMoving(size_t slot, bool moving) {
+    mobilities[slot] = moving ? 1.0 : 0.0;
+}
+
+template<typename T>
+void BoundaryStore<T>::move(T timeStep) {
+    const size_t n = positions.size();
+    T* position = positions.data();
+    const T* flowRate = flowRates.data();
+    const T* channelVolume = channelVolumes.data();
+    const T* direction = directions.data();
+    const T* mobility = mobilities.data();
+
+    // a positive flow rate moves a boundary away from its volume, i.e., towards node B if the volume is towards node A
+    // the position stays in range (e.g., due to rounding errors), as in ChannelPosition::setPosition
+    for (size_t i = 0; i < n; ++i) {
+        const T newPosition = position[i] + direction[i] * flowRate[i] * timeStep * mobility[i] / channelVolume[i];
+        position[i] = (newPosition < 0.0) ? 0.0 : ((newPosition > 1.0) ? 1.0 : newPosition);
+    }
+}
+
+template<typename T>
+void BoundaryStore<T>::computeTimes() {
+    const size_t n = positions.size();
+    const T* position = positions.data();
+    const T* flowRate = flowRates.data();
+    const T* channelVolume = channelVolumes.data();
+    const T* direction = directions.data();
+    T* time = times.data();
+
+    // the remaining volume is the volume towards node A if the boundary moves towards node A (its position decreases) and the volume towards node B otherwise
+    for (size_t i = 0; i < n; ++i) {
+        const T velocity = direction[i] * flowRate[i];
+        const T remainingVolume = (velocity < 0) ? position[i] * channelVolume[i] : (1.0 - position[i]) * channelVolume[i];
+        const T speed = (flowRate[i] < 0) ? -flowRate[i] : flowRate[i];
+        time[i] = (speed > 0) ? remainingVolume / speed : 0.0;
+    }
+}
+
+template<typename T>
+T BoundaryStore<T>::getTime(size_t slot) const {
+    return times[slot];
+}
+
+template<typename T>
+size_t BoundaryStore<T>::size() const {
+    return channels.size() - freeSlots.size();
+}
+
+template<typename T>
+size_t BoundaryStore<T>::getSlots() const {
+    return channels.size();
+}
+
+}   // namespace sim
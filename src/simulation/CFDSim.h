@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <vector>
+
 namespace arch {
 
 // Forward declared dependencies
@@ -14,11 +16,20 @@ class Network;
 
 namespace sim {
 
+// Forward declared dependencies
+class ThreadPool;
+
     /**
-     * @brief Conduct theta iterations of the CFD simulation on the network.
+     * @brief Conduct theta iterations of the CFD simulation on the network, where theta is the coupling interval of each module.
+     * The modules are independent between two exchanges with the nodal analysis, hence they can be stepped concurrently on the
+     * threads of a pool. Each module is solved by exactly one thread and the convergence is reduced in a fixed module order
+     * afterwards, so that the results do not depend on the number of threads.
      * @param[in] network The network on which the CFD simulations are conducted.
+     * @param[in] threadPool Threads that step the modules, nullptr steps the modules serially.
+     * @param[in] nThreads Maximal number of threads. 0 uses all threads of the pool, 1 steps the modules serially.
+     * @return If all modules have converged.
      */
     template<typename T>
-    bool conductCFDSimulation(const arch::Network<T>* network);
+    bool conductCFDSimulation(const arch::Network<T>* network, ThreadPool* threadPool=nullptr, int nThreads=1);
 
-}   // namespace sim
\ No newline at end of file
+}   // namespace sim
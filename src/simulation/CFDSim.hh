@@ -3,24 +3,39 @@
 namespace sim {
 
     template<typename T>
-    bool conductCFDSimulation(const arch::Network<T>* network, int iteration) {
+    bool conductCFDSimulation(const arch::Network<T>* network, ThreadPool* threadPool, int nThreads) {
 
-        bool allConverge = true;
-
-        // loop through modules and perform the collide and stream operations
+        // collect the modules in a fixed order
+        std::vector<arch::lbmModule<T>*> modules;
         for (const auto& module : network->getModules()) {
-            
             // Assertion that the current module is of lbm type, and can conduct CFD simulations.
             assert(module.second->getModuleType() == arch::ModuleType::LBM);
-            module.second->solve();
+            modules.push_back(module.second.get());
+        }
 
-            if (!module.second->hasConverged()) {
+        // perform the collide and stream operations, every module is solved by one thread
+        std::vector<char> converged(modules.size(), false);
+        auto solve = [&modules, &converged](size_t i) {
+            modules[i]->solve();
+            converged[i] = modules[i]->hasConverged();
+        };
+        if (threadPool != nullptr) {
+            threadPool->parallelFor(modules.size(), nThreads, 1, solve);
+        } else {
+            for (size_t i = 0; i < modules.size(); ++i) {
+                solve(i);
+            }
+        }
+
+        // reduce the results in module order
+        bool allConverge = true;
+        for (size_t i = 0; i < modules.size(); ++i) {
+            if (!converged[i]) {
                 allConverge = false;
             }
-            
         }
 
         return allConverge;
     }
 
-}   // namespace sim
\ No newline at end of file
+}   // namespace sim
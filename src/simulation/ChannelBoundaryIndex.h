@@ -0,0 +1,78 @@
+/**
+ * @file ChannelBoundaryIndex.h
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+namespace sim {
+
+// Forward declared dependencies
+template<typename T>
+class Droplet;
+
+template<typename T>
+class DropletBoundary;
+
+/**
+ * @brief Struct that stores a boundary of the channel boundary index together with its droplet.
+ */
+template<typename T>
+struct IndexedBoundary {
+    DropletBoundary<T>* boundary;   ///< The boundary.
+    Droplet<T>* droplet;            ///< Droplet the boundary belongs to.
+};
+
+/**
+ * @brief Class that keeps the boundaries of the droplets inside the network per channel, sorted by their position inside the channel.
+ * The index is updated by the droplets when a boundary is added, removed or moved to another channel and when a droplet enters or
+ * leaves the network. Since boundaries of different droplets cannot pass each other without merging, the order inside a channel
+ * only changes when a boundary enters or leaves the channel, hence only adjacent boundaries can merge.
+ */
+template<typename T>
+class ChannelBoundaryIndex {
+  private:
+    std::unordered_map<int, std::vector<IndexedBoundary<T>>> channelBoundaries;    ///< Boundaries inside each channel that was occupied, sorted by their position.
+    int nUpdates = 0;                                                               ///< Number of insertions and removals of boundaries.
+
+  public:
+    /**
+     * @brief Insert a boundary into the list of its channel.
+     * @param[in] droplet Droplet the boundary belongs to.
+     * @param[in] boundary The boundary.
+     */
+    void insert(Droplet<T>* droplet, DropletBoundary<T>* boundary);
+
+    /**
+     * @brief Remove a boundary from the list of its (current) channel.
+     * @param[in] boundary The boundary.
+     */
+    void remove(DropletBoundary<T>* boundary);
+
+    /**
+     * @brief Remove all boundaries from the index.
+     */
+    void clear();
+
+    /**
+     * @brief Restore the order of the boundaries inside each channel after the droplets were moved.
+     * The lists are already sorted, unless boundaries passed each other due to round-off, hence this takes linear time.
+     */
+    void sort();
+
+    /**
+     * @brief Get the boundaries inside each channel that was occupied during the simulation.
+     * @return Map of channel ids to the boundaries inside the channel (can be empty), sorted by their position.
+     */
+    const std::unordered_map<int, std::vector<IndexedBoundary<T>>>& getChannelBoundaries() const;
+
+    /**
+     * @brief Get the number of insertions and removals of boundaries.
+     * @return Number of updates of the index.
+     */
+    int getUpdates() const;
+};
+
+}   // namespace sim
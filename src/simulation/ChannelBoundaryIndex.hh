@@ -0,0 +1,69 @@
+#include "ChannelBoundaryIndex.h"
+
+namespace sim {
+
+template<typename T>
+void ChannelBoundaryIndex<T>::insert(Droplet<T>* droplet, DropletBoundary<T>* boundary) {
+    auto& position = boundary->getChannelPosition();
+    auto& boundaries = channelBoundaries[position.getChannel()->getId()];
+
+    // insert behind all boundaries with a smaller or equal position (boundaries enter a channel at its ends)
+    auto it = boundaries.end();
+    while (it != boundaries.begin() && position.getPosition() < (it - 1)->boundary->getChannelPosition().getPosition()) {
+        --it;
+    }
+    boundaries.insert(it, {boundary, droplet});
+    nUpdates++;
+}
+
+template<typename T>
+void ChannelBoundaryIndex<T>::remove(DropletBoundary<T>* boundary) {
+    // the lists of channels that became empty are kept, so that their storage is reused
+    auto channel = channelBoundaries.find(boundary->getChannelPosition().getChannel()->getId());
+    if (channel == channelBoundaries.end()) {
+        return;
+    }
+
+    auto& boundaries = channel->second;
+    for (auto it = boundaries.begin(); it != boundaries.end(); ++it) {
+        if (it->boundary == boundary) {
+            boundaries.erase(it);
+            nUpdates++;
+            break;
+        }
+    }
+}
+
+template<typename T>
+void ChannelBoundaryIndex<T>::clear() {
+    channelBoundaries.clear();
+}
+
+template<typename T>
+void ChannelBoundaryIndex<T>::sort() {
+    for (auto& [channelId, boundaries] : channelBoundaries) {
+        // insertion sort, which is linear for sorted lists
+        for (size_t i = 1; i < boundaries.size(); ++i) {
+            auto entry = boundaries[i];
+            T position = entry.boundary->getChannelPosition().getPosition();
+            size_t j = i;
+            while (j > 0 && position < boundaries[j - 1].boundary->getChannelPosition().getPosition()) {
+                boundaries[j] = boundaries[j - 1];
+                --j;
+            }
+            boundaries[j] = entry;
+        }
+    }
+}
+
+template<typename T>
+const std::unordered_map<int, std::vector<IndexedBoundary<T>>>& ChannelBoundaryIndex<T>::getChannelBoundaries() const {
+    return channelBoundaries;
+}
+
+template<typename T>
+int ChannelBoundaryIndex<T>::getUpdates() const {
+    return nUpdates;
+}
+
+}   // namespace sim
@@ -5,7 +5,9 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -13,6 +15,11 @@
 #include <utility>
 #include <vector>
 
+#include "BoundaryStore.h"
+#include "ChannelBoundaryIndex.h"
+#include "NodeOccupancyIndex.h"
+#include "ObjectPool.h"
+
 namespace arch {
   
 // Forward declared dependencies
@@ -56,13 +63,19 @@ enum class BoundaryState { NORMAL, WAIT_INFLOW, WAIT_OUTFLOW };
 
 /**
  * @brief Class to specify a boundary of a droplet.
+ * The channel position, the direction and the flow rate of a boundary inside a simulation are kept in a slot of the boundary store of
+ * the simulation, the boundary is a view of this slot. Other boundaries (e.g., of saved states) own them, this also holds for copies of a view.
  */
 template<typename T>
 class DropletBoundary {
   private:
-    arch::ChannelPosition<T> channelPosition;   ///< Channel position of the boundary.
-    bool volumeTowardsNodeA;                    ///< Direction in which the volume of the boundary is located (true if it is towards node0).
-    T flowRate;                                 ///< Flow rate of the boundary (if <0 the boundary moves towards the droplet center, >0 otherwise).
+    inline static std::atomic<uint64_t> nextId = 0;     ///< Id of the next constructed boundary.
+    uint64_t id;                                ///< Unique id of the boundary, which is not reused if the memory of the boundary is reused.
+    BoundaryStore<T>* store;                    ///< Store that owns the channel position, the direction and the flow rate (nullptr if the boundary owns them).
+    size_t slot;                                ///< Slot of the boundary in the store.
+    arch::ChannelPosition<T> channelPosition;   ///< Channel position of the boundary (a view of the slot if the boundary is kept in a store).
+    bool volumeTowardsNodeA;                    ///< Direction in which the volume of the boundary is located (true if it is towards node0), only used without a store.
+    T flowRate = 0.0;                           ///< Flow rate of the boundary (if <0 the boundary moves towards the droplet center, >0 otherwise), only used without a store.
     BoundaryState state;                        ///< Current status of the boundary
 
   public:
@@ -72,8 +85,40 @@ class DropletBoundary {
      * @param position Position of the boundary within the channel.
      * @param volumeTowardsNodeA Direction in which the volume of the boundary is located (true if it is towards node0).
      * @param state State in which the boundary is in.
+     * @param store Store in which the boundary is kept (nullptr if the boundary owns its position and flow rate).
+     */
+    DropletBoundary(arch::RectangularChannel<T>* channel, T position, bool volumeTowardsNodeA, BoundaryState state, BoundaryStore<T>* store=nullptr);
+
+    /**
+     * @brief Copy a droplet boundary, the copy owns its position and flow rate and keeps the id of the boundary.
+     * @param other Boundary to copy.
      */
-    DropletBoundary(arch::RectangularChannel<T>* channel, T position, bool volumeTowardsNodeA, BoundaryState state);
+    DropletBoundary(const DropletBoundary& other);
+
+    /**
+     * @brief Set the position, direction, flow rate and state to the ones of another boundary (a view writes them into its slot of the store).
+     * @param other Boundary to copy.
+     * @return This boundary.
+     */
+    DropletBoundary& operator=(const DropletBoundary& other);
+
+    /**
+     * @brief Destruct the droplet boundary and free its slot in the store.
+     */
+    ~DropletBoundary();
+
+    /**
+     * @brief Get the unique id of the boundary. Boundaries are allocated from an object pool, hence a new boundary can have the
+     * address of a removed one, but never its id.
+     * @return Id of the boundary.
+     */
+    uint64_t getId() const;
+
+    /**
+     * @brief Get the slot of the boundary in the boundary store of the simulation.
+     * @return Slot of the boundary (0 if the boundary is not kept in a store).
+     */
+    size_t getSlot() const;
 
     /**
      * @brief Get the channel position of the boundary.
@@ -166,6 +211,13 @@ class DropletBoundary {
      */
     T getTime();
 
+    /**
+     * @brief Get the position the boundary reaches when it moves with its flow rate for the given timestep, see moveBoundary.
+     * @param timeStep Timestep for which the boundary moves.
+     * @return Relative position inside the channel (between 0.0 and 1.0).
+     */
+    T getMovedPosition(T timeStep) const;
+
     /**
      * @brief Move boundary by the given timestep considering the given slip factor.
      * @param timeStep Timestep to which the boundary should be updated.
@@ -212,8 +264,20 @@ class Droplet {
     Fluid<T>* fluid;                                      ///< Pointer to fluid of which the droplet consists of.
     std::vector<Droplet<T>*> mergedDroplets;              ///< List of previous droplets, if this droplet got merged.
     DropletState dropletState = DropletState::INJECTION;  ///< Current state of the droplet
-    std::vector<std::unique_ptr<DropletBoundary<T>>> boundaries;
+    std::vector<PoolPtr<DropletBoundary<T>>> boundaries;                  ///< Boundaries of the droplet.
+    ObjectPool* pool;                                                     ///< Pool in which the boundaries are created (nullptr for the general heap).
+    ChannelBoundaryIndex<T>* boundaryIndex;                               ///< Index of the boundaries per channel, which is updated while the droplet is inside the network (can be nullptr).
+    BoundaryStore<T>* boundaryStore;                                      ///< Store in which the boundaries are kept, which moves them while the droplet is inside the network (can be nullptr).
     std::vector<arch::RectangularChannel<T>*> channels;              ///< Contains the channels, that are completely occupied by the droplet (can happen in short channels or with large droplets).
+    NodeOccupancyIndex<T>* occupancyIndex;                                ///< Index of the droplets that span over each node (can be nullptr).
+    std::vector<int> occupiedNodes;                                       ///< Nodes the droplet is registered at in the occupancy index.
+    std::vector<DropletBoundary<T>*> inflowBoundaries;                    ///< Scratch list of the boundaries with an inflow in updateBoundaries(), reused between iterations.
+    std::vector<DropletBoundary<T>*> outflowBoundaries;                   ///< Scratch list of the boundaries with an outflow in updateBoundaries(), reused between iterations.
+
+    /**
+     * @brief Update the nodes the droplet spans over in the occupancy index, after its boundaries, fully occupied channels or state changed.
+     */
+    void updateOccupancy();
 
   public:
     /**
@@ -221,8 +285,13 @@ class Droplet {
      * @param[in] id Unique identifier of the droplet.
      * @param[in] volume Volume of the droplet in m^3.
      * @param[in] fluid Pointer to fluid the droplet consists of.
+     * @param[in] pool Pool in which the boundaries of the droplet are created (nullptr for the general heap).
+     * @param[in] boundaryIndex Index of the boundaries per channel of the simulation (nullptr if no index is kept).
+     * @param[in] occupancyIndex Index of the droplets that span over each node of the simulation (nullptr if no index is kept).
+     * @param[in] boundaryStore Store of the boundaries of the simulation (nullptr if the boundaries own their positions and flow rates).
      */
-    Droplet(int id, T volume, Fluid<T>* fluid);
+    Droplet(int id, T volume, Fluid<T>* fluid, ObjectPool* pool=nullptr, ChannelBoundaryIndex<T>* boundaryIndex=nullptr,
+            NodeOccupancyIndex<T>* occupancyIndex=nullptr, BoundaryStore<T>* boundaryStore=nullptr);
 
     /**
      * @brief Change volume of droplet.
@@ -278,11 +347,18 @@ class Droplet {
      */
     void addDropletResistance(const ResistanceModel<T>& model);
 
+    /**
+     * @brief Compute the resistance the droplet causes in each of the channels it currently occupies.
+     * @param[in] model The resistance model on which basis the resistance caused by the droplet is calculated.
+     * @param[out] resistances Channels and the resistance the droplet causes in them, a channel can occur more than once.
+     */
+    void computeDropletResistances(const ResistanceModel<T>& model, std::vector<std::pair<arch::RectangularChannel<T>*, T>>& resistances);
+
     /**
      * @brief Get the Boundaries object
      * @return all boundaries
      */
-    const std::vector<std::unique_ptr<DropletBoundary<T>>>& getBoundaries();
+    const std::vector<PoolPtr<DropletBoundary<T>>>& getBoundaries();
 
     /**
      * @brief Get all fully occupied channels
@@ -319,6 +395,15 @@ class Droplet {
      */
     void addFullyOccupiedChannel(arch::RectangularChannel<T>* channel);
 
+    /**
+     * @brief Move a boundary of the droplet to another channel.
+     * @param boundary Reference to the boundary that should be moved.
+     * @param channel New channel of the boundary.
+     * @param position New position within the channel.
+     * @param volumeTowardsNodeA New direction in which the droplet lies within the channel (in regards to node0).
+     */
+    void moveBoundary(DropletBoundary<T>& boundary, arch::RectangularChannel<T>* channel, T position, bool volumeTowardsNodeA);
+
     /**
      * @brief Remove boundary from the boundary list.
      * @param boundaryReference Reference to the boundary that should be removed.
@@ -8,8 +8,40 @@ DropletPosition<T>::DropletPosition() { }
 ///-----------------------------Droplet------------------------------------///
 
 template<typename T>
-Droplet<T>::Droplet(int id, T volume, Fluid<T>* fluid) : 
-    id(id), volume(volume), fluid(fluid) { }
+Droplet<T>::Droplet(int id, T volume, Fluid<T>* fluid, ObjectPool* pool, ChannelBoundaryIndex<T>* boundaryIndex,
+                    NodeOccupancyIndex<T>* occupancyIndex, BoundaryStore<T>* boundaryStore) : 
+    id(id), volume(volume), fluid(fluid), pool(pool), boundaryIndex(boundaryIndex), boundaryStore(boundaryStore), occupancyIndex(occupancyIndex) { }
+
+template<typename T>
+void Droplet<T>::updateOccupancy() {
+    if (occupancyIndex == nullptr) {
+        return;
+    }
+
+    for (int nodeId : occupiedNodes) {
+        occupancyIndex->remove(nodeId, this);
+    }
+    occupiedNodes.clear();
+
+    // droplets inside a single channel cannot span over a node
+    if (dropletState != DropletState::NETWORK || isInsideSingleChannel()) {
+        return;
+    }
+
+    for (auto& boundary : boundaries) {
+        occupiedNodes.push_back(boundary->getReferenceNode());
+    }
+    for (auto& channel : channels) {
+        occupiedNodes.push_back(channel->getNodeA());
+        occupiedNodes.push_back(channel->getNodeB());
+    }
+    std::sort(occupiedNodes.begin(), occupiedNodes.end());
+    occupiedNodes.erase(std::unique(occupiedNodes.begin(), occupiedNodes.end()), occupiedNodes.end());
+
+    for (int nodeId : occupiedNodes) {
+        occupancyIndex->insert(nodeId, this);
+    }
+}
 
 template<typename T>
 void Droplet<T>::setVolume(T volume) {
@@ -23,7 +55,24 @@ void Droplet<T>::setName(std::string name) {
 
 template<typename T>
 void Droplet<T>::setDropletState(DropletState dropletState) {
+    // the boundary index only contains the boundaries of droplets inside the network
+    if (boundaryIndex != nullptr && (this->dropletState == DropletState::NETWORK) != (dropletState == DropletState::NETWORK)) {
+        for (auto& boundary : boundaries) {
+            if (dropletState == DropletState::NETWORK) {
+                boundaryIndex->insert(this, boundary.get());
+            } else {
+                boundaryIndex->remove(boundary.get());
+            }
+        }
+    }
+    // only the boundaries of droplets inside the network (but no trapped droplets) are moved
+    if (boundaryStore != nullptr) {
+        for (auto& boundary : boundaries) {
+            boundaryStore->setMoving(boundary->getSlot(), dropletState == DropletState::NETWORK);
+        }
+    }
     this->dropletState = dropletState;
+    updateOccupancy();
 }
 
 template<typename T>
@@ -53,28 +102,39 @@ const Fluid<T>* Droplet<T>::getFluid() const {
 
 template<typename T>
 void Droplet<T>::addDropletResistance(const ResistanceModel<T>& model) {
+    std::vector<std::pair<arch::RectangularChannel<T>*, T>> resistances;
+    computeDropletResistances(model, resistances);
+    for (auto& [channel, resistance] : resistances) {
+        channel->addDropletResistance(resistance);
+    }
+}
+
+template<typename T>
+void Droplet<T>::computeDropletResistances(const ResistanceModel<T>& model, std::vector<std::pair<arch::RectangularChannel<T>*, T>>& resistances) {
+    resistances.clear();
+
     // check if droplet is in a single channel
     if (isInsideSingleChannel()) {
         auto channel = boundaries[0]->getChannelPosition().getChannel();
         // volumeInsideChannel = volumeChannel - (volumeBoundary0 - volumeChannel) - (volumeBoundary1 - volumeChannel) = volumeBoundary0 + volumeBoundary1 - volumeChannel
         T volumeInsideChannel = boundaries[0]->getVolume() + boundaries[1]->getVolume() - channel->getVolume();
-        channel->addDropletResistance(model.getDropletResistance(channel, this, volumeInsideChannel));
+        resistances.emplace_back(channel, model.getDropletResistance(channel, this, volumeInsideChannel));
     } else {
         // loop through boundaries
         for (auto& boundary : boundaries) {
             auto channel = boundary->getChannelPosition().getChannel();
-            channel->addDropletResistance(model.getDropletResistance(channel, this, boundary->getVolume()));
+            resistances.emplace_back(channel, model.getDropletResistance(channel, this, boundary->getVolume()));
         }
 
         // loop through fully occupied channels (if present)
         for (auto& channel : channels) {
-            channel->addDropletResistance(model.getDropletResistance(channel, this, channel->getVolume()));
+            resistances.emplace_back(channel, model.getDropletResistance(channel, this, channel->getVolume()));
         }
     }
 }
 
 template<typename T>
-const std::vector<std::unique_ptr<DropletBoundary<T>>>& Droplet<T>::getBoundaries() {
+const std::vector<PoolPtr<DropletBoundary<T>>>& Droplet<T>::getBoundaries() {
     return boundaries;
 }
 
@@ -98,12 +158,35 @@ bool Droplet<T>::isInsideSingleChannel() {
 
 template<typename T>
 void Droplet<T>::addBoundary(arch::RectangularChannel<T>* channel, T position, bool volumeTowardsNodeA, BoundaryState state) { 
-    boundaries.push_back(std::make_unique<DropletBoundary<T>>(channel, position, volumeTowardsNodeA, state));
+    boundaries.push_back(ObjectPool::make<DropletBoundary<T>>(pool, channel, position, volumeTowardsNodeA, state, boundaryStore));
+    if (boundaryIndex != nullptr && dropletState == DropletState::NETWORK) {
+        boundaryIndex->insert(this, boundaries.back().get());
+    }
+    if (boundaryStore != nullptr) {
+        boundaryStore->setMoving(boundaries.back()->getSlot(), dropletState == DropletState::NETWORK);
+    }
+    updateOccupancy();
 }
 
 template<typename T>
 void Droplet<T>::addFullyOccupiedChannel(arch::RectangularChannel<T>* channel) {
     channels.push_back(channel);
+    updateOccupancy();
+}
+
+template<typename T>
+void Droplet<T>::moveBoundary(DropletBoundary<T>& boundary, arch::RectangularChannel<T>* channel, T position, bool volumeTowardsNodeA) {
+    bool indexed = boundaryIndex != nullptr && dropletState == DropletState::NETWORK;
+    if (indexed) {
+        boundaryIndex->remove(&boundary);
+    }
+    boundary.getChannelPosition().setChannel(channel);
+    boundary.getChannelPosition().setPosition(position);
+    boundary.setVolumeTowardsNodeA(volumeTowardsNodeA);
+    if (indexed) {
+        boundaryIndex->insert(this, &boundary);
+    }
+    updateOccupancy();
 }
 
 template<typename T>
@@ -112,10 +195,14 @@ void Droplet<T>::removeBoundary(DropletBoundary<T>& boundaryReference) {
 
     for (unsigned int i = 0; i < boundaries.size(); i++) {
         if (boundaries[i].get() == &boundaryReference) {
+            if (boundaryIndex != nullptr && dropletState == DropletState::NETWORK) {
+                boundaryIndex->remove(&boundaryReference);
+            }
             boundaries.erase(boundaries.begin() + i);
             break;
         }
     }
+    updateOccupancy();
 }
 
 template<typename T>
@@ -126,6 +213,7 @@ void Droplet<T>::removeFullyOccupiedChannel(int channelId) {
             break;
         }
     }
+    updateOccupancy();
 }
 
 template<typename T>
@@ -166,8 +254,8 @@ void Droplet<T>::updateBoundaries(const arch::Network<T>& network) {
     // determine the state of the droplet
     T qInflow = 0;
     T qOutflow = 0;
-    std::vector<DropletBoundary<T>*> outflowBoundaries;
-    std::vector<DropletBoundary<T>*> inflowBoundaries;
+    outflowBoundaries.clear();
+    inflowBoundaries.clear();
 
     // loop through boundaries
     for (auto& boundary : boundaries) {
@@ -256,8 +344,44 @@ const std::vector<Droplet<T>*>& Droplet<T>::getMergedDroplets() const {
 ///--------------------------DropletBoundary------------------------------------///
 
 template<typename T>
-DropletBoundary<T>::DropletBoundary(arch::RectangularChannel<T>* channel, T position, bool volumeTowardsNodeA, BoundaryState state) : 
-    channelPosition(channel, position), volumeTowardsNodeA(volumeTowardsNodeA), state(state) { }
+DropletBoundary<T>::DropletBoundary(arch::RectangularChannel<T>* channel, T position, bool volumeTowardsNodeA, BoundaryState state, BoundaryStore<T>* store) : 
+    id(nextId++), store(store), slot((store != nullptr) ? store->insert(channel, position, volumeTowardsNodeA) : 0),
+    channelPosition((store != nullptr) ? arch::ChannelPosition<T>(store, slot) : arch::ChannelPosition<T>(channel, position)),
+    volumeTowardsNodeA(volumeTowardsNodeA), state(state) { }
+
+template<typename T>
+DropletBoundary<T>::DropletBoundary(const DropletBoundary& other) : 
+    id(other.id), store(nullptr), slot(0), channelPosition(other.channelPosition), volumeTowardsNodeA(other.isVolumeTowardsNodeA()),
+    flowRate(other.getFlowRate()), state(other.state) { }
+
+template<typename T>
+DropletBoundary<T>& DropletBoundary<T>::operator=(const DropletBoundary& other) {
+    if (this != &other) {
+        id = other.id;
+        channelPosition = other.channelPosition;
+        setVolumeTowardsNodeA(other.isVolumeTowardsNodeA());
+        setFlowRate(other.getFlowRate());
+        state = other.state;
+    }
+    return *this;
+}
+
+template<typename T>
+DropletBoundary<T>::~DropletBoundary() {
+    if (store != nullptr) {
+        store->erase(slot);
+    }
+}
+
+template<typename T>
+uint64_t DropletBoundary<T>::getId() const {
+    return id;
+}
+
+template<typename T>
+size_t DropletBoundary<T>::getSlot() const {
+    return slot;
+}
 
 template<typename T>
 arch::ChannelPosition<T>& DropletBoundary<T>::getChannelPosition() {
@@ -266,12 +390,12 @@ arch::ChannelPosition<T>& DropletBoundary<T>::getChannelPosition() {
 
 template<typename T>
 T DropletBoundary<T>::getFlowRate() const {
-    return flowRate;
+    return (store != nullptr) ? store->getFlowRate(slot) : flowRate;
 }
 
 template<typename T>
 bool DropletBoundary<T>::isVolumeTowardsNodeA() const {
-    return volumeTowardsNodeA;
+    return (store != nullptr) ? store->isVolumeTowardsNodeA(slot) : volumeTowardsNodeA;
 }
 
 template<typename T>
@@ -281,12 +405,20 @@ BoundaryState DropletBoundary<T>::getState() const {
 
 template<typename T>
 void DropletBoundary<T>::setFlowRate(T flowRate) {
-    this->flowRate = flowRate;
+    if (store != nullptr) {
+        store->setFlowRate(slot, flowRate);
+    } else {
+        this->flowRate = flowRate;
+    }
 }
 
 template<typename T>
 void DropletBoundary<T>::setVolumeTowardsNodeA(bool volumeTowardsNodeA) {
-    this->volumeTowardsNodeA = volumeTowardsNodeA;
+    if (store != nullptr) {
+        store->setVolumeTowardsNodeA(slot, volumeTowardsNodeA);
+    } else {
+        this->volumeTowardsNodeA = volumeTowardsNodeA;
+    }
 }
 
 template<typename T>
@@ -296,7 +428,7 @@ void DropletBoundary<T>::setState(BoundaryState state) {
 
 template<typename T>
 arch::Node<T>* DropletBoundary<T>::getReferenceNode(arch::Network<T>* network) {
-    if (volumeTowardsNodeA) {
+    if (isVolumeTowardsNodeA()) {
         return network->getNode(channelPosition.getChannel()->getNodeA()).get();
     } else {
         return network->getNode(channelPosition.getChannel()->getNodeB()).get();
@@ -305,7 +437,7 @@ arch::Node<T>* DropletBoundary<T>::getReferenceNode(arch::Network<T>* network) {
 
 template<typename T>
 int DropletBoundary<T>::getReferenceNode() {
-    if (volumeTowardsNodeA) {
+    if (isVolumeTowardsNodeA()) {
         return channelPosition.getChannel()->getNodeA();
     } else {
         return channelPosition.getChannel()->getNodeB();
@@ -314,7 +446,7 @@ int DropletBoundary<T>::getReferenceNode() {
 
 template<typename T>
 arch::Node<T>* DropletBoundary<T>::getOppositeReferenceNode(arch::Network<T>* network) {
-    if (volumeTowardsNodeA) {
+    if (isVolumeTowardsNodeA()) {
         return network->getNode(channelPosition.getChannel()->getNodeB()).get();
     } else {
         return network->getNode(channelPosition.getChannel()->getNodeA()).get();
@@ -323,7 +455,7 @@ arch::Node<T>* DropletBoundary<T>::getOppositeReferenceNode(arch::Network<T>* ne
 
 template<typename T>
 int DropletBoundary<T>::getOppositeReferenceNode() {
-    if (volumeTowardsNodeA) {
+    if (isVolumeTowardsNodeA()) {
         return channelPosition.getChannel()->getNodeB();
     } else {
         return channelPosition.getChannel()->getNodeA();
@@ -333,17 +465,18 @@ int DropletBoundary<T>::getOppositeReferenceNode() {
 template<typename T>
 T DropletBoundary<T>::getRemainingVolume() {
     T volume = 0;
+    const T flowRate = getFlowRate();
 
     if (flowRate < 0) {
         // boundary moves towards the droplet center
-        if (volumeTowardsNodeA) {
+        if (isVolumeTowardsNodeA()) {
             volume = channelPosition.getVolumeA();
         } else {
             volume = channelPosition.getVolumeB();
         }
     } else if (flowRate > 0) {
         // boundary moves away from the droplet center
-        if (volumeTowardsNodeA) {
+        if (isVolumeTowardsNodeA()) {
             volume = channelPosition.getVolumeB();
         } else {
             volume = channelPosition.getVolumeA();
@@ -355,7 +488,7 @@ T DropletBoundary<T>::getRemainingVolume() {
 
 template<typename T>
 T DropletBoundary<T>::getVolume() {
-    if (volumeTowardsNodeA) {
+    if (isVolumeTowardsNodeA()) {
         return channelPosition.getVolumeA();
     } else {
         return channelPosition.getVolumeB();
@@ -365,7 +498,7 @@ T DropletBoundary<T>::getVolume() {
 template<typename T>
 T DropletBoundary<T>::getChannelFlowRate() {
     T flowRate = channelPosition.getChannel()->getFlowRate();
-    if (volumeTowardsNodeA) {
+    if (isVolumeTowardsNodeA()) {
         return flowRate;
     } else {
         return -flowRate;
@@ -375,6 +508,7 @@ T DropletBoundary<T>::getChannelFlowRate() {
 template<typename T>
 T DropletBoundary<T>::getTime() {
     T time = 0;
+    const T flowRate = getFlowRate();
 
     if (flowRate < 0) {
         time = getRemainingVolume() / -flowRate;
@@ -386,17 +520,28 @@ T DropletBoundary<T>::getTime() {
 }
 
 template<typename T>
-void DropletBoundary<T>::moveBoundary(T timeStep) {
+T DropletBoundary<T>::getMovedPosition(T timeStep) const {
     // check in which direction the volume goes
-    if (volumeTowardsNodeA) {
+    const T flowRate = getFlowRate();
+    T volumeShift;
+    if (isVolumeTowardsNodeA()) {
         // positive flow rate indicates an outflow (movement towards node1) and, thus, the position inside the channel must increase
         // negative flow rate indicates an inflow (movement towards node0) and, thus, the position inside the channel must decrease
-        channelPosition.addToPosition(flowRate * timeStep);
+        volumeShift = flowRate * timeStep;
     } else {
         // positive flow rate indicates an outflow (movement towards node0) and, thus, the position inside the channel must decrease
         // negative flow rate indicates an inflow (movement towards node1) and, thus, the position inside the channel must increase
-        channelPosition.addToPosition(-flowRate * timeStep);
+        volumeShift = -flowRate * timeStep;
     }
+
+    // ensure that position stays in range (e.g., due to rounding errors), as in ChannelPosition::setPosition
+    T position = channelPosition.getPosition() + volumeShift / channelPosition.getChannel()->getVolume();
+    return (position < 0.0) ? 0.0 : ((position > 1.0) ? 1.0 : position);
+}
+
+template<typename T>
+void DropletBoundary<T>::moveBoundary(T timeStep) {
+    channelPosition.setPosition(getMovedPosition(timeStep));
 }
 
 template<typename T>
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <limits>
 #include <memory>
 #include <string>
 
@@ -24,6 +25,9 @@ namespace sim {
 template<typename T>
 class Droplet;
 
+template<typename T>
+class Fluid;
+
 /**
  * @brief Class that contains all paramaters necessary to conduct an injection.
  */
@@ -84,4 +88,122 @@ class DropletInjection {
     Droplet<T>* getDroplet() const;
 };
 
+/**
+ * @brief Class that periodically injects droplets of the same fluid and volume at the same position. In contrast to a DropletInjection,
+ * the droplets are not created upfront, but only when their injection takes place.
+ */
+template<typename T>
+class DropletGenerator {
+  private:
+    const int id;                                   ///< Unique identifier of the generator.
+    std::string name = "";                          ///< Name of the generator.
+    Fluid<T>* fluid;                                ///< Fluid the injected droplets consist of.
+    T volume;                                       ///< Volume of the injected droplets in m^3.
+    arch::ChannelPosition<T> injectionPosition;     ///< Position at which the droplets should be injected.
+    T startTime;                                    ///< Time of the first injection in s elapsed since the start of the simulation.
+    T period;                                       ///< Time between two injections in s.
+    int count;                                      ///< Number of droplets to inject, negative for an unlimited number.
+    T endTime = std::numeric_limits<T>::max();      ///< Time after which no droplets are injected anymore in s elapsed since the start of the simulation.
+    int injectedDroplets = 0;                       ///< Number of droplets that were injected so far.
+
+  public:
+    /**
+     * @brief Create a droplet generator.
+     * @param[in] id Unique identifier of the generator.
+     * @param[in] fluid Fluid the injected droplets consist of.
+     * @param[in] volume Volume of the injected droplets in m^3.
+     * @param[in] channel Channel in which the droplets should be injected. The channel must be able to fully contain a droplet.
+     * @param[in] injectionPosition Relative position (between 0.0 and 1.0) of the middle of the droplets in channel.
+     * @param[in] startTime Time of the first injection in s elapsed since the start of the simulation.
+     * @param[in] period Time between two injections in s.
+     * @param[in] count Number of droplets to inject, negative for an unlimited number (requires an end time, see setEndTime).
+     */
+    DropletGenerator(int id, Fluid<T>* fluid, T volume, arch::RectangularChannel<T>* channel, T injectionPosition, T startTime, T period, int count);
+
+    /**
+     * @brief Set name of generator.
+     * @param[in] name Name of generator.
+     */
+    void setName(std::string name);
+
+    /**
+     * @brief Set the time after which no droplets are injected anymore.
+     * @param[in] endTime Time in s elapsed since the start of the simulation.
+     */
+    void setEndTime(T endTime);
+
+    /**
+     * @brief Retrieve unique identifier of generator.
+     * @return Unique identifier of generator.
+     */
+    int getId() const;
+
+    /**
+     * @brief Retrieve name of generator.
+     * @return Name of generator.
+     */
+    std::string getName() const;
+
+    /**
+     * @brief Retrieve the fluid the injected droplets consist of.
+     * @return Pointer to the fluid.
+     */
+    Fluid<T>* getFluid() const;
+
+    /**
+     * @brief Retrieve the volume of the injected droplets.
+     * @return Volume in m^3.
+     */
+    T getVolume() const;
+
+    /**
+     * @brief Retrieve position at which the injections should take place.
+     * @return Position at which the injections should take place.
+     */
+    const arch::ChannelPosition<T>& getInjectionPosition() const;
+
+    /**
+     * @brief Retrieve time of the next injection.
+     * @return Time in s elapsed since the start of the simulation.
+     */
+    T getNextInjectionTime() const;
+
+    /**
+     * @brief Retrieve the number of droplets that were injected so far.
+     * @return Number of injected droplets.
+     */
+    int getInjectedDroplets() const;
+
+    /**
+     * @brief Check if all droplets of the generator were injected.
+     * @return If no injection is left.
+     */
+    bool isFinished() const;
+
+    /**
+     * @brief Mark the next injection as done.
+     */
+    void addInjectedDroplet();
+};
+
+/**
+ * @brief Struct for an injection that is waiting to take place, i.e., either a DropletInjection or the next injection of a DropletGenerator.
+ * Pending injections are ordered by their time and, for the same time, by the order in which they were scheduled.
+ */
+template<typename T>
+struct PendingInjection {
+    T time;                                 ///< Time of the injection in s elapsed since the start of the simulation.
+    int sequence;                           ///< Order in which the injection was scheduled.
+    DropletInjection<T>* injection;         ///< Injection of an existing droplet, nullptr for a generator.
+    DropletGenerator<T>* generator;         ///< Generator that creates the droplet, nullptr for an injection.
+    int injectedDroplets;                   ///< Number of droplets the generator had injected when the injection was scheduled.
+
+    /**
+     * @brief Compare two pending injections.
+     * @param[in] other The other pending injection.
+     * @return If this injection takes place after the other one.
+     */
+    bool operator>(const PendingInjection& other) const;
+};
+
 }  // namespace sim
@@ -36,4 +36,72 @@ Droplet<T>* DropletInjection<T>::getDroplet() const {
     return droplet;
 }
 
+template<typename T>
+DropletGenerator<T>::DropletGenerator(int id, Fluid<T>* fluid, T volume, arch::RectangularChannel<T>* channel, T injectionPosition, T startTime, T period, int count) :
+    id(id), fluid(fluid), volume(volume), injectionPosition(arch::ChannelPosition<T>(channel, injectionPosition)), startTime(startTime), period(period), count(count) { }
+
+template<typename T>
+void DropletGenerator<T>::setName(std::string name_) {
+    name = std::move(name_);
+}
+
+template<typename T>
+void DropletGenerator<T>::setEndTime(T endTime_) {
+    endTime = endTime_;
+}
+
+template<typename T>
+int DropletGenerator<T>::getId() const {
+    return id;
+}
+
+template<typename T>
+std::string DropletGenerator<T>::getName() const {
+    return name;
+}
+
+template<typename T>
+Fluid<T>* DropletGenerator<T>::getFluid() const {
+    return fluid;
+}
+
+template<typename T>
+T DropletGenerator<T>::getVolume() const {
+    return volume;
+}
+
+template<typename T>
+const arch::ChannelPosition<T>& DropletGenerator<T>::getInjectionPosition() const {
+    return injectionPosition;
+}
+
+template<typename T>
+T DropletGenerator<T>::getNextInjectionTime() const {
+    // computed from the start time, so that no rounding errors accumulate over many injections
+    return startTime + injectedDroplets * period;
+}
+
+template<typename T>
+int DropletGenerator<T>::getInjectedDroplets() const {
+    return injectedDroplets;
+}
+
+template<typename T>
+bool DropletGenerator<T>::isFinished() const {
+    return (count >= 0 && injectedDroplets >= count) || getNextInjectionTime() > endTime;
+}
+
+template<typename T>
+void DropletGenerator<T>::addInjectedDroplet() {
+    injectedDroplets++;
+}
+
+template<typename T>
+bool PendingInjection<T>::operator>(const PendingInjection& other) const {
+    if (time == other.time) {
+        return sequence > other.sequence;
+    }
+    return time > other.time;
+}
+
 }  // namespace sim
@@ -0,0 +1,54 @@
+/**
+ * @file NodeOccupancyIndex.h
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+namespace sim {
+
+// Forward declared dependencies
+template<typename T>
+class Droplet;
+
+/**
+ * @brief Class that keeps the droplets that span over each node of the network, i.e., droplets inside the network that are not
+ * inside a single channel and that have a boundary with this reference node or a fully occupied channel connected to this node.
+ * The index is updated by the droplets whenever their boundaries, fully occupied channels or state change.
+ */
+template<typename T>
+class NodeOccupancyIndex {
+  private:
+    std::unordered_map<int, std::vector<Droplet<T>*>> nodeDroplets;     ///< Droplets that span over each node, in the order they reached it.
+
+  public:
+    /**
+     * @brief Add a droplet to a node.
+     * @param[in] nodeId Id of the node.
+     * @param[in] droplet The droplet.
+     */
+    void insert(int nodeId, Droplet<T>* droplet);
+
+    /**
+     * @brief Remove a droplet from a node.
+     * @param[in] nodeId Id of the node.
+     * @param[in] droplet The droplet.
+     */
+    void remove(int nodeId, Droplet<T>* droplet);
+
+    /**
+     * @brief Remove all droplets from the index.
+     */
+    void clear();
+
+    /**
+     * @brief Get the droplet that spans over a node.
+     * @param[in] nodeId Id of the node.
+     * @return Pointer to the droplet that reached the node first or nullptr if no droplet spans over the node.
+     */
+    Droplet<T>* getDroplet(int nodeId) const;
+};
+
+}   // namespace sim
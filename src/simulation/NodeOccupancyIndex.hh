@@ -0,0 +1,41 @@
+#include "NodeOccupancyIndex.h"
+
+namespace sim {
+
+template<typename T>
+void NodeOccupancyIndex<T>::insert(int nodeId, Droplet<T>* droplet) {
+    nodeDroplets[nodeId].push_back(droplet);
+}
+
+template<typename T>
+void NodeOccupancyIndex<T>::remove(int nodeId, Droplet<T>* droplet) {
+    // the lists of nodes that became empty are kept, so that their storage is reused
+    auto node = nodeDroplets.find(nodeId);
+    if (node == nodeDroplets.end()) {
+        return;
+    }
+
+    auto& droplets = node->second;
+    for (auto it = droplets.begin(); it != droplets.end(); ++it) {
+        if (*it == droplet) {
+            droplets.erase(it);
+            break;
+        }
+    }
+}
+
+template<typename T>
+void NodeOccupancyIndex<T>::clear() {
+    nodeDroplets.clear();
+}
+
+template<typename T>
+Droplet<T>* NodeOccupancyIndex<T>::getDroplet(int nodeId) const {
+    auto node = nodeDroplets.find(nodeId);
+    if (node == nodeDroplets.end() || node->second.empty()) {
+        return nullptr;
+    }
+    return node->second.front();
+}
+
+}   // namespace sim
@@ -0,0 +1,127 @@
+/**
+ * @file ObjectPool.h
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace sim {
+
+// Forward declared dependencies
+class ObjectPool;
+
+/**
+ * @brief Deleter of objects that were created by an object pool. Destroys the object and returns its memory to the pool.
+ */
+struct PoolDeleter {
+    ObjectPool* pool = nullptr;     ///< Pool the object was created by (nullptr if it was allocated on the general heap).
+    size_t size = 0;                ///< Size of the dynamic type of the object in bytes.
+
+    template<typename U>
+    void operator()(U* object) const;
+};
+
+/**
+ * @brief Owning pointer to an object that was created by an object pool.
+ */
+template<typename U>
+using PoolPtr = std::unique_ptr<U, PoolDeleter>;
+
+/**
+ * @brief Class for a free-list pool of small objects of arbitrary type, e.g., the events and droplet boundaries of a simulation.
+ * The memory is requested from the general heap in chunks of blocks of the same size class and blocks that are released
+ * are kept in a free list of their size class, so that objects that are created and destroyed in every iteration of the
+ * simulation loop reuse the same memory. Objects that are larger than the largest size class are allocated on the general heap.
+ * The pool is not thread-safe and must outlive all objects created by it.
+ */
+class ObjectPool {
+  private:
+    /**
+     * @brief Released block of the pool that points to the next released block of the same size class.
+     */
+    struct FreeBlock {
+        FreeBlock* next;    ///< Next released block.
+    };
+
+    static constexpr size_t blockAlignment = alignof(std::max_align_t);     ///< Alignment (and granularity) of the block sizes in bytes.
+    static constexpr size_t maxBlockSize = 512;                             ///< Largest block size in bytes.
+    static constexpr size_t blocksPerChunk = 64;                            ///< Number of blocks that are requested from the general heap at once.
+
+    std::vector<FreeBlock*> freeLists;                          ///< Released blocks of each size class.
+    std::vector<std::unique_ptr<unsigned char[]>> chunks;       ///< Memory of the pool.
+    size_t nAllocations = 0;                                    ///< Number of objects that were created by the pool.
+    size_t nHeapAllocations = 0;                                ///< Number of allocations on the general heap (chunks and large objects).
+    size_t nObjects = 0;                                        ///< Number of objects that are currently alive.
+
+    /**
+     * @brief Get the size class of an object.
+     * @param[in] size Size of the object in bytes.
+     * @return Index of the size class.
+     */
+    static size_t sizeClass(size_t size);
+
+  public:
+    /**
+     * @brief Constructor of an empty object pool.
+     */
+    ObjectPool();
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * @brief Allocate uninitialized memory for an object.
+     * @param[in] size Size of the object in bytes.
+     * @return Pointer to the memory.
+     */
+    void* allocate(size_t size);
+
+    /**
+     * @brief Return the memory of an object to the pool.
+     * @param[in] memory Pointer to the memory.
+     * @param[in] size Size of the object in bytes (as passed to allocate).
+     */
+    void deallocate(void* memory, size_t size);
+
+    /**
+     * @brief Create an object in the pool.
+     * @param[in] args Arguments that are forwarded to the constructor of the object.
+     * @return Owning pointer to the object.
+     */
+    template<typename U, typename... Args>
+    PoolPtr<U> create(Args&&... args);
+
+    /**
+     * @brief Create an object in a pool or, if no pool is given, on the general heap.
+     * @param[in] pool Pool the object is created by (can be nullptr).
+     * @param[in] args Arguments that are forwarded to the constructor of the object.
+     * @return Owning pointer to the object.
+     */
+    template<typename U, typename... Args>
+    static PoolPtr<U> make(ObjectPool* pool, Args&&... args);
+
+    /**
+     * @brief Get the number of objects that were created by the pool.
+     * @return Number of objects.
+     */
+    size_t getAllocations() const;
+
+    /**
+     * @brief Get the number of allocations on the general heap, i.e., the number of chunks and objects that exceeded the largest block size.
+     * @return Number of heap allocations.
+     */
+    size_t getHeapAllocations() const;
+
+    /**
+     * @brief Get the number of objects that are currently alive.
+     * @return Number of objects.
+     */
+    size_t getObjects() const;
+};
+
+}   // namespace sim
@@ -0,0 +1,96 @@
+#include "ObjectPool.h"
+
+namespace sim {
+
+template<typename U>
+void PoolDeleter::operator()(U* object) const {
+    object->~U();
+    if (pool != nullptr) {
+        pool->deallocate(object, size);
+    } else {
+        ::operator delete(object);
+    }
+}
+
+inline ObjectPool::ObjectPool() : freeLists(maxBlockSize / blockAlignment + 1, nullptr) { }
+
+inline size_t ObjectPool::sizeClass(size_t size) {
+    return (size + blockAlignment - 1) / blockAlignment;
+}
+
+inline void* ObjectPool::allocate(size_t size) {
+    nAllocations++;
+    nObjects++;
+
+    // objects that exceed the largest size class are allocated on the general heap
+    if (size > maxBlockSize) {
+        nHeapAllocations++;
+        return ::operator new(size);
+    }
+
+    size_t index = sizeClass(size);
+    if (freeLists[index] == nullptr) {
+        // request a new chunk and thread its blocks into the free list of the size class
+        const size_t blockSize = index * blockAlignment;
+        chunks.push_back(std::make_unique<unsigned char[]>(blockSize * blocksPerChunk));
+        nHeapAllocations++;
+        unsigned char* chunk = chunks.back().get();
+        for (size_t i = blocksPerChunk; i > 0; --i) {
+            auto block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize);
+            block->next = freeLists[index];
+            freeLists[index] = block;
+        }
+    }
+
+    FreeBlock* block = freeLists[index];
+    freeLists[index] = block->next;
+    return block;
+}
+
+inline void ObjectPool::deallocate(void* memory, size_t size) {
+    nObjects--;
+
+    if (size > maxBlockSize) {
+        ::operator delete(memory);
+        return;
+    }
+
+    size_t index = sizeClass(size);
+    auto block = static_cast<FreeBlock*>(memory);
+    block->next = freeLists[index];
+    freeLists[index] = block;
+}
+
+template<typename U, typename... Args>
+PoolPtr<U> ObjectPool::create(Args&&... args) {
+    static_assert(sizeof(U) >= sizeof(FreeBlock), "Objects of the pool must be able to hold a free list pointer.");
+    void* memory = allocate(sizeof(U));
+    try {
+        return PoolPtr<U>(new (memory) U(std::forward<Args>(args)...), PoolDeleter{this, sizeof(U)});
+    } catch (...) {
+        deallocate(memory, sizeof(U));
+        throw;
+    }
+}
+
+template<typename U, typename... Args>
+PoolPtr<U> ObjectPool::make(ObjectPool* pool, Args&&... args) {
+    if (pool != nullptr) {
+        return pool->template create<U>(std::forward<Args>(args)...);
+    }
+    return PoolPtr<U>(new U(std::forward<Args>(args)...), PoolDeleter{nullptr, sizeof(U)});
+}
+
+inline size_t ObjectPool::getAllocations() const {
+    return nAllocations;
+}
+
+inline size_t ObjectPool::getHeapAllocations() const {
+    return nHeapAllocations;
+}
+
+inline size_t ObjectPool::getObjects() const {
+    return nObjects;
+}
+
+}   // namespace sim
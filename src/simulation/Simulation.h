@@ -4,28 +4,52 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
+#include <limits>
 #include <math.h>
+#include <functional>
 #include <memory>
+#include <queue>
 #include <string>
 #include <tuple>
+#include <typeinfo>
+#include <utility>
 #include <unordered_map>
 #include <vector>
 
+#include "../nodalAnalysis/NodalAnalysis.h"
+#include "ChannelBoundaryIndex.h"
+#include "Injection.h"
+#include "NodeOccupancyIndex.h"
+#include "ObjectPool.h"
+#include "ThreadPool.h"
+#include "events/EventQueue.h"
+
 namespace arch {
 
 // Forward declared dependencies
 template<typename T>
 class ChannelPosition;
 
+template<typename T>
+class Edge;
+
 template<typename T>
 class Network;
 
+template<typename T>
+class Node;
+
 }
 
 namespace result {
 
 // Forward declared dependencies
+template<typename T>
+class ResultSink;
+
 template<typename T>
 class SimulationResult;
 
@@ -37,6 +61,9 @@ namespace sim {
 template<typename T>
 class Droplet;
 
+template<typename T>
+class DropletGenerator;
+
 template<typename T>
 class DropletInjection;
 
@@ -61,6 +88,13 @@ enum class Platform {
     Mixing          ///< A simulation wit multiple miscible fluids.
 };
 
+enum class RecordingPolicy {
+    All,            ///< Every computed state is saved.
+    EventInterval,  ///< Every n-th computed state is saved, i.e., one state per n events of a droplet simulation.
+    TimeInterval,   ///< States are saved at fixed intervals of the simulated time, the droplet positions are interpolated between the events.
+    Change          ///< A state is only saved if the channels occupied by the droplets or the type of the performed event changed.
+};
+
 /**
  * @brief Class that conducts the simulation and owns all parameters necessary for it.
  */
@@ -71,12 +105,34 @@ private:
     Type simType = Type::Abstract;                                                      ///< The type of simulation that is being done.                                      
     Platform platform = Platform::Continuous;                                           ///< The microfluidic platform that is simulated in this simulation.
     arch::Network<T>* network;                                                          ///< Network for which the simulation should be conducted.
+    std::unique_ptr<ObjectPool> objectPool = std::make_unique<ObjectPool>();           ///< Pool of the events and droplet boundaries (declared first, so that it outlives them; on the heap, so that it keeps its address when the simulation is moved).
+    std::unique_ptr<BoundaryStore<T>> boundaryStore = std::make_unique<BoundaryStore<T>>();  ///< Channel positions, directions and flow rates of the droplet boundaries (declared before the droplets, so that it outlives their boundaries).
+    std::unique_ptr<ChannelBoundaryIndex<T>> boundaryIndex = std::make_unique<ChannelBoundaryIndex<T>>();  ///< Boundaries of the droplets inside the network per channel, sorted by their position.
+    std::unique_ptr<NodeOccupancyIndex<T>> occupancyIndex = std::make_unique<NodeOccupancyIndex<T>>();   ///< Droplets that span over each node.
     std::unordered_map<int, std::unique_ptr<Fluid<T>>> fluids;                          ///< Fluids specified for the simulation.
-    std::unordered_map<int, std::unique_ptr<Droplet<T>>> droplets;                      ///< Droplets which are simulated in droplet simulation.
+    std::unordered_map<int, std::unique_ptr<Droplet<T>>> droplets;                      ///< Active droplets of the droplet simulation, i.e., droplets that are waiting for their injection or are inside the network.
+    std::unordered_map<int, std::unique_ptr<Droplet<T>>> retiredDroplets;               ///< Droplets that reached a sink or were merged into another droplet, only kept for the results.
     std::unordered_map<int, std::unique_ptr<DropletInjection<T>>> dropletInjections;    ///< Injections of droplets that should take place during a droplet simulation.
+    std::unordered_map<int, std::unique_ptr<DropletGenerator<T>>> dropletGenerators;    ///< Generators that periodically inject droplets during a droplet simulation.
+    std::priority_queue<PendingInjection<T>, std::vector<PendingInjection<T>>, std::greater<PendingInjection<T>>> pendingInjections;   ///< Injections and next generator injections that did not take place yet, ordered by their time.
+    int nScheduledInjections = 0;                                                       ///< Number of injections that were added to the pending injections.
     ResistanceModel<T>* resistanceModel;                                                ///< The resistance model used for te simulation.
+    nodal::SolverType solverType = nodal::SolverType::DenseQR;                          ///< The linear solver used in the nodal analysis.
+    int cfdThreads = 1;                                                                 ///< Maximal number of threads that step the CFD modules concurrently (0 = hardware threads).
+    int dropletThreads = 1;                                                             ///< Maximal number of threads that update the droplets of a droplet simulation concurrently (0 = hardware threads).
+    int minDropletsPerThread = 64;                                                      ///< Minimal number of droplets per thread, fewer droplets are updated serially.
+    std::unique_ptr<ThreadPool> threadPool = std::make_unique<ThreadPool>();            ///< Persistent worker threads that update the droplets and step the CFD modules concurrently.
+    bool incrementalNodalUpdates = false;                                               ///< If the nodal analysis applies low-rank updates instead of refactorizing the system.
+    nodal::AcceleratorType acceleratorType = nodal::AcceleratorType::Constant;          ///< Method that accelerates the coupling between the 1D and CFD solvers.
+    int andersonDepth = 5;                                                              ///< Depth of the history of the Anderson mixing.
+    int couplingIterations = 0;                                                         ///< Number of coupling iterations of the last hybrid simulation.
+    std::unique_ptr<nodal::NodalAnalysis<T>> nodalAnalysis = nullptr;                   ///< Persistent nodal analysis that reuses the factorization between solves.
     int continuousPhase = 0;                                                            ///< Fluid of the continuous phase.
     int iteration = 0;
+    bool initialized = false;                                                           ///< If the simulation was initialized, see initialize().
+    bool finished = false;                                                              ///< If the simulation is finished, see isFinished().
+    bool cfdConverged = false;                                                          ///< If all CFD modules of a hybrid simulation have converged in the last coupling iteration.
+    bool pressureConverged = false;                                                     ///< If the pressures of a hybrid simulation have converged in the last coupling iteration.
     int maxIterations = 1e5;
     T maximalAdaptiveTimeStep = 0;                                                      ///< Maximal adaptive time step that is applied when droplets change the channel.
     T time = 0.0;                                                                       ///< Current time of the simulation.
@@ -85,25 +141,133 @@ private:
     T tMax = 100;
     bool eventBasedWriting = false;
     bool dropletsAtBifurcation = false;                                  ///< If one or more droplets are currently at a bifurcation. Triggers the usage of the maximal adaptive time step.
+    EventQueue<T> boundaryEvents;                                                       ///< Boundary events of the droplets inside the network, keyed by droplet and boundary.
+    std::unordered_map<int, std::vector<BoundaryEventState<T>>> boundaryEventStates;    ///< States of the boundaries of each droplet for which its queued events were computed.
+    int nBoundaryEventUpdates = 0;                                                      ///< Number of times the boundary events of a droplet were (re)computed.
+    std::vector<PoolPtr<Event<T>>> events;                                              ///< Events of the current iteration, except for the boundary events.
+    std::unordered_map<int, std::vector<std::pair<arch::RectangularChannel<T>*, T>>> dropletResistances;    ///< Droplet resistances each droplet inside the network contributes to the channels, as of the last update.
+    std::unordered_map<int, std::vector<int>> channelDroplets;                          ///< Ids of the droplets that contribute to the droplet resistance of each channel.
+    std::vector<std::pair<arch::RectangularChannel<T>*, T>> resistanceBuffer;           ///< Droplet resistances of a droplet, reused between updates.
+    std::vector<int> changedChannels;                                                   ///< Ids of the channels whose droplet resistance changed in the last update.
+    std::vector<Droplet<T>*> networkDroplets;                                           ///< Droplets inside the network in the order of the droplet map, reused between iterations.
+    std::vector<char> dropletFlags;                                                     ///< Flag of each droplet in networkDroplets, written by the parallel droplet updates.
+    std::vector<std::vector<Droplet<T>*>> dropletMergeDroplets;                         ///< Merge droplets of the boundaries of each droplet in networkDroplets.
+    std::vector<arch::Node<T>*> stateNodes;                                             ///< Nodes in the order of the pressures in the result store.
+    std::vector<arch::Edge<T>*> stateEdges;                                             ///< Channels and pumps in the order of the flow rates in the result store.
+    std::vector<T> statePressures;                                                      ///< Pressures of the current state, reused between states.
+    std::vector<T> stateFlowRates;                                                      ///< Flow rates of the current state, reused between states.
+    size_t stateNetworkNodes = 0;                                                       ///< Number of nodes of the network when the layout of the saved states was collected.
+    size_t stateNetworkEdges = 0;                                                       ///< Number of channels and pumps of the network when the layout of the saved states was collected.
+    RecordingPolicy recordingPolicy = RecordingPolicy::All;                             ///< Policy that decides which of the computed states are saved.
+    T recordingInterval = 1.0;                                                          ///< Number of events or simulated time in s between the saved states, see setRecordingPolicy.
+    std::vector<int> recordedNodes;                                                     ///< Ids of the nodes whose pressures are saved, all nodes if empty.
+    std::vector<int> recordedEdges;                                                     ///< Ids of the channels and pumps whose flow rates are saved, all channels and pumps if empty.
+    std::vector<int> recordedDroplets;                                                  ///< Sorted ids of the droplets whose positions are saved, all droplets if empty.
+    bool recordDropletPositions = true;                                                 ///< If the positions of the droplets are saved.
+    int nComputedStates = 0;                                                            ///< Number of states that were passed to saveState.
+    int nSamples = 0;                                                                   ///< Number of states that were saved by the time interval policy.
+    bool lastStateSaved = false;                                                        ///< If the last computed state was saved.
+    const std::type_info* lastEventType = nullptr;                                      ///< Type of the last performed event.
+    const std::type_info* stateEventType = nullptr;                                     ///< Type of the last performed event when the last state was computed.
+    std::vector<std::pair<int, int>> stateTopology;                                     ///< Droplet and channel ids of the channels occupied by each droplet when the last state was computed.
+    std::vector<std::pair<int, int>> topologyBuffer;                                    ///< Droplet and channel ids of the current state, reused between states.
+    bool paused = false;                                                                ///< If the last droplet iteration paused before its event, see runUntil.
+    std::vector<T> pauseFlowRates;                                                      ///< Flow rates of the channels and pumps when the simulation paused.
     std::unique_ptr<result::SimulationResult<T>> simulationResult = nullptr;
+    std::unique_ptr<result::ResultSink<T>> resultSink = nullptr;                       ///< Destination of the saved states, a memory sink of simulationResult by default.
 
     /**
-     * @brief Initializes the resistance model and the channel resistances of the empty channels.
+     * @brief Conduct the nodal analysis of a continuous simulation and store its result. Finishes the simulation.
      */
-    void initialize();
+    void stepContinuous();
+
+    /**
+     * @brief Conduct one coupling iteration between the CFD modules and the nodal analysis of a hybrid simulation.
+     * Finishes the simulation and stores its result when the pressures and all modules have converged.
+     */
+    void stepHybrid();
+
+    /**
+     * @brief Conduct one iteration of the event loop of a droplet simulation, i.e., compute the flow and the next event, move the droplets
+     * until the event and perform it. Finishes the simulation if no event is left.
+     * @param[in] endTime Time in s at which the simulation pauses. If the next event takes place later, the droplets are only moved until this time.
+     * @return If an event was performed.
+     */
+    bool stepDroplets(T endTime);
+
+    /**
+     * @brief Check if a droplet can be injected at a position, i.e., if the channel is able to fully contain the droplet.
+     * @param[in] name Name of the droplet or generator for the error message.
+     * @param[in] volume Volume of the droplet in m^3.
+     * @param[in] channel Channel in which the droplet should be injected.
+     * @param[in] injectionPosition Position of the middle of the droplet (relative to the channel length between 0.0 and 1.0).
+     */
+    void checkInjection(const std::string& name, T volume, arch::RectangularChannel<T>* channel, T injectionPosition) const;
+
+    /**
+     * @brief Add the next injection of a generator to the pending injections, if the generator is not finished.
+     * @param[in] generator The generator.
+     */
+    void scheduleGenerator(DropletGenerator<T>* generator);
 
     /**
      * @brief Update the droplet resistances of the channels based on the current positions of the droplets.
+     * Only the channels for which the contribution of a droplet changed since the last update are recomputed.
      */
     void updateDropletResistances();
 
     /**
-     * @brief Compute all possible next events.
+     * @brief Remove the droplet resistances of all droplets from the channels and from the contributions of the last update.
+     */
+    void resetDropletResistances();
+
+    /**
+     * @brief Start the threads of the pool for the larger of the CFD and droplet thread counts, if the pool has a different size.
+     */
+    void updateThreadPool();
+
+    /**
+     * @brief Move the droplets that reached a sink or were merged into another droplet from the active droplets to the retired droplets
+     * and drop their boundary events. Has to be called after their droplet resistances were removed by updateDropletResistances.
+     */
+    void retireDroplets();
+
+    /**
+     * @brief Collect the droplets inside the network in networkDroplets.
+     */
+    void collectNetworkDroplets();
+
+    /**
+     * @brief Update the flow rates of the boundaries of all droplets inside the network.
+     * The droplets only read the channel flow rates and write their own boundaries, hence they are updated concurrently (see setDropletThreads).
+     * dropletsAtBifurcation is updated afterwards in the order of the droplets.
      */
-    std::vector<std::unique_ptr<Event<T>>> computeEvents();
+    void updateDroplets();
+
+    /**
+     * @brief Compute all possible next events, except for the boundary events of the droplets, and store them in events.
+     * The boundary events are kept in the boundaryEvents queue and only recomputed for droplets whose boundaries changed.
+     */
+    void computeEvents();
+
+    /**
+     * @brief Checks if a boundary of the droplet changed since its boundary events were computed, e.g., its flow rate after the last nodal analysis.
+     * @param[in] droplet The droplet.
+     * @param[in] mergeDroplets Droplet at the opposite reference node of each boundary that moves away from the droplet center, nullptr otherwise.
+     * @return If the boundary events of the droplet have to be recomputed.
+     */
+    bool boundariesChanged(Droplet<T>* droplet, const std::vector<Droplet<T>*>& mergeDroplets);
+
+    /**
+     * @brief Recompute the boundary events of a droplet and store the states of its boundaries.
+     * @param[in] droplet The droplet.
+     * @param[in] mergeDroplets Droplet at the opposite reference node of each boundary that moves away from the droplet center, nullptr otherwise.
+     */
+    void updateBoundaryEvents(Droplet<T>* droplet, const std::vector<Droplet<T>*>& mergeDroplets);
 
     /**
      * @brief Moves all droplets according to the given time step.
+     * The boundaries of all droplets inside the network are moved at once in the boundary store (see BoundaryStore::move).
      * @param[in] timeStep to which the droplets should be moved to.
      */
     void moveDroplets(T timeStep);
@@ -121,10 +285,46 @@ private:
     void storeSimulationResults(result::SimulationResult<T>& result);
 
     /**
-     * @brief Store the current simulation state in simulationResult.
+     * @brief Collect the nodes and edges of the network sorted by their ids, which defines the layout of the result store.
+     */
+    void updateStateLayout();
+
+    /**
+     * @brief Pass the current simulation state to the result sink.
+     * @param[in] stateTime Time of the state in s.
+     * @param[in] timeStep Time in s for which the droplets are moved ahead of their current positions, so that states between two events
+     * can be saved without moving the droplets of the simulation.
+    */
+    void writeState(T stateTime, T timeStep);
+
+    /**
+     * @brief Check if the channels occupied by the droplets changed since the last computed state.
+     * @return If the occupied channels changed.
+     */
+    bool topologyChanged();
+
+    /**
+     * @brief Check if the flow rates of the channels and pumps changed since the last check, e.g., because the network was changed while the simulation was paused.
+     * @return If the flow rates changed.
+     */
+    bool flowRatesChanged();
+
+    /**
+     * @brief Save the current simulation state, if the recording policy selects it. Has to be called whenever a new state was computed.
     */
     void saveState();
 
+    /**
+     * @brief Save the states of the time interval policy that lie between the current time and the next event (or pause).
+     * @param[in] timeStep Time in s until the next event (or pause).
+     */
+    void saveSamples(T timeStep);
+
+    /**
+     * @brief Save the last computed state, if it was not saved yet, so that the results always contain the final state, and finish the result sink.
+     */
+    void finishResult();
+
 public:
     /**
      * @brief Creates simulation.
@@ -158,6 +358,20 @@ public:
      */
     DropletInjection<T>* addDropletInjection(int dropletId, T injectionTime, int channelId, T injectionPosition);
 
+    /**
+     * @brief Create a droplet generator that periodically injects droplets. The droplets are only created when their injection takes place.
+     * @param[in] fluidId Unique identifier of the fluid the droplets consist of.
+     * @param[in] volume Volume of the droplets in m^3.
+     * @param[in] channelId Id of the channel, where the droplets should be injected.
+     * @param[in] injectionPosition Position inside the channel at which the droplets should be injected (relative to the channel length between 0.0 and 1.0).
+     * @param[in] startTime Time of the first injection in s.
+     * @param[in] period Time between two injections in s.
+     * @param[in] count Number of droplets to inject, negative for an unlimited number (requires an end time).
+     * @param[in] endTime Time after which no droplets are injected anymore in s, negative for no end time.
+     * @return Pointer to created generator.
+     */
+    DropletGenerator<T>* addDropletGenerator(int fluidId, T volume, int channelId, T injectionPosition, T startTime, T period, int count, T endTime = -1.0);
+
     /**
      * @brief Set the platform of the simulation.
      * @param[in] platform
@@ -212,6 +426,102 @@ public:
      */
     void setResistanceModel(ResistanceModel<T>* model);
 
+    /**
+     * @brief Define which linear solver should be used in the nodal analysis of the network.
+     * @param[in] solver The linear solver to be used.
+     */
+    void setSolverType(nodal::SolverType solver);
+
+    /**
+     * @brief Define whether the nodal analysis should update its last factorization with low-rank corrections for changed channel resistances (sparse solver only).
+     * @param[in] incremental If low-rank updates are used.
+     */
+    void setIncrementalNodalUpdates(bool incremental);
+
+    /**
+     * @brief Define the maximal number of threads that step the CFD modules of a hybrid simulation concurrently.
+     * The modules are stepped serially by default. The results do not depend on the number of threads. The threads are shared
+     * with the droplet updates (see setDropletThreads) and the vtk and convergence output of the modules is serialized.
+     * @param[in] nThreads Number of threads. 0 uses the number of hardware threads, 1 steps the modules serially.
+     */
+    void setCFDThreads(int nThreads);
+
+    /**
+     * @brief Define the maximal number of threads that update the boundaries of the droplets and check their boundary events concurrently
+     * in a droplet simulation. The results do not depend on the number of threads.
+     * @param[in] nThreads Number of threads. 0 uses the number of hardware threads, 1 updates the droplets serially.
+     * @param[in] minDropletsPerThread Minimal number of droplets per thread, so that small simulations do not pay for waking the workers.
+     */
+    void setDropletThreads(int nThreads, int minDropletsPerThread = 64);
+
+    /**
+     * @brief Store the states of the simulation in a delta-encoded history, i.e., keyframes and the changed values in between,
+     * instead of storing every value of every state. Has to be set before the simulation is started.
+     * @param[in] keyframeInterval Number of states per keyframe.
+     * @param[in] tolerance Relative change of a pressure or flow rate, above which it is stored (0.0 stores every change).
+     */
+    void setDeltaHistory(int keyframeInterval, T tolerance = 0.0);
+
+    /**
+     * @brief Define the destination of the saved states, e.g., a porting::JsonResultSink that streams the states into a file
+     * instead of keeping them in the simulation result. Has to be set before the simulation is started.
+     * @param[in] sink The result sink, which is owned by the simulation. nullptr keeps the states in the simulation result.
+     */
+    void setResultSink(std::unique_ptr<result::ResultSink<T>> sink);
+
+    /**
+     * @brief Get the destination of the saved states.
+     * @return Pointer to the result sink.
+     */
+    result::ResultSink<T>* getResultSink();
+
+    /**
+     * @brief Define which of the computed states are saved. The final state is always saved. Has to be set before the simulation is started.
+     * @param[in] policy Recording policy.
+     * @param[in] interval Number of events between the saved states (EventInterval) or simulated time in s between the saved states (TimeInterval),
+     * ignored by the other policies.
+     */
+    void setRecordingPolicy(RecordingPolicy policy, T interval = 1.0);
+
+    /**
+     * @brief Get the policy that decides which of the computed states are saved.
+     * @return Recording policy.
+     */
+    RecordingPolicy getRecordingPolicy() const;
+
+    /**
+     * @brief Define the nodes whose pressures are saved. Has to be set before the simulation is started.
+     * @param[in] nodeIds Ids of the nodes. An empty vector saves the pressures of all nodes.
+     */
+    void setRecordedNodes(std::vector<int> nodeIds);
+
+    /**
+     * @brief Define the channels and pumps whose flow rates are saved. Has to be set before the simulation is started.
+     * @param[in] edgeIds Ids of the channels and pumps. An empty vector saves the flow rates of all channels and pumps.
+     */
+    void setRecordedChannels(std::vector<int> edgeIds);
+
+    /**
+     * @brief Define the droplets whose positions are saved. Has to be set before the simulation is started.
+     * @param[in] dropletIds Ids of the droplets. An empty vector saves the positions of all droplets. Droplets that are created during
+     * the simulation (e.g., by merges or droplet generators) are only saved if their ids are listed.
+     */
+    void setRecordedDroplets(std::vector<int> dropletIds);
+
+    /**
+     * @brief Define if the positions of the droplets are saved, e.g., to only save the pressures and flow rates of the recorded nodes and channels.
+     * Has to be set before the simulation is started.
+     * @param[in] record If the droplet positions are saved.
+     */
+    void setRecordDropletPositions(bool record);
+
+    /**
+     * @brief Define which method should accelerate the fixed-point iteration between the 1D and CFD solvers of a hybrid simulation.
+     * @param[in] acceleratorType Coupling accelerator.
+     * @param[in] andersonDepth Depth of the history of the Anderson mixing.
+     */
+    void setCouplingAccelerator(nodal::AcceleratorType acceleratorType, int andersonDepth=5);
+
     /**
      * @brief Get the platform of the simulation.
      * @return platform of the simulation
@@ -224,6 +534,24 @@ public:
      */
     Type getType();
 
+    /**
+     * @brief Get the linear solver that is used in the nodal analysis.
+     * @return linear solver of the simulation
+     */
+    nodal::SolverType getSolverType();
+
+    /**
+     * @brief Get the method that accelerates the coupling between the 1D and CFD solvers.
+     * @return coupling accelerator of the simulation
+     */
+    nodal::AcceleratorType getCouplingAccelerator();
+
+    /**
+     * @brief Get the number of coupling iterations between the 1D and CFD solvers until the last hybrid simulation converged.
+     * @return Number of coupling iterations.
+     */
+    int getCouplingIterations();
+
     /**
      * @brief Set the type of the simulation.
      * @param[in] type
@@ -252,18 +580,32 @@ public:
 
     /**
      * @brief Get droplet
-     * @param dropletId Id of the droplet
+     * @param dropletId Id of the droplet (active or retired)
      * @return Pointer to droplet with the corresponding id
      */
     Droplet<T>* getDroplet(int dropletId);
 
     /**
-     * @brief Gets droplet that is present at the corresponding node (i.e., the droplet spans over this node).
+     * @brief Get the droplets that reached a sink or were merged into another droplet during the simulation.
+     * @return Reference to the retired droplets.
+     */
+    const std::unordered_map<int, std::unique_ptr<Droplet<T>>>& getRetiredDroplets() const;
+
+    /**
+     * @brief Gets droplet that is present at the corresponding node (i.e., the droplet spans over this node) from the occupancy index.
      * @param nodeId The id of the node
      * @return Pointer to droplet or nullptr if no droplet was found
      */
     Droplet<T>* getDropletAtNode(int nodeId);
 
+    /**
+     * @brief Gets droplet that is present at the corresponding node by a scan over all droplets, which validates the occupancy index.
+     * getDropletAtNode compares both on every lookup if CHECK_OCCUPANCY_INDEX is defined.
+     * @param nodeId The id of the node
+     * @return Pointer to droplet or nullptr if no droplet was found
+     */
+    Droplet<T>* scanDropletAtNode(int nodeId);
+
     /**
      * @brief Get injection
      * @param injectionId The id of the injection
@@ -271,6 +613,13 @@ public:
      */
     DropletInjection<T>* getDropletInjection(int injectionId);
 
+    /**
+     * @brief Get droplet generator
+     * @param generatorId The id of the generator
+     * @return Pointer to generator with the corresponding id.
+     */
+    DropletGenerator<T>* getDropletGenerator(int generatorId);
+
     /**
      * @brief Get the continuous phase.
      * @return Fluid if the continuous phase or nullptr if no continuous phase is specified.
@@ -283,6 +632,37 @@ public:
      */
     result::SimulationResult<T>* getSimulationResults();
 
+    /**
+     * @brief Get the number of times the boundary events of a droplet were (re)computed during the simulation.
+     * @return Number of boundary event updates.
+     */
+    int getBoundaryEventUpdates();
+
+    /**
+     * @brief Get the pool in which the events and droplet boundaries of the simulation are created.
+     * @return Reference to the object pool.
+     */
+    const ObjectPool& getObjectPool() const;
+
+    /**
+     * @brief Get the index of the droplet boundaries per channel, which is used to detect merging inside channels.
+     * @return Reference to the channel boundary index.
+     */
+    const ChannelBoundaryIndex<T>& getBoundaryIndex() const;
+
+    /**
+     * @brief Get the channels whose droplet resistance changed in the last update of the droplet resistances.
+     * These are reported to the nodal analysis, so that its low-rank updates only need to consider these channels.
+     * @return Ids of the changed channels, in ascending order.
+     */
+    const std::vector<int>& getChangedChannels() const;
+
+    /**
+     * @brief Get the nodal analysis of the simulation.
+     * @return Pointer to the nodal analysis or nullptr if the simulation was not initialized yet.
+     */
+    nodal::NodalAnalysis<T>* getNodalAnalysis();
+
     /**
      * @brief Creates a new fluid out of two existing fluids.
      * @param fluid0Id Id of the first fluid.
@@ -303,7 +683,48 @@ public:
     Droplet<T>* mergeDroplets(int droplet0Id, int droplet1Id);
 
     /**
-     * @brief Conduct the simulation.
+     * @brief Initialize the simulation, i.e., the nodal analysis and the channel lengths and resistances, the CFD modules of a hybrid simulation
+     * (which are iterated until they have converged) and the event loop of a droplet simulation. Called by simulate() and by the first step().
+     */
+    void initialize();
+
+    /**
+     * @brief Conduct the next step of the simulation, i.e., the single nodal analysis of a continuous simulation, one coupling iteration of a hybrid
+     * simulation or one event of a droplet simulation. Between two steps the network (e.g., the pump values) can be observed and modified.
+     * @return If a step was conducted, false if the simulation is already finished.
+     */
+    bool step();
+
+    /**
+     * @brief Conduct the next steps of the simulation, until a number of steps was conducted or the simulation is finished.
+     * @param[in] nSteps Number of steps, i.e., of events in a droplet simulation.
+     * @return Number of conducted steps.
+     */
+    int runEvents(int nSteps);
+
+    /**
+     * @brief Conduct the simulation until a point in time or until it is finished. A droplet simulation pauses at this time, i.e., the
+     * droplets are moved until the time and the next event takes place in a following step. A pause neither counts as an iteration nor
+     * stores an additional state, hence conducting the simulation in several parts leads to the same results. Continuous and hybrid simulations are steady,
+     * hence they are conducted until they are finished.
+     * @param[in] endTime Time in s elapsed since the start of the simulation.
+     */
+    void runUntil(T endTime);
+
+    /**
+     * @brief Check if the simulation is finished, i.e., if a steady simulation has converged or if no event is left in a droplet simulation.
+     * @return If the simulation is finished.
+     */
+    bool isFinished() const;
+
+    /**
+     * @brief Get the current time of the simulation.
+     * @return Time in s elapsed since the start of the simulation.
+     */
+    T getTime() const;
+
+    /**
+     * @brief Conduct the simulation until it is finished.
      * @return The result of the simulation containing all intermediate simulation steps and calculated parameters.
      */
     void simulate();
@@ -5,6 +5,7 @@ namespace sim {
     template<typename T>
     Simulation<T>::Simulation() {
         this->simulationResult = std::make_unique<result::SimulationResult<T>>();
+        this->resultSink = std::make_unique<result::MemorySink<T>>(simulationResult.get());
     }
 
     template<typename T>
@@ -18,27 +19,23 @@ namespace sim {
 
     template<typename T>
     Droplet<T>* Simulation<T>::addDroplet(int fluidId, T volume) {
-        auto id = droplets.size();
+        auto id = droplets.size() + retiredDroplets.size();
         auto fluid = fluids.at(fluidId).get();
 
-        auto result = droplets.insert_or_assign(id, std::make_unique<Droplet<T>>(id, volume, fluid));
+        auto result = droplets.insert_or_assign(id, std::make_unique<Droplet<T>>(id, volume, fluid, objectPool.get(), boundaryIndex.get(), occupancyIndex.get(), boundaryStore.get()));
 
         return result.first->second.get();
     }
 
     template<typename T>
-    DropletInjection<T>* Simulation<T>::addDropletInjection(int dropletId, T injectionTime, int channelId, T injectionPosition) {
-        auto id = dropletInjections.size();
-        auto droplet = droplets.at(dropletId).get();
-        auto channel = network->getChannel(channelId);
-
+    void Simulation<T>::checkInjection(const std::string& name, T volume, arch::RectangularChannel<T>* channel, T injectionPosition) const {
         // --- check if injection is valid ---
         // for the injection the head and tail of the droplet must lie inside the channel (the volume of the droplet must be small enough)
         // the droplet length is a relative value between 0 and 1
-        T dropletLength = droplet->getVolume() / channel->getVolume();
+        T dropletLength = volume / channel->getVolume();
         // channel must be able to fully contain the droplet
         if (dropletLength >= 1.0) {
-            throw std::invalid_argument("Injection of droplet " + droplet->getName() + " into channel " + std::to_string(channel->getId()) + " is not valid. Channel must be able to fully contain the droplet.");
+            throw std::invalid_argument("Injection of droplet " + name + " into channel " + std::to_string(channel->getId()) + " is not valid. Channel must be able to fully contain the droplet.");
         }
         
         // compute tail and head position of the droplet
@@ -46,13 +43,53 @@ namespace sim {
         T head = (injectionPosition + dropletLength / 2);
         // tail and head must not be outside the channel (can happen when the droplet is injected at the beginning or end of the channel)
         if (tail < 0 || head > 1.0) {
-            throw std::invalid_argument("Injection of droplet " + droplet->getName() + " is not valid. Tail and head of the droplet must lie inside the channel " + std::to_string(channel->getId()) + ". Consider to set the injection position in the middle of the channel.");
+            throw std::invalid_argument("Injection of droplet " + name + " is not valid. Tail and head of the droplet must lie inside the channel " + std::to_string(channel->getId()) + ". Consider to set the injection position in the middle of the channel.");
         }
+    }
+
+    template<typename T>
+    DropletInjection<T>* Simulation<T>::addDropletInjection(int dropletId, T injectionTime, int channelId, T injectionPosition) {
+        auto id = dropletInjections.size();
+        auto droplet = droplets.at(dropletId).get();
+        auto channel = network->getChannel(channelId);
+
+        checkInjection(droplet->getName(), droplet->getVolume(), channel, injectionPosition);
 
         auto result = dropletInjections.insert_or_assign(id, std::make_unique<DropletInjection<T>>(id, droplet, injectionTime, channel, injectionPosition));
+        pendingInjections.push({ injectionTime, nScheduledInjections++, result.first->second.get(), nullptr, 0 });
         return result.first->second.get();
     }
 
+    template<typename T>
+    DropletGenerator<T>* Simulation<T>::addDropletGenerator(int fluidId, T volume, int channelId, T injectionPosition, T startTime, T period, int count, T endTime) {
+        auto id = dropletGenerators.size();
+        auto fluid = fluids.at(fluidId).get();
+        auto channel = network->getChannel(channelId);
+
+        if (count < 0 && endTime < 0) {
+            throw std::invalid_argument("Droplet generator " + std::to_string(id) + " is not valid. Either the number of droplets or an end time must be specified.");
+        }
+        if (period <= 0 && count != 1) {
+            throw std::invalid_argument("Droplet generator " + std::to_string(id) + " is not valid. The period between two injections must be positive.");
+        }
+        checkInjection("of generator " + std::to_string(id), volume, channel, injectionPosition);
+
+        auto result = dropletGenerators.insert_or_assign(id, std::make_unique<DropletGenerator<T>>(id, fluid, volume, channel, injectionPosition, startTime, period, count));
+        auto generator = result.first->second.get();
+        if (endTime >= 0) {
+            generator->setEndTime(endTime);
+        }
+        scheduleGenerator(generator);
+        return generator;
+    }
+
+    template<typename T>
+    void Simulation<T>::scheduleGenerator(DropletGenerator<T>* generator) {
+        if (!generator->isFinished()) {
+            pendingInjections.push({ generator->getNextInjectionTime(), nScheduledInjections++, nullptr, generator, generator->getInjectedDroplets() });
+        }
+    }
+
     template<typename T>
     void Simulation<T>::setPlatform(Platform platform_) {
         this->platform = platform_;
@@ -81,6 +118,7 @@ namespace sim {
     template<typename T>
     void Simulation<T>::setDroplets(std::unordered_map<int, std::unique_ptr<Droplet<T>>> droplets_) {
         this->droplets = std::move(droplets_);
+        this->retiredDroplets.clear();
     }
 
     template<typename T>
@@ -98,6 +136,123 @@ namespace sim {
         this->resistanceModel = model_;
     }
 
+    template<typename T>
+    void Simulation<T>::setSolverType(nodal::SolverType solver_) {
+        this->solverType = solver_;
+        if (nodalAnalysis != nullptr) {
+            nodalAnalysis->setSolverType(solver_);
+        }
+    }
+
+    template<typename T>
+    void Simulation<T>::setCFDThreads(int nThreads_) {
+        if (nThreads_ < 0) {
+            throw std::invalid_argument("The number of CFD threads cannot be negative.");
+        }
+        this->cfdThreads = nThreads_;
+        updateThreadPool();
+    }
+
+    template<typename T>
+    void Simulation<T>::setDropletThreads(int nThreads_, int minDropletsPerThread_) {
+        if (nThreads_ < 0) {
+            throw std::invalid_argument("The number of droplet threads cannot be negative.");
+        }
+        if (minDropletsPerThread_ < 1) {
+            throw std::invalid_argument("The minimal number of droplets per thread must be positive.");
+        }
+        this->dropletThreads = nThreads_;
+        this->minDropletsPerThread = minDropletsPerThread_;
+        updateThreadPool();
+    }
+
+    template<typename T>
+    void Simulation<T>::updateThreadPool() {
+        // the workers are started once and shared by the droplet updates and the CFD modules
+        const int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        const int nThreads = std::max((cfdThreads == 0) ? hardwareThreads : cfdThreads, (dropletThreads == 0) ? hardwareThreads : dropletThreads);
+        if (threadPool->getNumberOfThreads() != nThreads) {
+            threadPool = std::make_unique<ThreadPool>(nThreads);
+        }
+    }
+
+    template<typename T>
+    void Simulation<T>::setDeltaHistory(int keyframeInterval, T tolerance) {
+        simulationResult->setDeltaHistory(keyframeInterval, tolerance);
+    }
+
+    template<typename T>
+    void Simulation<T>::setResultSink(std::unique_ptr<result::ResultSink<T>> sink) {
+        if (sink == nullptr) {
+            sink = std::make_unique<result::MemorySink<T>>(simulationResult.get());
+        }
+        this->resultSink = std::move(sink);
+    }
+
+    template<typename T>
+    result::ResultSink<T>* Simulation<T>::getResultSink() {
+        return resultSink.get();
+    }
+
+    template<typename T>
+    void Simulation<T>::setRecordingPolicy(RecordingPolicy policy, T interval) {
+        if (policy == RecordingPolicy::EventInterval && (interval < 1 || interval != std::floor(interval))) {
+            throw std::invalid_argument("The number of events between the saved states must be a positive integer.");
+        }
+        if (policy == RecordingPolicy::TimeInterval && !(interval > 0.0)) {
+            throw std::invalid_argument("The time between the saved states must be positive.");
+        }
+        this->recordingPolicy = policy;
+        this->recordingInterval = interval;
+    }
+
+    template<typename T>
+    RecordingPolicy Simulation<T>::getRecordingPolicy() const {
+        return recordingPolicy;
+    }
+
+    template<typename T>
+    void Simulation<T>::setRecordedNodes(std::vector<int> nodeIds) {
+        this->recordedNodes = std::move(nodeIds);
+    }
+
+    template<typename T>
+    void Simulation<T>::setRecordedChannels(std::vector<int> edgeIds) {
+        this->recordedEdges = std::move(edgeIds);
+    }
+
+    template<typename T>
+    void Simulation<T>::setRecordedDroplets(std::vector<int> dropletIds) {
+        std::sort(dropletIds.begin(), dropletIds.end());
+        dropletIds.erase(std::unique(dropletIds.begin(), dropletIds.end()), dropletIds.end());
+        this->recordedDroplets = std::move(dropletIds);
+    }
+
+    template<typename T>
+    void Simulation<T>::setRecordDropletPositions(bool record) {
+        this->recordDropletPositions = record;
+    }
+
+    template<typename T>
+    void Simulation<T>::setIncrementalNodalUpdates(bool incremental_) {
+        this->incrementalNodalUpdates = incremental_;
+        if (nodalAnalysis != nullptr) {
+            nodalAnalysis->setIncrementalUpdates(incremental_);
+        }
+    }
+
+    template<typename T>
+    void Simulation<T>::setCouplingAccelerator(nodal::AcceleratorType acceleratorType_, int andersonDepth_) {
+        if (andersonDepth_ < 1) {
+            throw std::invalid_argument("The depth of the Anderson mixing must be at least 1.");
+        }
+        this->acceleratorType = acceleratorType_;
+        this->andersonDepth = andersonDepth_;
+        if (nodalAnalysis != nullptr) {
+            nodalAnalysis->setCouplingAccelerator(acceleratorType_, andersonDepth_);
+        }
+    }
+
     template<typename T>
     Platform Simulation<T>::getPlatform() {
         return this->platform;
@@ -108,6 +263,21 @@ namespace sim {
         return this->simType;
     }
 
+    template<typename T>
+    nodal::SolverType Simulation<T>::getSolverType() {
+        return this->solverType;
+    }
+
+    template<typename T>
+    nodal::AcceleratorType Simulation<T>::getCouplingAccelerator() {
+        return this->acceleratorType;
+    }
+
+    template<typename T>
+    int Simulation<T>::getCouplingIterations() {
+        return this->couplingIterations;
+    }
+
     template<typename T>
     int Simulation<T>::getFixtureId() {
         return this->fixtureId;
@@ -130,11 +300,33 @@ namespace sim {
 
     template<typename T>
     Droplet<T>* Simulation<T>::getDroplet(int dropletId) {
-        return droplets.at(dropletId).get();
+        auto droplet = droplets.find(dropletId);
+        if (droplet != droplets.end()) {
+            return droplet->second.get();
+        }
+        return retiredDroplets.at(dropletId).get();
+    }
+
+    template<typename T>
+    const std::unordered_map<int, std::unique_ptr<Droplet<T>>>& Simulation<T>::getRetiredDroplets() const {
+        return retiredDroplets;
     }
 
     template<typename T>
     Droplet<T>* Simulation<T>::getDropletAtNode(int nodeId) {
+        auto droplet = occupancyIndex->getDroplet(nodeId);
+
+        // validate the occupancy index against a scan of all droplets (several droplets can only span over the same node
+        // right before they merge, hence only the presence of a droplet is compared), the scan is only done on request
+        #ifdef CHECK_OCCUPANCY_INDEX
+            assert((droplet == nullptr) == (scanDropletAtNode(nodeId) == nullptr));
+        #endif
+
+        return droplet;
+    }
+
+    template<typename T>
+    Droplet<T>* Simulation<T>::scanDropletAtNode(int nodeId) {
         // loop through all droplets
         for (auto& [id, droplet] : droplets) {
             // do not consider droplets which are not inside the network
@@ -169,6 +361,11 @@ namespace sim {
         return dropletInjections.at(injectionId).get();
     }
 
+    template<typename T>
+    DropletGenerator<T>* Simulation<T>::getDropletGenerator(int generatorId) {
+        return dropletGenerators.at(generatorId).get();
+    }
+
     template<typename T>
     Fluid<T>* Simulation<T>::getContinuousPhase() {
         return fluids[continuousPhase].get();
@@ -179,6 +376,31 @@ namespace sim {
         return simulationResult.get();
     }
 
+    template<typename T>
+    int Simulation<T>::getBoundaryEventUpdates() {
+        return this->nBoundaryEventUpdates;
+    }
+
+    template<typename T>
+    const ObjectPool& Simulation<T>::getObjectPool() const {
+        return *this->objectPool;
+    }
+
+    template<typename T>
+    const ChannelBoundaryIndex<T>& Simulation<T>::getBoundaryIndex() const {
+        return *this->boundaryIndex;
+    }
+
+    template<typename T>
+    const std::vector<int>& Simulation<T>::getChangedChannels() const {
+        return changedChannels;
+    }
+
+    template<typename T>
+    nodal::NodalAnalysis<T>* Simulation<T>::getNodalAnalysis() {
+        return nodalAnalysis.get();
+    }
+
     template<typename T>
     Fluid<T>* Simulation<T>::mixFluids(int fluid0Id, T volume0, int fluid1Id, T volume1) {
         // check if fluids are identically (no merging needed) and if they exist
@@ -216,7 +438,7 @@ namespace sim {
         // check if droplets are identically (no merging needed) and if they exist
         if (droplet0Id == droplet1Id) {
             // try to get the droplet (throws error if the droplet is not present)
-            return droplets.at(droplet0Id).get();
+            return getDroplet(droplet0Id);
         }
 
         // get droplets
@@ -248,132 +470,239 @@ namespace sim {
         initialize();
         //printResults();
 
-        // 1D continuous simulation
-        // ##########
-        // * conduct nodal analysis
-        // * save state
-        if (simType == Type::Abstract && platform == Platform::Continuous) {
-            // compute nodal analysis
-            nodal::conductNodalAnalysis(network);
+        // conduct all steps of the simulation
+        while (!finished) {
+            step();
+        }
+    }
 
-            // store simulation results of current state
-            saveState();
+    template<typename T>
+    bool Simulation<T>::step() {
+        if (!initialized) {
+            initialize();
+        }
+        if (finished) {
+            return false;
         }
 
-        // Continuous Hybrid simulation
-        if (this->simType == Type::Hybrid && this->platform == Platform::Continuous) {
-            if (network->getModules().size() > 0 ) {
-                bool allConverged = false;
-                bool pressureConverged = false;
+        if (simType == Type::Abstract && platform == Platform::Continuous) {
+            stepContinuous();
+        } else if (simType == Type::Hybrid && platform == Platform::Continuous) {
+            stepHybrid();
+        } else if (simType == Type::Abstract && platform == Platform::BigDroplet) {
+            stepDroplets(std::numeric_limits<T>::max());
+        } else {
+            // nothing to simulate
+            finished = true;
+        }
+        if (finished) {
+            finishResult();
+        }
+        return true;
+    }
 
-                // Initialization of CFD domains
-                while (! allConverged) {
-                    allConverged = conductCFDSimulation(this->network, 1);
-                }
+    template<typename T>
+    int Simulation<T>::runEvents(int nSteps) {
+        int steps = 0;
+        while (steps < nSteps && step()) {
+            steps++;
+        }
+        return steps;
+    }
 
-                while (! allConverged || !pressureConverged) {
-                    //std::cout << "######################## Simulation Iteration no. " << iter << " ####################" << std::endl;
+    template<typename T>
+    void Simulation<T>::runUntil(T endTime) {
+        if (!initialized) {
+            initialize();
+        }
+        if (simType == Type::Abstract && platform == Platform::BigDroplet) {
+            while (!finished && time < endTime) {
+                stepDroplets(endTime);
+            }
+            if (finished) {
+                finishResult();
+            }
+        } else {
+            // steady simulations do not advance in time
+            while (step()) { }
+        }
+    }
 
-                    // conduct CFD simulations
-                    //std::cout << "[Simulation] Conduct CFD simulation " << iter <<"..." << std::endl;
-                    allConverged = conductCFDSimulation(this->network, 10);
-                
-                    // compute nodal analysis again
-                    //std::cout << "[Simulation] Conduct nodal analysis " << iter <<"..." << std::endl;
-                    pressureConverged = nodal::conductNodalAnalysis(this->network);
+    template<typename T>
+    bool Simulation<T>::isFinished() const {
+        return finished;
+    }
 
-                }
+    template<typename T>
+    T Simulation<T>::getTime() const {
+        return time;
+    }
 
-                #ifdef VERBOSE     
-                    if (pressureConverged && allConverged) {
-                        std::cout << "[Simulation] All pressures have converged." << std::endl;
-                    } 
-                    printResults();
-                #endif
-            }
-            saveState();
-        }
+    // 1D continuous simulation
+    // ##########
+    // * conduct nodal analysis
+    // * save state
+    template<typename T>
+    void Simulation<T>::stepContinuous() {
+        // compute nodal analysis
+        nodalAnalysis->conductNodalAnalysis();
 
-        // 1D Droplet simulation
-        // ##########
-        // Simulation Loop
-        // ##########
-        // * update droplet resistances
-        // * conduct nodal analysis
-        // * update droplets (flow rates of boundaries)
-        // * compute events
-        // * search for next event (break if no event is left)
-        // * move droplets
-        // * perform event
-        if (simType == Type::Abstract && platform == Platform::BigDroplet) {
+        // store simulation results of current state
+        saveState();
+        finished = true;
+    }
 
-            while (true) {
-                if (iteration >= maxIterations) {
-                    throw "Max iterations exceeded.";
-                }
+    // Continuous Hybrid simulation
+    // ##########
+    // * conduct CFD simulations
+    // * conduct nodal analysis
+    // * save state when the CFD modules and the pressures have converged
+    template<typename T>
+    void Simulation<T>::stepHybrid() {
+        if (network->getModules().size() > 0) {
+            //std::cout << "######################## Simulation Iteration no. " << iter << " ####################" << std::endl;
 
-                #ifdef VERBOSE     
-                    std::cout << "Iteration " << iteration << std::endl;
-                #endif
-                // update droplet resistances (in the first iteration no  droplets are inside the network)
-                updateDropletResistances();
-                // compute nodal analysis
-                nodal::conductNodalAnalysis(network);
-                // update droplets, i.e., their boundary flow rates
-                // loop over all droplets
-                dropletsAtBifurcation = false;
-                for (auto& [key, droplet] : droplets) {
-                    // only consider droplets inside the network
-                    if (droplet->getDropletState() != DropletState::NETWORK) {
-                        continue;
-                    }
+            // conduct CFD simulations
+            //std::cout << "[Simulation] Conduct CFD simulation " << iter <<"..." << std::endl;
+            cfdConverged = conductCFDSimulation(this->network, threadPool.get(), cfdThreads);
+        
+            // compute nodal analysis again
+            //std::cout << "[Simulation] Conduct nodal analysis " << iter <<"..." << std::endl;
+            pressureConverged = nodalAnalysis->conductNodalAnalysis();
+            couplingIterations++;
 
-                    // set to true if droplet is at bifurcation
-                    if (droplet->isAtBifurcation()) {
-                        dropletsAtBifurcation = true;
-                    }
+            if (!cfdConverged || !pressureConverged) {
+                return;
+            }
 
-                    // compute the average flow rates of all boundaries, since the inflow does not necessarily have to match the outflow (qInput != qOutput)
-                    // in order to avoid an unwanted increase/decrease of the droplet volume an average flow rate is computed
-                    // the actual flow rate of a boundary is then determined accordingly to the ratios of the different flowRates inside the channels
-                    droplet->updateBoundaries(*network);
+            // write the converged results of the modules that only output their final state
+            for (auto& [key, module] : network->getModules()) {
+                if (module->getVtkOutput() == arch::VtkOutput::Final) {
+                    module->writeVTK(module->getStep());
                 }
-                // store simulation results of current state
-                saveState();
-                // compute events
-                auto events = computeEvents();
-
-                // sort events
-                // closest events in time with the highest priority come first
-                std::sort(events.begin(), events.end(), [](auto& a, auto& b) {
-                    if (a->getTime() == b->getTime()) {
-                        return a->getPriority() < b->getPriority();  // ascending order (the lower the priority value, the higher the priority)
-                    }
-                    return a->getTime() < b->getTime();  // ascending order
-                });
+            }
 
-                #ifdef VERBOSE     
-                    for (auto& event : events) {
-                        event->print();
-                    }
-                #endif
+            #ifdef VERBOSE     
+                std::cout << "[Simulation] All pressures have converged after " << couplingIterations << " coupling iterations." << std::endl;
+                printResults();
+            #endif
+        }
+        saveState();
+        finished = true;
+    }
 
-                // get next event or break loop, if no events remain
-                Event<T>* nextEvent = nullptr;
-                if (events.size() != 0) {
-                    nextEvent = events[0].get();
-                } else {
-                    break;
-                }
-                // move droplets until event is reached
-                time += nextEvent->getTime();
-                moveDroplets(nextEvent->getTime());
+    // 1D Droplet simulation
+    // ##########
+    // Simulation Loop
+    // ##########
+    // * update droplet resistances
+    // * conduct nodal analysis
+    // * update droplets (flow rates of boundaries)
+    // * compute events
+    // * search for next event (finish if no event is left)
+    // * move droplets
+    // * perform event
+    template<typename T>
+    bool Simulation<T>::stepDroplets(T endTime) {
+        if (iteration >= maxIterations) {
+            throw "Max iterations exceeded.";
+        }
+
+        #ifdef VERBOSE     
+            std::cout << "Iteration " << iteration << std::endl;
+        #endif
+        // update droplet resistances (in the first iteration no  droplets are inside the network)
+        // a paused iteration keeps the resistances until the next event, as if it was not paused
+        if (paused) {
+            changedChannels.clear();
+        } else {
+            updateDropletResistances();
+        }
+        // droplets that left the network in the last iteration are not considered anymore
+        retireDroplets();
+        // compute nodal analysis, only the channels with changed droplet resistances differ from the last one
+        // after a pause, the flow is recomputed since the network may have been changed in the meantime
+        nodalAnalysis->setChangedChannels(changedChannels);
+        nodalAnalysis->conductNodalAnalysis();
+        // update droplets, i.e., their boundary flow rates
+        updateDroplets();
+        // store simulation results of current state, the state of a paused iteration is only stored again if its flow changed
+        if (!paused || flowRatesChanged()) {
+            saveState();
+        }
+        paused = false;
+        // compute events (the boundary events are kept in the event queue)
+        computeEvents();
+
+        // find the closest event in time with the highest priority (the first one of several equal events)
+        auto firstEvent = std::min_element(events.begin(), events.end(), [](auto& a, auto& b) {
+            if (a->getTime() == b->getTime()) {
+                return a->getPriority() < b->getPriority();  // ascending order (the lower the priority value, the higher the priority)
+            }
+            return a->getTime() < b->getTime();  // ascending order
+        });
+
+        // get next event or finish the simulation, if no events remain
+        // boundary events take place before other events at the same time and priority, except for injections (of droplets and generators)
+        Event<T>* nextEvent = nullptr;
+        T nextTime = 0.0;
+        if (firstEvent != events.end()) {
+            nextEvent = firstEvent->get();
+            nextTime = nextEvent->getTime();
+        }
+        bool queuedEvent = false;
+        if (!boundaryEvents.empty()) {
+            T queueTime = boundaryEvents.topTime() - time;
+            Event<T>* queueEvent = boundaryEvents.top();
+            if (nextEvent == nullptr || queueTime < nextTime ||
+                (queueTime == nextTime && (queueEvent->getPriority() < nextEvent->getPriority() ||
+                    (queueEvent->getPriority() == nextEvent->getPriority() && dynamic_cast<DropletInjectionEvent<T>*>(nextEvent) == nullptr &&
+                        dynamic_cast<DropletGeneratorEvent<T>*>(nextEvent) == nullptr)))) {
+                nextEvent = queueEvent;
+                nextTime = queueTime;
+                queuedEvent = true;
+            }
+        }
+        if (nextEvent == nullptr) {
+            finished = true;
+            return false;
+        }
+
+        // pause the simulation before the event, the events are recomputed in the next iteration
+        // the pause does not count as an iteration, and its state is only stored when the recording policy samples it
+        if (time + nextTime > endTime) {
+            saveSamples(endTime - time);
+            moveDroplets(endTime - time);
+            time = endTime;
+            flowRatesChanged();
+            paused = true;
+            return false;
+        }
 
-                nextEvent->performEvent();
+        #ifdef VERBOSE     
+            nextEvent->print();
+        #endif
 
-                iteration++;
+        // move droplets until event is reached
+        saveSamples(nextTime);
+        time += nextTime;
+        moveDroplets(nextTime);
+
+        nextEvent->performEvent();
+        lastEventType = &typeid(*nextEvent);
+
+        // the droplet of a boundary event has changed, hence its events are recomputed in the next iteration (into the kept containers)
+        if (queuedEvent) {
+            int dropletId = boundaryEvents.topDroplet();
+            boundaryEvents.removeDroplet(dropletId);
+            auto states = boundaryEventStates.find(dropletId);
+            if (states != boundaryEventStates.end()) {
+                states->second.clear();
             }
         }
+
+        iteration++;
+        return true;
     }
 
     template<typename T>
@@ -399,6 +728,11 @@ namespace sim {
 
     template<typename T>
     void Simulation<T>::initialize() {
+        // create the nodal analysis, which is kept alive during the simulation
+        nodalAnalysis = std::make_unique<nodal::NodalAnalysis<T>>(network, solverType);
+        nodalAnalysis->setIncrementalUpdates(incrementalNodalUpdates);
+        nodalAnalysis->setCouplingAccelerator(acceleratorType, andersonDepth);
+
         // compute and set channel lengths
         #ifdef VERBOSE
             std::cout << "[Simulation] Compute and set channel lengths..." << std::endl;
@@ -453,7 +787,7 @@ namespace sim {
             #ifdef VERBOSE
                 std::cout << "[Simulation] Conduct initial nodal analysis..." << std::endl;
             #endif
-            nodal::conductNodalAnalysis(this->network);
+            nodalAnalysis->conductNodalAnalysis();
 
             // Prepare CFD geometry and lattice
             #ifdef VERBOSE
@@ -464,61 +798,204 @@ namespace sim {
                 module->prepareGeometry();
                 module->prepareLattice();
             }
+
+            // Initialization of CFD domains
+            couplingIterations = 0;
+            cfdConverged = false;
+            pressureConverged = false;
+            if (network->getModules().size() > 0) {
+                while (!cfdConverged) {
+                    cfdConverged = conductCFDSimulation(this->network, threadPool.get(), cfdThreads);
+                }
+            }
+        }
+
+        // the droplet simulation starts with empty event queues and without droplet resistances
+        if (this->simType == Type::Abstract && this->platform == Platform::BigDroplet) {
+            boundaryEvents.clear();
+            boundaryEventStates.clear();
+            resetDropletResistances();
         }
+
+        initialized = true;
+        finished = false;
     }
 
     template<typename T>
     void Simulation<T>::updateDropletResistances() {
-        // set all droplet resistances of all channels to 0.0
-        for (auto& [key, channel] : network->getChannels()) {
-            channel->setDropletResistance(0.0);
-        }
+        changedChannels.clear();
 
-        // set correct droplet resistances
+        // compare the contributions of the droplets with the last update
         for (auto& [key, droplet] : droplets) {
-            // only consider droplets that are inside the network (i.e., also trapped droplets)
-            if (droplet->getDropletState() == DropletState::INJECTION || droplet->getDropletState() == DropletState::SINK) {
+            // only droplets that are inside the network (i.e., also trapped droplets) contribute
+            bool inside = droplet->getDropletState() != DropletState::INJECTION && droplet->getDropletState() != DropletState::SINK;
+            auto applied = dropletResistances.find(key);
+            if (!inside && applied == dropletResistances.end()) {
                 continue;
             }
 
-            droplet->addDropletResistance(*resistanceModel);
+            resistanceBuffer.clear();
+            if (inside) {
+                droplet->computeDropletResistances(*resistanceModel, resistanceBuffer);
+            }
+            if (applied != dropletResistances.end() && applied->second == resistanceBuffer) {
+                continue;
+            }
+
+            // the droplet is removed from the channels it occupied and added to the channels it occupies now
+            if (applied == dropletResistances.end()) {
+                applied = dropletResistances.try_emplace(key).first;
+            }
+            for (auto& [channel, resistance] : applied->second) {
+                auto& contributors = channelDroplets[channel->getId()];
+                contributors.erase(std::remove(contributors.begin(), contributors.end(), key), contributors.end());
+                changedChannels.push_back(channel->getId());
+            }
+            for (auto& [channel, resistance] : resistanceBuffer) {
+                auto& contributors = channelDroplets[channel->getId()];
+                if (std::find(contributors.begin(), contributors.end(), key) == contributors.end()) {
+                    contributors.push_back(key);
+                }
+                changedChannels.push_back(channel->getId());
+            }
+
+            if (inside) {
+                applied->second.swap(resistanceBuffer);
+            } else {
+                dropletResistances.erase(applied);
+            }
+        }
+
+        std::sort(changedChannels.begin(), changedChannels.end());
+        changedChannels.erase(std::unique(changedChannels.begin(), changedChannels.end()), changedChannels.end());
+
+        // recompute the droplet resistance of the changed channels from the contributions of their droplets
+        for (int channelId : changedChannels) {
+            T dropletResistance = 0.0;
+            for (int dropletId : channelDroplets.at(channelId)) {
+                for (auto& [channel, resistance] : dropletResistances.at(dropletId)) {
+                    if (channel->getId() == channelId) {
+                        dropletResistance += resistance;
+                    }
+                }
+            }
+            network->getChannel(channelId)->setDropletResistance(dropletResistance);
         }
     }
 
     template<typename T>
-    void Simulation<T>::saveState() {
+    void Simulation<T>::resetDropletResistances() {
+        for (auto& [key, channel] : network->getChannels()) {
+            channel->setDropletResistance(0.0);
+        }
+        dropletResistances.clear();
+        channelDroplets.clear();
+        changedChannels.clear();
+    }
 
-        std::unordered_map<int, T> savePressures;
-        std::unordered_map<int, T> saveFlowRates;
-        std::unordered_map<int, DropletPosition<T>> saveDropletPositions;
+    template<typename T>
+    void Simulation<T>::retireDroplets() {
+        for (auto droplet = droplets.begin(); droplet != droplets.end(); ) {
+            if (droplet->second->getDropletState() != DropletState::SINK) {
+                ++droplet;
+                continue;
+            }
+            boundaryEvents.eraseDroplet(droplet->first);
+            boundaryEventStates.erase(droplet->first);
+            retiredDroplets.insert(std::move(*droplet));
+            droplet = droplets.erase(droplet);
+        }
+    }
 
-        // pressures
+    template<typename T>
+    void Simulation<T>::updateStateLayout() {
+        stateNodes.clear();
+        stateEdges.clear();
         for (auto& [id, node] : network->getNodes()) {
-            savePressures.try_emplace(node->getId(), node->getPressure());
+            stateNodes.push_back(node.get());
         }
-
-        // flow rates
         for (auto& [id, channel] : network->getChannels()) {
-            saveFlowRates.try_emplace(channel->getId(), channel->getFlowRate());
+            stateEdges.push_back(channel.get());
         }
         for (auto& [id, pump] : network->getFlowRatePumps()) {
-            saveFlowRates.try_emplace(pump->getId(), pump->getFlowRate());
+            stateEdges.push_back(pump.get());
         }
         for (auto& [id, pump] : network->getPressurePumps()) {
-            saveFlowRates.try_emplace(pump->getId(), pump->getFlowRate());
+            stateEdges.push_back(pump.get());
+        }
+        stateNetworkNodes = stateNodes.size();
+        stateNetworkEdges = stateEdges.size();
+
+        // only the recorded nodes and edges are saved
+        auto select = [](auto& elements, std::vector<int> ids, const std::string& name) {
+            if (ids.empty()) {
+                return;
+            }
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+            for (int id : ids) {
+                if (std::none_of(elements.begin(), elements.end(), [id](auto element) { return element->getId() == id; })) {
+                    throw std::invalid_argument("The recorded " + name + " " + std::to_string(id) + " is not part of the network.");
+                }
+            }
+            elements.erase(std::remove_if(elements.begin(), elements.end(), [&ids](auto element) {
+                return !std::binary_search(ids.begin(), ids.end(), element->getId());
+            }), elements.end());
+        };
+        select(stateNodes, recordedNodes, "node");
+        select(stateEdges, recordedEdges, "channel");
+
+        std::sort(stateNodes.begin(), stateNodes.end(), [](auto a, auto b) { return a->getId() < b->getId(); });
+        std::sort(stateEdges.begin(), stateEdges.end(), [](auto a, auto b) { return a->getId() < b->getId(); });
+
+        std::vector<int> nodeIds;
+        std::vector<int> edgeIds;
+        for (auto node : stateNodes) {
+            nodeIds.push_back(node->getId());
+        }
+        for (auto edge : stateEdges) {
+            edgeIds.push_back(edge->getId());
+        }
+        resultSink->setLayout(std::move(nodeIds), std::move(edgeIds));
+    }
+
+    template<typename T>
+    void Simulation<T>::writeState(T stateTime, T timeStep) {
+        // the pressures and flow rates are stored in the fixed node and edge order of the result store
+        const size_t nEdges = network->getChannels().size() + network->getFlowRatePumps().size() + network->getPressurePumps().size();
+        if (!resultSink->hasLayout() || stateNetworkNodes != network->getNodes().size() || stateNetworkEdges != nEdges) {
+            updateStateLayout();
+        }
+
+        std::unordered_map<int, DropletPosition<T>> saveDropletPositions;
+
+        // pressures
+        statePressures.resize(stateNodes.size());
+        for (size_t i = 0; i < stateNodes.size(); ++i) {
+            statePressures[i] = stateNodes[i]->getPressure();
+        }
+
+        // flow rates
+        stateFlowRates.resize(stateEdges.size());
+        for (size_t i = 0; i < stateEdges.size(); ++i) {
+            stateFlowRates[i] = stateEdges[i]->getFlowRate();
         }
 
         // droplet positions
-        for (auto& [id, droplet] : droplets) {
+        auto saveDropletPosition = [&](Droplet<T>* droplet) {
             // create new droplet position
             DropletPosition<T> newDropletPosition;
 
+            // only the droplets inside the network move until the next event (but no trapped droplets), as in moveDroplets
+            const bool moving = timeStep > 0.0 && droplet->getDropletState() == DropletState::NETWORK;
+
             // add boundaries
             for (auto& boundary : droplet->getBoundaries()) {
                 // get channel position
                 auto channelPosition = boundary->getChannelPosition();
+                T position = moving ? boundary->getMovedPosition(timeStep) : channelPosition.getPosition();
                 // add boundary
-                newDropletPosition.boundaries.emplace_back(channelPosition.getChannel(), channelPosition.getPosition(), boundary->isVolumeTowardsNodeA(), static_cast<BoundaryState>(static_cast<int>(boundary->getState())));
+                newDropletPosition.boundaries.emplace_back(channelPosition.getChannel(), position, boundary->isVolumeTowardsNodeA(), static_cast<BoundaryState>(static_cast<int>(boundary->getState())));
             }
 
             // add fully occupied channels
@@ -528,159 +1005,338 @@ namespace sim {
             }
 
             saveDropletPositions.try_emplace(droplet->getId(), newDropletPosition);
+        };
+        if (recordDropletPositions && recordedDroplets.empty()) {
+            for (auto& [id, droplet] : droplets) {
+                saveDropletPosition(droplet.get());
+            }
+        } else if (recordDropletPositions) {
+            for (int id : recordedDroplets) {
+                auto droplet = droplets.find(id);
+                if (droplet != droplets.end()) {
+                    saveDropletPosition(droplet->second.get());
+                }
+            }
         }
 
         // state
-        simulationResult->addState(time, savePressures, saveFlowRates, saveDropletPositions);
+        resultSink->addState(stateTime, statePressures, stateFlowRates, std::move(saveDropletPositions));
     }
 
     template<typename T>
-    void Simulation<T>::moveDroplets(T timeStep) {
-        // loop over all droplets
-        for (auto& [key, droplet] : droplets) {
-            // only consider droplets inside the network (but no trapped droplets)
-            if (droplet->getDropletState() != DropletState::NETWORK) {
-                continue;
-            }
-
-            // loop through boundaries
+    bool Simulation<T>::topologyChanged() {
+        topologyBuffer.clear();
+        for (auto& [id, droplet] : droplets) {
             for (auto& boundary : droplet->getBoundaries()) {
-                // move boundary in correct direction
-                boundary->moveBoundary(timeStep);
+                topologyBuffer.emplace_back(id, boundary->getChannelPosition().getChannel()->getId());
+            }
+            for (auto& channel : droplet->getFullyOccupiedChannels()) {
+                topologyBuffer.emplace_back(id, channel->getId());
             }
         }
+        std::sort(topologyBuffer.begin(), topologyBuffer.end());
+        topologyBuffer.erase(std::unique(topologyBuffer.begin(), topologyBuffer.end()), topologyBuffer.end());
+
+        bool changed = topologyBuffer != stateTopology;
+        std::swap(topologyBuffer, stateTopology);
+        return changed;
     }
 
     template<typename T>
-    std::vector<std::unique_ptr<Event<T>>> Simulation<T>::computeEvents() {
-        // events
-        std::vector<std::unique_ptr<Event<T>>> events;
+    void Simulation<T>::saveState() {
+        bool save = false;
+        if (recordingPolicy == RecordingPolicy::All) {
+            save = true;
+        } else if (recordingPolicy == RecordingPolicy::EventInterval) {
+            save = nComputedStates % static_cast<int>(recordingInterval) == 0;
+        } else if (recordingPolicy == RecordingPolicy::Change) {
+            // the topology is compared in every state, so that it is up to date
+            bool changed = topologyChanged();
+            save = nComputedStates == 0 || changed || lastEventType != stateEventType;
+            stateEventType = lastEventType;
+        }
+        // the states of the time interval policy are saved by saveSamples
+        nComputedStates++;
 
-        // injection events
-        for (auto& [key, injection] : dropletInjections) {
-            double injectionTime = injection->getInjectionTime();
-            if (injection->getDroplet()->getDropletState() == DropletState::INJECTION) {
-                events.push_back(std::make_unique<DropletInjectionEvent<T>>(injectionTime - time, *injection));
+        lastStateSaved = save;
+        if (save) {
+            writeState(time, 0.0);
+        }
+    }
+
+    template<typename T>
+    bool Simulation<T>::flowRatesChanged() {
+        const size_t nEdges = network->getChannels().size() + network->getFlowRatePumps().size() + network->getPressurePumps().size();
+        bool changed = pauseFlowRates.size() != nEdges;
+        pauseFlowRates.resize(nEdges);
+        size_t i = 0;
+        auto compare = [&](T flowRate) {
+            changed = changed || pauseFlowRates[i] != flowRate;
+            pauseFlowRates[i++] = flowRate;
+        };
+        for (auto& [key, channel] : network->getChannels()) {
+            compare(channel->getFlowRate());
+        }
+        for (auto& [key, pump] : network->getFlowRatePumps()) {
+            compare(pump->getFlowRate());
+        }
+        for (auto& [key, pump] : network->getPressurePumps()) {
+            compare(pump->getFlowRate());
+        }
+        return changed;
+    }
+
+    template<typename T>
+    void Simulation<T>::saveSamples(T timeStep) {
+        if (recordingPolicy != RecordingPolicy::TimeInterval) {
+            return;
+        }
+        // the sample times are multiples of the interval, so that no rounding errors accumulate
+        T sampleTime = nSamples * recordingInterval;
+        while (sampleTime < time + timeStep) {
+            writeState(sampleTime, sampleTime - time);
+            lastStateSaved = lastStateSaved || sampleTime == time;
+            sampleTime = ++nSamples * recordingInterval;
+        }
+    }
+
+    template<typename T>
+    void Simulation<T>::finishResult() {
+        if (!lastStateSaved) {
+            writeState(time, 0.0);
+            lastStateSaved = true;
+        }
+        resultSink->finish();
+    }
+
+    template<typename T>
+    void Simulation<T>::moveDroplets(T timeStep) {
+        // the store only moves the boundaries of the droplets inside the network (but no trapped droplets)
+        boundaryStore->move(timeStep);
+    }
+
+    template<typename T>
+    bool Simulation<T>::boundariesChanged(Droplet<T>* droplet, const std::vector<Droplet<T>*>& mergeDroplets) {
+        auto states = boundaryEventStates.find(droplet->getId());
+        if (states == boundaryEventStates.end() || states->second.size() != droplet->getBoundaries().size()) {
+            return true;
+        }
+        for (size_t i = 0; i < droplet->getBoundaries().size(); ++i) {
+            auto& boundary = droplet->getBoundaries()[i];
+            auto& state = states->second[i];
+            const int mergeDropletId = (mergeDroplets[i] != nullptr) ? mergeDroplets[i]->getId() : -1;
+            if (state.boundaryId != boundary->getId() ||
+                state.channel != boundary->getChannelPosition().getChannel() ||
+                state.flowRate != boundary->getFlowRate() ||
+                state.state != boundary->getState() ||
+                state.volumeTowardsNodeA != boundary->isVolumeTowardsNodeA() ||
+                state.mergeDropletId != mergeDropletId) {
+                return true;
             }
         }
+        return false;
+    }
+
+    template<typename T>
+    void Simulation<T>::updateBoundaryEvents(Droplet<T>* droplet, const std::vector<Droplet<T>*>& mergeDroplets) {
+        const int dropletId = droplet->getId();
+        boundaryEvents.removeDroplet(dropletId);
+        auto& states = boundaryEventStates[dropletId];
+        states.clear();
+
+        for (size_t i = 0; i < droplet->getBoundaries().size(); ++i) {
+            auto& boundary = droplet->getBoundaries()[i];
+            // the flow rate of the boundary indicates if the boundary moves towards or away from the droplet center and, hence, if a BoundaryTailEvent or BoundaryHeadEvent should occur, respectively
+            // if the flow rate of the boundary is 0, then no events will be triggered (the boundary may be in a Wait state)
+            if (boundary->getFlowRate() < 0) {
+                // boundary moves towards the droplet center => BoundaryTailEvent
+                T eventTime = boundaryStore->getTime(boundary->getSlot());
+                boundaryEvents.push(dropletId, i, time + eventTime, objectPool->template create<BoundaryTailEvent<T>>(eventTime, *droplet, *boundary, *network));
+            } else if (boundary->getFlowRate() > 0) {
+                // boundary moves away from the droplet center => BoundaryHeadEvent
+                T eventTime = boundaryStore->getTime(boundary->getSlot());
+
+                // in this scenario also a MergeBifurcationEvent can happen when merging is enabled
+                // this means a boundary comes to a bifurcation where a droplet is already present
+                // hence it is either a MergeBifurcationEvent or a BoundaryHeadEvent that will happen
+                if (mergeDroplets[i] == nullptr) {
+                    // no merging will happen => BoundaryHeadEvent
+                    if (!boundary->isInWaitState()) {
+                        boundaryEvents.push(dropletId, i, time + eventTime, objectPool->template create<BoundaryHeadEvent<T>>(eventTime, *droplet, *boundary, *network));
+                    }
+                } else {
+                    // merging of the actual droplet with the merge droplet will happen => MergeBifurcationEvent
+                    boundaryEvents.push(dropletId, i, time + eventTime, objectPool->template create<MergeBifurcationEvent<T>>(eventTime, *droplet, *mergeDroplets[i], *boundary, *this));
+                }
+            }
 
-        // define maps that are used for detecting merging inside channels
-        std::unordered_map<int, std::vector<DropletBoundary<T>*>> channelBoundariesMap;
-        std::unordered_map<DropletBoundary<T>*, Droplet<T>*> boundaryDropletMap;
+            states.push_back({ boundary->getId(), boundary->getChannelPosition().getChannel(), boundary->getFlowRate(), boundary->getState(),
+                               boundary->isVolumeTowardsNodeA(), (mergeDroplets[i] != nullptr) ? mergeDroplets[i]->getId() : -1 });
+        }
+        nBoundaryEventUpdates++;
+    }
 
+    template<typename T>
+    void Simulation<T>::collectNetworkDroplets() {
+        networkDroplets.clear();
         for (auto& [key, droplet] : droplets) {
-            // only consider droplets inside the network (but no trapped droplets)
-            if (droplet->getDropletState() != DropletState::NETWORK) {
-                continue;
+            // only consider droplets inside the network
+            if (droplet->getDropletState() == DropletState::NETWORK) {
+                networkDroplets.push_back(droplet.get());
+            }
+        }
+        dropletFlags.assign(networkDroplets.size(), false);
+    }
+
+    template<typename T>
+    void Simulation<T>::updateDroplets() {
+        collectNetworkDroplets();
+
+        threadPool->parallelFor(networkDroplets.size(), dropletThreads, minDropletsPerThread, [this](size_t i) {
+            auto droplet = networkDroplets[i];
+
+            // set to true if droplet is at bifurcation
+            dropletFlags[i] = droplet->isAtBifurcation();
+
+            // compute the average flow rates of all boundaries, since the inflow does not necessarily have to match the outflow (qInput != qOutput)
+            // in order to avoid an unwanted increase/decrease of the droplet volume an average flow rate is computed
+            // the actual flow rate of a boundary is then determined accordingly to the ratios of the different flowRates inside the channels
+            droplet->updateBoundaries(*network);
+        });
+
+        dropletsAtBifurcation = false;
+        for (size_t i = 0; i < networkDroplets.size(); ++i) {
+            dropletsAtBifurcation = dropletsAtBifurcation || dropletFlags[i];
+        }
+    }
+
+    template<typename T>
+    void Simulation<T>::computeEvents() {
+        // events (returns the events of the last iteration to the pool)
+        events.clear();
+
+        // injection events
+        // only the earliest pending injection can take place next, injections that took place are removed from the pending injections
+        while (!pendingInjections.empty()) {
+            auto pending = pendingInjections.top();
+            if (pending.injection != nullptr) {
+                if (pending.injection->getDroplet()->getDropletState() == DropletState::INJECTION) {
+                    events.push_back(objectPool->template create<DropletInjectionEvent<T>>(pending.time - time, *pending.injection));
+                    break;
+                }
+                pendingInjections.pop();
+            } else {
+                if (pending.generator->getInjectedDroplets() == pending.injectedDroplets) {
+                    events.push_back(objectPool->template create<DropletGeneratorEvent<T>>(pending.time - time, *pending.generator, *this));
+                    break;
+                }
+                // the generator injected its droplet, hence its next injection is scheduled
+                pendingInjections.pop();
+                scheduleGenerator(pending.generator);
             }
+        }
+
+        // the merge droplets of the boundaries and the check if the boundaries changed only read the droplets, hence they are computed concurrently
+        // the boundary events of the changed droplets are then recomputed in the order of the droplets
+        collectNetworkDroplets();
+        if (dropletMergeDroplets.size() < networkDroplets.size()) {
+            dropletMergeDroplets.resize(networkDroplets.size());
+        }
+        threadPool->parallelFor(networkDroplets.size(), dropletThreads, minDropletsPerThread, [this](size_t i) {
+            auto droplet = networkDroplets[i];
 
-            // loop through boundaries
+            // a boundary that moves away from the droplet center can merge with a droplet that is present at the bifurcation it moves towards
+            auto& mergeDroplets = dropletMergeDroplets[i];
+            mergeDroplets.clear();
             for (auto& boundary : droplet->getBoundaries()) {
-                // the flow rate of the boundary indicates if the boundary moves towards or away from the droplet center and, hence, if a BoundaryTailEvent or BoundaryHeadEvent should occur, respectively
-                // if the flow rate of the boundary is 0, then no events will be triggered (the boundary may be in a Wait state)
-                if (boundary->getFlowRate() < 0) {
-                    // boundary moves towards the droplet center => BoundaryTailEvent
-                    double time = boundary->getTime();
-                    events.push_back(std::make_unique<BoundaryTailEvent<T>>(time, *droplet, *boundary, *network));
-                } else if (boundary->getFlowRate() > 0) {
-                    // boundary moves away from the droplet center => BoundaryHeadEvent
-                    double time = boundary->getTime();
-
-                    // in this scenario also a MergeBifurcationEvent can happen when merging is enabled
-                    // this means a boundary comes to a bifurcation where a droplet is already present
-                    // hence it is either a MergeBifurcationEvent or a BoundaryHeadEvent that will happen
-
-                    // check if merging is enabled
-                    Droplet<T>* mergeDroplet = nullptr;
-
-                    // find droplet to merge (if present)
+                Droplet<T>* mergeDroplet = nullptr;
+                if (boundary->getFlowRate() > 0) {
                     auto referenceNode = boundary->getOppositeReferenceNode(network);
                     mergeDroplet = getDropletAtNode(referenceNode->getId());
-
-                    if (mergeDroplet == nullptr) {
-                        // no merging will happen => BoundaryHeadEvent
-                        if (!boundary->isInWaitState()) {
-                            events.push_back(std::make_unique<BoundaryHeadEvent<T>>(time, *droplet, *boundary, *network));
-                        }
-                    } else {
-                        // merging of the actual droplet with the merge droplet will happen => MergeBifurcationEvent
-                        events.push_back(std::make_unique<MergeBifurcationEvent<T>>(time, *droplet, *mergeDroplet, *boundary, *this));
-                    }
                 }
+                mergeDroplets.push_back(mergeDroplet);
+            }
 
-                // fill the maps which are later used for merging inside channels (if merging is enabled)
-                auto [value, success] = channelBoundariesMap.try_emplace(boundary->getChannelPosition().getChannel()->getId());
-                value->second.push_back(boundary.get());
+            // the boundary events are only recomputed if a boundary of the droplet changed since they were computed
+            dropletFlags[i] = boundariesChanged(droplet, mergeDroplets);
+        });
 
-                boundaryDropletMap.emplace(boundary.get(), droplet.get());
+        // the times until the boundaries reach the ends of their channels are computed for all boundaries at once
+        if (std::any_of(dropletFlags.begin(), dropletFlags.end(), [](char changed) { return changed; })) {
+            boundaryStore->computeTimes();
+        }
+        for (size_t i = 0; i < networkDroplets.size(); ++i) {
+            if (dropletFlags[i]) {
+                updateBoundaryEvents(networkDroplets[i], dropletMergeDroplets[i]);
+            }
+        }
+
+        // remove the boundary events of droplets that left the network
+        for (auto states = boundaryEventStates.begin(); states != boundaryEventStates.end(); ) {
+            if (droplets.at(states->first)->getDropletState() != DropletState::NETWORK) {
+                boundaryEvents.eraseDroplet(states->first);
+                states = boundaryEventStates.erase(states);
+            } else {
+                ++states;
             }
         }
 
         // check for MergeChannelEvents, i.e, for boundaries of other droplets that are in the same channel
-        // here the previously defined maps are used => if merging is not enabled these maps are emtpy
-        // loop through channelsBoundariesMap
-        for (auto& [channelId, boundaries] : channelBoundariesMap) {
-            // loop through boundaries that are inside this channel
-            for (size_t i = 0; i < boundaries.size(); i++) {
+        // the boundaries inside a channel are kept sorted by their position in the boundary index, and since boundaries cannot pass
+        // each other without merging, the first merge inside a channel always takes place between two adjacent boundaries
+        boundaryIndex->sort();
+        for (auto& [channelId, boundaries] : boundaryIndex->getChannelBoundaries()) {
+            // loop through adjacent pairs of boundaries that are inside this channel
+            for (size_t i = 1; i < boundaries.size(); i++) {
                 // get reference boundary and droplet
-                auto referenceBoundary = boundaries[i];
-                auto referenceDroplet = boundaryDropletMap.at(referenceBoundary);
+                auto referenceBoundary = boundaries[i - 1].boundary;
+                auto referenceDroplet = boundaries[i - 1].droplet;
+                auto boundary = boundaries[i].boundary;
+                auto droplet = boundaries[i].droplet;
+
+                // do not consider if this boundary is form the same droplet
+                if (droplet == referenceDroplet) {
+                    continue;
+                }
 
                 // get channel
                 auto channel = referenceBoundary->getChannelPosition().getChannel();
 
-                // get velocity and absolute position of the boundary
-                // positive values for v0 indicate a movement from node0 towards node1
+                // get velocity and absolute position of the boundaries
+                // positive values for v0 and v1 indicate a movement from node0 towards node1
                 auto q0 = referenceBoundary->isVolumeTowardsNodeA() ? referenceBoundary->getFlowRate() : -referenceBoundary->getFlowRate();
                 auto v0 = q0 / channel->getArea();
                 auto p0 = referenceBoundary->getChannelPosition().getPosition() * channel->getLength();
+                auto q1 = boundary->isVolumeTowardsNodeA() ? boundary->getFlowRate() : -boundary->getFlowRate();
+                auto v1 = q1 / channel->getArea();
+                auto p1 = boundary->getChannelPosition().getPosition() * channel->getLength();
 
-                // compare reference boundary against all others
-                // the two loops are defined in such a way, that only one merge event happens for a pair of boundaries
-                for (size_t j = i + 1; j < boundaries.size(); j++) {
-                    auto boundary = boundaries[j];
-                    auto droplet = boundaryDropletMap.at(boundary);
-
-                    // do not consider if this boundary is form the same droplet
-                    if (droplet == referenceDroplet) {
-                        continue;
-                    }
-
-                    // get velocity and absolute position of the boundary
-                    // positive values for v0 indicate a movement from node0 towards node1
-                    auto q1 = boundary->isVolumeTowardsNodeA() ? boundary->getFlowRate() : -boundary->getFlowRate();
-                    auto v1 = q1 / channel->getArea();
-                    auto p1 = boundary->getChannelPosition().getPosition() * channel->getLength();
-
-                    // do not merge when both velocities are equal (would result in infinity time)
-                    if (v0 == v1) {
-                        continue;
-                    }
-
-                    // compute time and merge position
-                    auto time = (p1 - p0) / (v0 - v1);
-                    auto pMerge = p0 + v0 * time;  // or p1 + v1*time
-                    auto pMergeRelative = pMerge / channel->getLength();
+                // do not merge when both velocities are equal (would result in infinity time)
+                if (v0 == v1) {
+                    continue;
+                }
 
-                    // do not trigger a merge event when:
-                    // * time is negative => indicates that both boundaries go in different directions or that one boundary cannot "outrun" the other because it is too slow
-                    // * relative merge position is outside the range of [0, 1] => the merging would happen "outside" the channel and a boundary would already switch a channel before this event could happen
-                    if (time < 0 || pMergeRelative < 0 || 1 < pMergeRelative) {
-                        continue;
-                    }
+                // compute time and merge position
+                auto time = (p1 - p0) / (v0 - v1);
+                auto pMerge = p0 + v0 * time;  // or p1 + v1*time
+                auto pMergeRelative = pMerge / channel->getLength();
 
-                    // add MergeChannelEvent
-                    events.push_back(std::make_unique<MergeChannelEvent<T>>(time, *referenceDroplet, *droplet, *referenceBoundary, *boundary, *this));
+                // do not trigger a merge event when:
+                // * time is negative => indicates that both boundaries go in different directions or that one boundary cannot "outrun" the other because it is too slow
+                // * relative merge position is outside the range of [0, 1] => the merging would happen "outside" the channel and a boundary would already switch a channel before this event could happen
+                if (time < 0 || pMergeRelative < 0 || 1 < pMergeRelative) {
+                    continue;
                 }
+
+                // add MergeChannelEvent
+                events.push_back(objectPool->template create<MergeChannelEvent<T>>(time, *referenceDroplet, *droplet, *referenceBoundary, *boundary, *this));
             }
         }
 
         // time step event
         if (dropletsAtBifurcation && maximalAdaptiveTimeStep > 0) {
-            events.push_back(std::make_unique<TimeStepEvent<T>>(maximalAdaptiveTimeStep));
+            events.push_back(objectPool->template create<TimeStepEvent<T>>(maximalAdaptiveTimeStep));
         }
-
-        return events;
     }
 
 }   /// namespace sim
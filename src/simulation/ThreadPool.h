@@ -0,0 +1,87 @@
+/**
+ * @file ThreadPool.h
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sim {
+
+/**
+ * @brief Class for a pool of persistent worker threads. The workers are started once and wait for the jobs of parallelFor,
+ * so that a job does not pay for starting and joining threads. The calling thread works on each job as well, hence a pool of
+ * n threads starts n-1 workers. A pool runs one job at a time: a job that is started while another job is running (e.g.,
+ * from inside the function of a job) is run serially on the calling thread.
+ */
+class ThreadPool {
+  private:
+    std::vector<std::thread> workers;                   ///< Worker threads.
+    std::mutex mutex;                                   ///< Protects the job state below.
+    std::condition_variable jobStarted;                 ///< Wakes the workers when a job is started or the pool is stopped.
+    std::condition_variable jobFinished;                ///< Wakes the calling thread when the last worker finished the job.
+    const std::function<void()>* job = nullptr;         ///< The running job.
+    size_t generation = 0;                              ///< Number of started jobs.
+    size_t nJobWorkers = 0;                             ///< Number of workers that take part in the running job.
+    size_t nRunningWorkers = 0;                         ///< Number of workers that did not finish the running job yet.
+    bool stopped = false;                               ///< If the workers have to stop.
+    std::mutex jobMutex;                                ///< Held while a job is running.
+
+    /**
+     * @brief Loop of a worker, which waits for jobs until the pool is stopped.
+     * @param[in] index Index of the worker.
+     */
+    void work(size_t index);
+
+    /**
+     * @brief Run a job on the calling thread and a number of workers and wait until all of them finished it.
+     * @param[in] nThreads Number of threads, including the calling thread.
+     * @param[in] function The job.
+     */
+    void run(size_t nThreads, const std::function<void()>& function);
+
+  public:
+    /**
+     * @brief Constructs a pool and starts its workers.
+     * @param[in] nThreads Number of threads, including the calling thread. 0 uses the number of hardware threads.
+     */
+    explicit ThreadPool(int nThreads = 1);
+
+    /**
+     * @brief Stops and joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Get the number of threads of the pool, including the calling thread.
+     * @return Number of threads.
+     */
+    int getNumberOfThreads() const;
+
+    /**
+     * @brief Call a function for all indices of a range on the threads of the pool. The range is split into contiguous
+     * chunks that the threads take one after another. The function must only write state that belongs to its index, then
+     * the results do not depend on the number of threads. If the range is too small to keep more than one thread busy,
+     * the function is called serially on the calling thread, so that small ranges do not pay for waking the workers.
+     * The first exception (in index order of the chunks) thrown by the function is rethrown after all threads finished.
+     * @param[in] n Size of the range [0, n).
+     * @param[in] nThreads Maximal number of threads. 0 uses all threads of the pool, 1 calls the function serially.
+     * @param[in] minChunkSize Minimal number of indices per thread.
+     * @param[in] function Function that is called with each index of the range.
+     */
+    template<typename F>
+    void parallelFor(size_t n, int nThreads, size_t minChunkSize, F&& function);
+};
+
+}   // namespace sim
@@ -0,0 +1,115 @@
+#include "ThreadPool.h"
+
+namespace sim {
+
+inline ThreadPool::ThreadPool(int nThreads) {
+    if (nThreads <= 0) {
+        nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(nThreads - 1);
+    for (int i = 0; i < nThreads - 1; ++i) {
+        workers.emplace_back(&ThreadPool::work, this, static_cast<size_t>(i));
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+    jobStarted.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+inline int ThreadPool::getNumberOfThreads() const {
+    return static_cast<int>(workers.size()) + 1;
+}
+
+inline void ThreadPool::work(size_t index) {
+    size_t lastGeneration = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        jobStarted.wait(lock, [&]() { return stopped || generation != lastGeneration; });
+        if (stopped) {
+            return;
+        }
+        lastGeneration = generation;
+        if (index >= nJobWorkers) {
+            continue;
+        }
+
+        const std::function<void()>* function = job;
+        lock.unlock();
+        (*function)();
+        lock.lock();
+        if (--nRunningWorkers == 0) {
+            jobFinished.notify_one();
+        }
+    }
+}
+
+inline void ThreadPool::run(size_t nThreads, const std::function<void()>& function) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &function;
+        nJobWorkers = nThreads - 1;
+        nRunningWorkers = nJobWorkers;
+        generation++;
+    }
+    jobStarted.notify_all();
+
+    // the calling thread works as well
+    function();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    jobFinished.wait(lock, [&]() { return nRunningWorkers == 0; });
+    job = nullptr;
+}
+
+template<typename F>
+void ThreadPool::parallelFor(size_t n, int nThreads, size_t minChunkSize, F&& function) {
+    if (nThreads <= 0 || nThreads > getNumberOfThreads()) {
+        nThreads = getNumberOfThreads();
+    }
+    const size_t maxThreads = n / std::max<size_t>(1, minChunkSize);
+    nThreads = static_cast<int>(std::min(static_cast<size_t>(nThreads), maxThreads));
+
+    // a job that is started while another job is running is called serially
+    std::unique_lock<std::mutex> jobLock(jobMutex, std::defer_lock);
+    if (nThreads <= 1 || !jobLock.try_lock()) {
+        for (size_t i = 0; i < n; ++i) {
+            function(i);
+        }
+        return;
+    }
+
+    // a few chunks per thread, so that the threads stay busy if the indices take different times
+    const size_t nChunks = std::min(n, static_cast<size_t>(4 * nThreads));
+    const size_t chunkSize = (n + nChunks - 1) / nChunks;
+    std::vector<std::exception_ptr> errors(nChunks, nullptr);
+    std::atomic<size_t> nextChunk(0);
+
+    const std::function<void()> worker = [&]() {
+        for (size_t c = nextChunk++; c < nChunks; c = nextChunk++) {
+            try {
+                const size_t end = std::min(n, (c + 1) * chunkSize);
+                for (size_t i = c * chunkSize; i < end; ++i) {
+                    function(i);
+                }
+            } catch (...) {
+                errors[c] = std::current_exception();
+            }
+        }
+    };
+    run(nThreads, worker);
+
+    for (auto& error : errors) {
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}   // namespace sim
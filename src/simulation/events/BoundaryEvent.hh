@@ -63,10 +63,8 @@ void BoundaryHeadEvent<T>::performEvent() {
     T channelPosition = nextChannel->getNodeA() == node ? 0.0 : 1.0;
     bool volumeTowardsNodeA = nextChannel->getNodeA() == node;
 
-    // set new channel, position, direction of volume, and state of the boundary
-    boundary.getChannelPosition().setChannel(nextChannel);
-    boundary.getChannelPosition().setPosition(channelPosition);
-    boundary.setVolumeTowardsNodeA(volumeTowardsNodeA);
+    // set new channel, position, direction of volume (updates the boundary index of the simulation), and state of the boundary
+    droplet.moveBoundary(boundary, nextChannel, channelPosition, volumeTowardsNodeA);
     boundary.setState(BoundaryState::NORMAL);
 }
 
@@ -99,10 +97,8 @@ void BoundaryTailEvent<T>::performEvent() {
         T channelPosition = nextChannel->getNodeA() == referenceNode ? 0.0 : 1.0;
         bool volumeTowardsNodeA = nextChannel->getNodeA() != referenceNode;
 
-        // set new channel, position, direction of volume, and state of the boundary
-        boundary.getChannelPosition().setChannel(nextChannel);
-        boundary.getChannelPosition().setPosition(channelPosition);
-        boundary.setVolumeTowardsNodeA(volumeTowardsNodeA);
+        // set new channel, position, direction of volume (updates the boundary index of the simulation), and state of the boundary
+        droplet.moveBoundary(boundary, nextChannel, channelPosition, volumeTowardsNodeA);
         boundary.setState(BoundaryState::NORMAL);
 
         // remove fully occupied channel if present
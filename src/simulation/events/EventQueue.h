@@ -0,0 +1,163 @@
+/**
+ * @file EventQueue.h
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "../ObjectPool.h"
+
+namespace arch {
+
+// Forward declared dependencies
+template<typename T>
+class RectangularChannel;
+
+}   // namespace arch
+
+namespace sim {
+
+// Forward declared dependencies
+template<typename T>
+class Droplet;
+
+template<typename T>
+class DropletBoundary;
+
+template<typename T>
+class Event;
+
+enum class BoundaryState;
+
+/**
+ * @brief Struct that stores the state of a droplet boundary for which its events were computed.
+ * If any of these values changes, the events of the droplet have to be recomputed. Boundaries and droplets are identified by
+ * their ids, since pooled objects that were removed and created in the same step can have the same address.
+ */
+template<typename T>
+struct BoundaryEventState {
+    uint64_t boundaryId;                        ///< Id of the boundary.
+    arch::RectangularChannel<T>* channel;       ///< Channel the boundary was in.
+    T flowRate;                                 ///< Flow rate of the boundary.
+    BoundaryState state;                        ///< State of the boundary.
+    bool volumeTowardsNodeA;                    ///< Direction of the droplet volume.
+    int mergeDropletId;                         ///< Id of the droplet at the opposite reference node of the boundary, if the boundary moves towards it, -1 otherwise.
+};
+
+/**
+ * @brief Class for an indexed priority queue of events that are keyed by a droplet and one of its boundaries.
+ * Events are ordered by their absolute time (in s elapsed since the start of the simulation), their priority and their
+ * key. The events of a single droplet can be removed in O(k log n), so that only the events of droplets whose boundaries
+ * changed have to be recomputed.
+ */
+template<typename T>
+class EventQueue {
+  private:
+    /**
+     * @brief Entry of the queue.
+     */
+    struct Entry {
+        int dropletId;                      ///< Id of the droplet of the event.
+        int boundary;                       ///< Index of the boundary of the event inside the droplet.
+        T time;                             ///< Absolute time of the event.
+        int priority;                       ///< Priority of the event.
+        PoolPtr<Event<T>> event;            ///< The event.
+        size_t heapIndex;                   ///< Position of the entry in the heap.
+    };
+
+    std::vector<Entry> entries;                                 ///< Entries of the queue, indexed by slot.
+    std::vector<int> freeSlots;                                 ///< Slots of removed entries that can be reused.
+    std::vector<int> heap;                                      ///< Binary min-heap of slots.
+    std::unordered_map<int, std::vector<int>> dropletSlots;     ///< Slots of the events of each droplet, kept (empty) when the events of a droplet are removed.
+
+    /**
+     * @brief Compare the entries of two slots.
+     * @param[in] slotA First slot.
+     * @param[in] slotB Second slot.
+     * @return If the entry of slotA takes place before the entry of slotB.
+     */
+    bool before(int slotA, int slotB) const;
+
+    /**
+     * @brief Swap two positions of the heap.
+     * @param[in] i First position.
+     * @param[in] j Second position.
+     */
+    void swap(size_t i, size_t j);
+
+    /**
+     * @brief Move an entry of the heap up until the heap property is restored.
+     * @param[in] i Position of the entry.
+     */
+    void siftUp(size_t i);
+
+    /**
+     * @brief Move an entry of the heap down until the heap property is restored.
+     * @param[in] i Position of the entry.
+     */
+    void siftDown(size_t i);
+
+  public:
+    /**
+     * @brief Add an event to the queue.
+     * @param[in] dropletId Id of the droplet of the event.
+     * @param[in] boundary Index of the boundary of the event inside the droplet.
+     * @param[in] time Absolute time of the event in s elapsed since the start of the simulation.
+     * @param[in] event The event.
+     */
+    void push(int dropletId, int boundary, T time, PoolPtr<Event<T>> event);
+
+    /**
+     * @brief Remove all events of a droplet from the queue. The slot list of the droplet is kept, so that the recomputed
+     * events of the droplet do not allocate.
+     * @param[in] dropletId Id of the droplet.
+     */
+    void removeDroplet(int dropletId);
+
+    /**
+     * @brief Remove all events of a droplet from the queue together with its slot list, e.g., after it left the network.
+     * @param[in] dropletId Id of the droplet.
+     */
+    void eraseDroplet(int dropletId);
+
+    /**
+     * @brief Remove all events from the queue.
+     */
+    void clear();
+
+    /**
+     * @brief Checks if the queue is empty.
+     * @return If the queue contains no events.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Get the number of events in the queue.
+     * @return Number of events.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Get the next event.
+     * @return Pointer to the next event.
+     */
+    Event<T>* top() const;
+
+    /**
+     * @brief Get the absolute time of the next event.
+     * @return Time of the next event in s elapsed since the start of the simulation.
+     */
+    T topTime() const;
+
+    /**
+     * @brief Get the droplet of the next event.
+     * @return Id of the droplet of the next event.
+     */
+    int topDroplet() const;
+};
+
+}   // namespace sim
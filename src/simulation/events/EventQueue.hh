@@ -0,0 +1,149 @@
+#include "EventQueue.h"
+
+namespace sim {
+
+template<typename T>
+bool EventQueue<T>::before(int slotA, int slotB) const {
+    const Entry& a = entries[slotA];
+    const Entry& b = entries[slotB];
+    if (a.time != b.time) {
+        return a.time < b.time;
+    }
+    if (a.priority != b.priority) {
+        return a.priority < b.priority;  // the lower the priority value, the higher the priority
+    }
+    if (a.dropletId != b.dropletId) {
+        return a.dropletId < b.dropletId;
+    }
+    return a.boundary < b.boundary;
+}
+
+template<typename T>
+void EventQueue<T>::swap(size_t i, size_t j) {
+    std::swap(heap[i], heap[j]);
+    entries[heap[i]].heapIndex = i;
+    entries[heap[j]].heapIndex = j;
+}
+
+template<typename T>
+void EventQueue<T>::siftUp(size_t i) {
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!before(heap[i], heap[parent])) {
+            break;
+        }
+        swap(i, parent);
+        i = parent;
+    }
+}
+
+template<typename T>
+void EventQueue<T>::siftDown(size_t i) {
+    while (true) {
+        size_t first = i;
+        size_t left = 2 * i + 1;
+        size_t right = 2 * i + 2;
+        if (left < heap.size() && before(heap[left], heap[first])) {
+            first = left;
+        }
+        if (right < heap.size() && before(heap[right], heap[first])) {
+            first = right;
+        }
+        if (first == i) {
+            break;
+        }
+        swap(i, first);
+        i = first;
+    }
+}
+
+template<typename T>
+void EventQueue<T>::push(int dropletId, int boundary, T time, PoolPtr<Event<T>> event) {
+    int slot;
+    if (freeSlots.empty()) {
+        slot = entries.size();
+        entries.emplace_back();
+    } else {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+
+    Entry& entry = entries[slot];
+    entry.dropletId = dropletId;
+    entry.boundary = boundary;
+    entry.time = time;
+    entry.priority = static_cast<int>(event->getPriority());
+    entry.event = std::move(event);
+    entry.heapIndex = heap.size();
+
+    heap.push_back(slot);
+    dropletSlots[dropletId].push_back(slot);
+    siftUp(entry.heapIndex);
+}
+
+template<typename T>
+void EventQueue<T>::removeDroplet(int dropletId) {
+    auto slots = dropletSlots.find(dropletId);
+    if (slots == dropletSlots.end()) {
+        return;
+    }
+
+    for (int slot : slots->second) {
+        // replace the entry by the last entry of the heap and restore the heap property
+        size_t i = entries[slot].heapIndex;
+        size_t last = heap.size() - 1;
+        if (i != last) {
+            swap(i, last);
+        }
+        heap.pop_back();
+        if (i != last) {
+            siftDown(i);
+            siftUp(i);
+        }
+
+        entries[slot].event.reset();
+        freeSlots.push_back(slot);
+    }
+    slots->second.clear();
+}
+
+template<typename T>
+void EventQueue<T>::eraseDroplet(int dropletId) {
+    removeDroplet(dropletId);
+    dropletSlots.erase(dropletId);
+}
+
+template<typename T>
+void EventQueue<T>::clear() {
+    entries.clear();
+    freeSlots.clear();
+    heap.clear();
+    dropletSlots.clear();
+}
+
+template<typename T>
+bool EventQueue<T>::empty() const {
+    return heap.empty();
+}
+
+template<typename T>
+size_t EventQueue<T>::size() const {
+    return heap.size();
+}
+
+template<typename T>
+Event<T>* EventQueue<T>::top() const {
+    return entries[heap.front()].event.get();
+}
+
+template<typename T>
+T EventQueue<T>::topTime() const {
+    return entries[heap.front()].time;
+}
+
+template<typename T>
+int EventQueue<T>::topDroplet() const {
+    return entries[heap.front()].dropletId;
+}
+
+}   // namespace sim
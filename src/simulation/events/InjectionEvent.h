@@ -4,15 +4,40 @@
 
 #pragma once
 
+namespace arch {
+
+// Forward declared dependencies
+template<typename T>
+class ChannelPosition;
+
+}
+
 namespace sim {
 
 // Forward declared dependencies
+template<typename T>
+class Droplet;
+
+template<typename T>
+class DropletGenerator;
+
 template<typename T>
 class Event;
 
 template<typename T>
 class DropletInjection;
 
+template<typename T>
+class Simulation;
+
+/**
+ * @brief Inject a droplet into the network, i.e., create its two boundaries around the injection position.
+ * @param[in,out] droplet The droplet to be injected. The channel must be able to fully contain the droplet.
+ * @param[in] injectionPosition Position of the middle of the droplet.
+ */
+template<typename T>
+void injectDroplet(Droplet<T>& droplet, const arch::ChannelPosition<T>& injectionPosition);
+
 /**
  * @brief Class for an injection event that takes place when a droplet is injected into the network.
  */
@@ -40,4 +65,33 @@ class DropletInjectionEvent : public Event<T> {
     void print() override;
 };
 
+/**
+ * @brief Class for an injection event of a droplet generator, which creates the droplet and injects it into the network.
+ */
+template<typename T>
+class DropletGeneratorEvent : public Event<T> {
+  private:
+    DropletGenerator<T>& generator;  ///< Generator that creates the droplet.
+    Simulation<T>& simulation;       ///< Simulation to which the droplet is added.
+
+  public:
+    /**
+     * @brief Definies an injection event of a generator to take place at a certain time.
+     * @param[in] time The time at which the event should take place in s elapsed since the start of the simulation.
+     * @param[in,out] generator The generator whose next droplet is injected.
+     * @param[in,out] simulation Simulation to which the droplet is added.
+     */
+    DropletGeneratorEvent(T time, DropletGenerator<T>& generator, Simulation<T>& simulation);
+
+    /**
+     * @brief Conducts the injection event, i.e., creates the droplet and injects it.
+     */
+    void performEvent() override;
+
+    /**
+     * @brief Print the injection event.
+     */
+    void print() override;
+};
+
 }  // namespace sim
@@ -7,30 +7,33 @@ DropletInjectionEvent<T>::DropletInjectionEvent(T time, DropletInjection<T>& inj
     Event<T>(time, 1), injection(injection) {}
 
 template<typename T>
-void DropletInjectionEvent<T>::performEvent() {
+void injectDroplet(Droplet<T>& droplet, const arch::ChannelPosition<T>& injectionPosition) {
     // injection position of the droplet (center of the droplet)
-    auto channelPosition = injection.getInjectionPosition();
-    auto channel = channelPosition.getChannel();
-    auto droplet = injection.getDroplet();
+    auto channel = injectionPosition.getChannel();
 
     // for the injection the two boundaries (basically a head and a tail) of the droplet must lie inside the channel (the volume of the droplet must be small enough)
     // this is already checked at the creation of the injection and, thus, we don't need this check here
 
     // the droplet length is a relative value between 0 and 1
-    T dropletLength = droplet->getVolume() / channel->getVolume();
+    T dropletLength = droplet.getVolume() / channel->getVolume();
 
     // compute position of the two boundaries
-    T position0 = (channelPosition.getPosition() - dropletLength / 2);  // is always the position which lies closer to 0
-    T position1 = (channelPosition.getPosition() + dropletLength / 2);  // is always the position which lies closer to 1
+    T position0 = (injectionPosition.getPosition() - dropletLength / 2);  // is always the position which lies closer to 0
+    T position1 = (injectionPosition.getPosition() + dropletLength / 2);  // is always the position which lies closer to 1
 
     // create corresponding boundaries
     // since boundary0 always lies closer to 0, the volume of this boundary points to node1
     // since boundary1 always lies closer to 1, the volume of this boundary points to node0
-    droplet->addBoundary(channel, position0, false, BoundaryState::NORMAL);
-    droplet->addBoundary(channel, position1, true, BoundaryState::NORMAL);
+    droplet.addBoundary(channel, position0, false, BoundaryState::NORMAL);
+    droplet.addBoundary(channel, position1, true, BoundaryState::NORMAL);
 
     // set droplet state
-    droplet->setDropletState(DropletState::NETWORK);
+    droplet.setDropletState(DropletState::NETWORK);
+}
+
+template<typename T>
+void DropletInjectionEvent<T>::performEvent() {
+    injectDroplet(*injection.getDroplet(), injection.getInjectionPosition());
 }
 
 template<typename T>
@@ -38,4 +41,22 @@ void DropletInjectionEvent<T>::print() {
     std::cout << "\n Droplet Injection Event at t=" << this->time << " with priority " << this->priority << "\n" << std::endl;
 }
 
+template<typename T>
+DropletGeneratorEvent<T>::DropletGeneratorEvent(T time, DropletGenerator<T>& generator, Simulation<T>& simulation) :
+    Event<T>(time, 1), generator(generator), simulation(simulation) {}
+
+template<typename T>
+void DropletGeneratorEvent<T>::performEvent() {
+    // the droplet is only created now, so that droplets that are waiting for their injection do not take up memory
+    auto droplet = simulation.addDroplet(generator.getFluid()->getId(), generator.getVolume());
+    droplet->setName(generator.getName());
+    generator.addInjectedDroplet();
+    injectDroplet(*droplet, generator.getInjectionPosition());
+}
+
+template<typename T>
+void DropletGeneratorEvent<T>::print() {
+    std::cout << "\n Droplet Generator Event at t=" << this->time << " with priority " << this->priority << "\n" << std::endl;
+}
+
 }  // namespace sim
@@ -185,6 +185,183 @@ TEST(Network, testNetwork5) {
     ASSERT_NEAR(node3->getPressure(), -35.5, errorTolerance);
 }
 
+TEST(Network, sparseSolver) {
+    // define network
+    arch::Network<T> network;
+    // nodes
+    auto node1 = network.addNode(0.0, 0.0, false);
+    auto node2 = network.addNode(0.0, 0.0, false);
+    auto node3 = network.addNode(0.0, 0.0, false);
+    auto node4 = network.addNode(0.0, 0.0, false);
+    auto node5 = network.addNode(0.0, 0.0, false);
+    auto node0 = network.addNode(0.0, 0.0, true);
+
+    // pressure pump (voltage sources)
+    auto v0 = network.addPressurePump(node0->getId(), node1->getId(), 1.0);
+    auto v1 = network.addPressurePump(node5->getId(), node0->getId(), 2.0);
+
+    // flowRate pump (current source)
+    network.addFlowRatePump(node0->getId(), node2->getId(), 1.0);
+
+    // channels
+    network.addChannel(node1->getId(), node2->getId(), 5, arch::ChannelType::NORMAL);
+    network.addChannel(node0->getId(), node2->getId(), 10, arch::ChannelType::NORMAL);
+    network.addChannel(node2->getId(), node3->getId(), 20, arch::ChannelType::NORMAL);
+    network.addChannel(node3->getId(), node4->getId(), 30, arch::ChannelType::NORMAL);
+
+    // compute network with the sparse solver
+    network.sortGroups();
+    nodal::conductNodalAnalysis(&network, nodal::SolverType::SparseLU);
+
+    // check result (identical to testNetwork2)
+    const double errorTolerance = 1e-6;
+    // pressure at nodes
+    ASSERT_NEAR(node1->getPressure(), 1.0, errorTolerance);
+    ASSERT_NEAR(node2->getPressure(), 4.0, errorTolerance);
+    ASSERT_NEAR(node3->getPressure(), 4.0, errorTolerance);
+    ASSERT_NEAR(node4->getPressure(), 4.0, errorTolerance);
+    ASSERT_NEAR(node5->getPressure(), -2.0, errorTolerance);
+    // flow rate at pressure pumps
+    ASSERT_NEAR(v0->getFlowRate(), 0.6, errorTolerance);
+    ASSERT_NEAR(v1->getFlowRate(), 0.0, errorTolerance);
+}
+
+TEST(Network, indexMap) {
+    // define network with the ground node first, so that node ids and matrix rows differ
+    arch::Network<T> network;
+    // nodes
+    auto node0 = network.addNode(0.0, 0.0, true);
+    auto node1 = network.addNode(0.0, 0.0, false);
+    auto node2 = network.addNode(0.0, 0.0, false);
+    auto node3 = network.addNode(0.0, 0.0, false);
+
+    // pressure pump (voltage sources)
+    auto v0 = network.addPressurePump(node0->getId(), node1->getId(), 1.0);
+
+    // channels
+    auto c1 = network.addChannel(node1->getId(), node2->getId(), 5, arch::ChannelType::NORMAL);
+    auto c2 = network.addChannel(node2->getId(), node3->getId(), 10, arch::ChannelType::NORMAL);
+    auto c3 = network.addChannel(node3->getId(), node0->getId(), 5, arch::ChannelType::NORMAL);
+
+    ASSERT_FALSE(network.isIndexMapValid());
+
+    // compute network
+    network.sortGroups();
+    ASSERT_TRUE(network.isIndexMapValid());
+
+    // check index map
+    const auto& indexMap = network.getIndexMap();
+    ASSERT_EQ(indexMap.nNodeRows, 3);
+    ASSERT_EQ(indexMap.nodeRows.at(node0->getId()), -1);
+    ASSERT_EQ(indexMap.nodeRows.at(node1->getId()), 0);
+    ASSERT_EQ(indexMap.nodeRows.at(node2->getId()), 1);
+    ASSERT_EQ(indexMap.nodeRows.at(node3->getId()), 2);
+    ASSERT_EQ(indexMap.channels.size(), 3);
+    for (auto channel : {c1, c2, c3}) {
+        ASSERT_EQ(indexMap.channels.at(indexMap.channelIndices.at(channel->getId())), channel);
+    }
+    ASSERT_EQ(indexMap.pressurePumps.size(), 1);
+
+    nodal::conductNodalAnalysis(&network);
+
+    // check result
+    const double errorTolerance = 1e-6;
+    // pressure at nodes
+    ASSERT_NEAR(node0->getPressure(), 0.0, errorTolerance);
+    ASSERT_NEAR(node1->getPressure(), 1.0, errorTolerance);
+    ASSERT_NEAR(node2->getPressure(), 0.75, errorTolerance);
+    ASSERT_NEAR(node3->getPressure(), 0.25, errorTolerance);
+    // flow rate at pressure pumps
+    ASSERT_NEAR(v0->getFlowRate(), -0.05, errorTolerance);
+
+    // a change of the topology invalidates the index map, which is rebuilt by the nodal analysis
+    network.addChannel(node1->getId(), node3->getId(), 5, arch::ChannelType::NORMAL);
+    ASSERT_FALSE(network.isIndexMapValid());
+    nodal::conductNodalAnalysis(&network);
+    ASSERT_TRUE(network.isIndexMapValid());
+    ASSERT_EQ(network.getIndexMap().channels.size(), 4);
+}
+
+TEST(Network, changedChannels) {
+    // define network
+    arch::Network<T> network;
+    // nodes
+    auto node0 = network.addNode(0.0, 0.0, true);
+    auto node1 = network.addNode(0.0, 0.0, false);
+    auto node2 = network.addNode(0.0, 0.0, false);
+    auto node3 = network.addNode(0.0, 0.0, false);
+
+    // pressure pump (voltage sources)
+    network.addPressurePump(node0->getId(), node1->getId(), 1.0);
+
+    // channels
+    network.addChannel(node1->getId(), node2->getId(), 5, arch::ChannelType::NORMAL);
+    auto c2 = network.addChannel(node2->getId(), node3->getId(), 10, arch::ChannelType::NORMAL);
+    network.addChannel(node3->getId(), node0->getId(), 5, arch::ChannelType::NORMAL);
+
+    network.sortGroups();
+    nodal::NodalAnalysis<T> nodalAnalysis(&network, nodal::SolverType::SparseLU);
+    nodalAnalysis.setIncrementalUpdates(true);
+    nodalAnalysis.conductNodalAnalysis();
+    ASSERT_EQ(nodalAnalysis.getFactorizations(), 1);
+
+    // the reported change of a channel is handled by a low-rank update of the factorization
+    c2->setDropletResistance(10);
+    nodalAnalysis.setChangedChannels({c2->getId()});
+    nodalAnalysis.conductNodalAnalysis();
+    ASSERT_EQ(nodalAnalysis.getFactorizations(), 1);
+    ASSERT_EQ(nodalAnalysis.getIncrementalSolves(), 1);
+
+    // check result
+    const double errorTolerance = 1e-6;
+    ASSERT_NEAR(node1->getPressure(), 1.0, errorTolerance);
+    ASSERT_NEAR(node2->getPressure(), 25.0 / 30.0, errorTolerance);
+    ASSERT_NEAR(node3->getPressure(), 5.0 / 30.0, errorTolerance);
+
+    // without a report, the changed channels are found by comparing all channels
+    c2->setDropletResistance(0);
+    nodalAnalysis.conductNodalAnalysis();
+    ASSERT_EQ(nodalAnalysis.getIncrementalSolves(), 2);
+    ASSERT_NEAR(node2->getPressure(), 0.75, errorTolerance);
+    ASSERT_NEAR(node3->getPressure(), 0.25, errorTolerance);
+}
+
+TEST(Network, rejectedUpdate) {
+    // define network
+    arch::Network<T> network;
+    // nodes
+    auto node0 = network.addNode(0.0, 0.0, true);
+    auto node1 = network.addNode(0.0, 0.0, false);
+    auto node2 = network.addNode(0.0, 0.0, false);
+    auto node3 = network.addNode(0.0, 0.0, false);
+
+    // pressure pump (voltage sources)
+    network.addPressurePump(node0->getId(), node1->getId(), 1e3);
+
+    // channels, c2 is short compared to the other channels
+    network.addChannel(node1->getId(), node2->getId(), 1e12, arch::ChannelType::NORMAL);
+    auto c2 = network.addChannel(node2->getId(), node3->getId(), 1e3, arch::ChannelType::NORMAL);
+    network.addChannel(node3->getId(), node0->getId(), 1e12, arch::ChannelType::NORMAL);
+
+    network.sortGroups();
+    nodal::NodalAnalysis<T> nodalAnalysis(&network, nodal::SolverType::SparseLU);
+    nodalAnalysis.setIncrementalUpdates(true);
+    nodalAnalysis.conductNodalAnalysis();
+
+    // blocking the short channel cancels almost all digits of the low-rank update, the pump row dominates the
+    // unscaled residual, so only the row-wise residual detects the error in the pressures and refactorizes
+    c2->setDropletResistance(1e24);
+    nodalAnalysis.setChangedChannels({c2->getId()});
+    nodalAnalysis.conductNodalAnalysis();
+    ASSERT_EQ(nodalAnalysis.getIncrementalSolves(), 0);
+    ASSERT_EQ(nodalAnalysis.getFactorizations(), 2);
+
+    // check result
+    ASSERT_NEAR(node1->getPressure(), 1e3, 1e-6);
+    ASSERT_NEAR(node2->getPressure(), 1e3, 1e-6);
+    ASSERT_NEAR(node3->getPressure(), 1e-9, 1e-12);
+}
+
 TEST(Network, networkArchitectureDefinition) {
     // define network
     arch::Network<T> bionetwork;
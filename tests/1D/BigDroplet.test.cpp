@@ -4,6 +4,92 @@
 
 using T = double;
 
+/**
+ * @brief Droplet simulation for the tests that compare several executions of the same simulation. Either defined by a JSON file or
+ * by a network with a bifurcation, in which a generator periodically injects droplets that take different paths and merge again.
+ */
+struct DropletSimulation {
+    arch::Network<T> network;
+    sim::Simulation<T> simulation;
+    std::unique_ptr<sim::ResistanceModel1D<T>> resistanceModel;
+    int inletChannel = -1;          ///< Channel in which the generator injects the droplets.
+
+    /**
+     * @brief Define the simulation of the bifurcation network.
+     * @param[in] nDroplets Number of droplets that are injected by the generator.
+     * @param[in] injectionInterval Time between two injections in s.
+     */
+    DropletSimulation(int nDroplets, T injectionInterval) {
+        simulation.setType(sim::Type::Abstract);
+        simulation.setPlatform(sim::Platform::BigDroplet);
+        simulation.setNetwork(&network);
+
+        // nodes
+        auto node1 = network.addNode(0.0, 0.0, false);
+        auto node2 = network.addNode(1e-3, 0.0, false);
+        auto node3 = network.addNode(2e-3, 0.0, false);
+        auto node4 = network.addNode(2.5e-3, 0.86602540378e-3, false);
+        auto node5 = network.addNode(3e-3, 0.0, false);
+        auto node0 = network.addNode(4e-3, 0.0, false);
+
+        // flowRate pump
+        network.addFlowRatePump(node0->getId(), node1->getId(), 3e-11);
+
+        // channels
+        auto cWidth = 100e-6;
+        auto cHeight = 30e-6;
+        auto cLength = 1000e-6;
+
+        auto c1 = network.addChannel(node1->getId(), node2->getId(), cHeight, cWidth, cLength, arch::ChannelType::NORMAL);
+        network.addChannel(node2->getId(), node3->getId(), cHeight, cWidth, cLength, arch::ChannelType::NORMAL);
+        network.addChannel(node3->getId(), node4->getId(), cHeight, cWidth, cLength, arch::ChannelType::NORMAL);
+        network.addChannel(node3->getId(), node5->getId(), cHeight, 2 * cWidth, cLength, arch::ChannelType::NORMAL);
+        network.addChannel(node4->getId(), node5->getId(), cHeight, cWidth, cLength, arch::ChannelType::NORMAL);
+        network.addChannel(node5->getId(), node0->getId(), cHeight, cWidth, cLength, arch::ChannelType::NORMAL);
+        inletChannel = c1->getId();
+
+        //--- sink ---
+        network.setSink(node0->getId());
+        //--- ground ---
+        network.setGround(node0->getId());
+
+        // fluids
+        auto fluid0 = simulation.addFluid(1e-3, 1e3, 1.0);
+        auto fluid1 = simulation.addFluid(3e-3, 1e3, 1.0);
+        //--- continuousPhase ---
+        simulation.setContinuousPhase(fluid0->getId());
+
+        // droplets
+        simulation.addDropletGenerator(fluid1->getId(), 0.8 * cWidth * cWidth * cHeight, c1->getId(), 0.5, 0.0, injectionInterval, nDroplets);
+
+        // check if chip is valid
+        network.isNetworkValid();
+        network.sortGroups();
+
+        resistanceModel = std::make_unique<sim::ResistanceModel1D<T>>(simulation.getContinuousPhase()->getViscosity());
+        simulation.setResistanceModel(resistanceModel.get());
+    }
+
+    /**
+     * @brief Define the simulation of a JSON file.
+     * @param[in] jsonString Content of the JSON file.
+     */
+    explicit DropletSimulation(const json& jsonString) :
+        network(porting::networkFromJSON<T>(jsonString)), simulation(porting::simulationFromJSON<T>(jsonString, &network)) {
+        network.sortGroups();
+        network.isNetworkValid();
+    }
+
+    /**
+     * @brief Define the simulation of a JSON file.
+     * @param[in] file Location of the JSON file.
+     */
+    explicit DropletSimulation(const std::string& file) : DropletSimulation(json::parse(std::ifstream(file))) { }
+
+    DropletSimulation(const DropletSimulation&) = delete;
+    DropletSimulation& operator=(const DropletSimulation&) = delete;
+};
+
 TEST(BigDroplet, allResultValues) {
     // define simulation
     sim::Simulation<T> testSimulation;
@@ -1028,3 +1114,974 @@ TEST(BigDroplet, noSinkTwoDroplets) {
     // simulate
     testSimulation.simulate();
 }
+
+TEST(BigDroplet, sparseSolver) {
+    // define the same droplet simulation for the dense and the sparse solver
+    auto defineSimulation = [](nodal::SolverType solver, arch::Network<T>& network, sim::Simulation<T>& testSimulation) {
+        testSimulation.setType(sim::Type::Abstract);
+        testSimulation.setPlatform(sim::Platform::BigDroplet);
+        testSimulation.setSolverType(solver);
+        testSimulation.setNetwork(&network);
+
+        // nodes
+        auto node1 = network.addNode(0.0, 0.0, false);
+        auto node2 = network.addNode(1e-3, 0.0, false);
+        auto node3 = network.addNode(2e-3, 0.0, false);
+        auto node4 = network.addNode(2.5e-3, 0.86602540378e-3, false);
+        auto node5 = network.addNode(3e-3, 0.0, false);
+        auto node0 = network.addNode(4e-3, 0.0, false);
+
+        // flowRate pump
+        network.addFlowRatePump(node0->getId(), node1->getId(), 3e-11);
+
+        // channels
+        auto cWidth = 100e-6;
+        auto cHeight = 30e-6;
+        auto cLength = 1000e-6;
+
+        auto c1 = network.addChannel(node1->getId(), node2->getId(), cHeight, cWidth, cLength, arch::ChannelType::NORMAL);
+        network.addChannel(node2->getId(), node3->getId(), cHeight, cWidth, cLength, arch::ChannelType::NORMAL);
+        network.addChannel(node3->getId(), node4->getId(), cHeight, cWidth, cLength, arch::ChannelType::NORMAL);
+        network.addChannel(node3->getId(), node5->getId(), cHeight, cWidth, cLength, arch::ChannelType::NORMAL);
+        network.addChannel(node4->getId(), node5->getId(), cHeight, cWidth, cLength, arch::ChannelType::NORMAL);
+        network.addChannel(node5->getId(), node0->getId(), cHeight, cWidth, cLength, arch::ChannelType::NORMAL);
+
+        //--- sink ---
+        network.setSink(node0->getId());
+        //--- ground ---
+        network.setGround(node0->getId());
+
+        // fluids
+        auto fluid0 = testSimulation.addFluid(1e-3, 1e3, 1.0);
+        auto fluid1 = testSimulation.addFluid(3e-3, 1e3, 1.0);
+        //--- continuousPhase ---
+        testSimulation.setContinuousPhase(fluid0->getId());
+
+        // droplet
+        auto dropletVolume = 1.5 * cWidth * cWidth * cHeight;
+        auto droplet0 = testSimulation.addDroplet(fluid1->getId(), dropletVolume);
+        testSimulation.addDropletInjection(droplet0->getId(), 0.0, c1->getId(), 0.5);
+
+        // check if chip is valid
+        network.isNetworkValid();
+        network.sortGroups();
+    };
+
+    arch::Network<T> denseNetwork;
+    sim::Simulation<T> denseSimulation;
+    defineSimulation(nodal::SolverType::DenseQR, denseNetwork, denseSimulation);
+    sim::ResistanceModel1D<T> denseResistanceModel = sim::ResistanceModel1D<T>(denseSimulation.getContinuousPhase()->getViscosity());
+    denseSimulation.setResistanceModel(&denseResistanceModel);
+    denseSimulation.simulate();
+
+    arch::Network<T> sparseNetwork;
+    sim::Simulation<T> sparseSimulation;
+    defineSimulation(nodal::SolverType::SparseLU, sparseNetwork, sparseSimulation);
+    sim::ResistanceModel1D<T> sparseResistanceModel = sim::ResistanceModel1D<T>(sparseSimulation.getContinuousPhase()->getViscosity());
+    sparseSimulation.setResistanceModel(&sparseResistanceModel);
+    sparseSimulation.simulate();
+
+    // the symbolic factorization is computed once and reused for all events
+    ASSERT_EQ(sparseSimulation.getNodalAnalysis()->getPatternAnalyses(), 1);
+    ASSERT_GT(sparseSimulation.getNodalAnalysis()->getFactorizations(), 1);
+
+    // results
+    auto& denseStates = denseSimulation.getSimulationResults()->getStates();
+    auto& sparseStates = sparseSimulation.getSimulationResults()->getStates();
+    ASSERT_EQ(denseStates.size(), sparseStates.size());
+    for (size_t i = 0; i < denseStates.size(); ++i) {
+        ASSERT_NEAR(denseStates.at(i)->getTime(), sparseStates.at(i)->getTime(), 1e-9);
+        for (auto& [nodeId, pressure] : denseStates.at(i)->getPressures()) {
+            ASSERT_NEAR(pressure, sparseStates.at(i)->getPressures().at(nodeId), 1e-6);
+        }
+    }
+
+    // low-rank updates of the factorization for the changed droplet resistances
+    arch::Network<T> incrementalNetwork;
+    sim::Simulation<T> incrementalSimulation;
+    defineSimulation(nodal::SolverType::SparseLU, incrementalNetwork, incrementalSimulation);
+    incrementalSimulation.setIncrementalNodalUpdates(true);
+    sim::ResistanceModel1D<T> incrementalResistanceModel = sim::ResistanceModel1D<T>(incrementalSimulation.getContinuousPhase()->getViscosity());
+    incrementalSimulation.setResistanceModel(&incrementalResistanceModel);
+    incrementalSimulation.simulate();
+
+    ASSERT_GT(incrementalSimulation.getNodalAnalysis()->getIncrementalSolves(), 0);
+    ASSERT_LT(incrementalSimulation.getNodalAnalysis()->getFactorizations(), sparseSimulation.getNodalAnalysis()->getFactorizations());
+
+    auto& incrementalStates = incrementalSimulation.getSimulationResults()->getStates();
+    ASSERT_EQ(denseStates.size(), incrementalStates.size());
+    for (size_t i = 0; i < denseStates.size(); ++i) {
+        ASSERT_NEAR(denseStates.at(i)->getTime(), incrementalStates.at(i)->getTime(), 1e-9);
+        for (auto& [nodeId, pressure] : denseStates.at(i)->getPressures()) {
+            ASSERT_NEAR(pressure, incrementalStates.at(i)->getPressures().at(nodeId), 1e-6);
+        }
+    }
+}
+
+TEST(BigDroplet, eventQueue) {
+    sim::ObjectPool pool;
+    sim::EventQueue<T> queue;
+    ASSERT_TRUE(queue.empty());
+
+    // events are ordered by time, priority and key
+    queue.push(0, 0, 3.0, pool.create<sim::TimeStepEvent<T>>(3.0));
+    queue.push(1, 0, 1.0, pool.create<sim::TimeStepEvent<T>>(1.0));
+    queue.push(1, 1, 2.0, pool.create<sim::TimeStepEvent<T>>(2.0));
+    queue.push(2, 0, 1.0, pool.create<sim::TimeStepEvent<T>>(1.0));
+    ASSERT_EQ(queue.size(), 4);
+    ASSERT_EQ(queue.topTime(), 1.0);
+    ASSERT_EQ(queue.topDroplet(), 1);
+
+    // removing the events of a droplet keeps the order of the remaining events
+    queue.removeDroplet(1);
+    ASSERT_EQ(queue.size(), 2);
+    ASSERT_EQ(queue.topTime(), 1.0);
+    ASSERT_EQ(queue.topDroplet(), 2);
+    queue.removeDroplet(2);
+    ASSERT_EQ(queue.topTime(), 3.0);
+    ASSERT_EQ(queue.topDroplet(), 0);
+
+    // slots of removed events are reused
+    queue.push(3, 0, 0.5, pool.create<sim::TimeStepEvent<T>>(0.5));
+    ASSERT_EQ(queue.topDroplet(), 3);
+    queue.removeDroplet(4);
+    ASSERT_EQ(queue.size(), 2);
+
+    // a droplet whose events were removed gets new events, erasing a droplet removes its events as well
+    queue.push(1, 0, 0.25, pool.create<sim::TimeStepEvent<T>>(0.25));
+    ASSERT_EQ(queue.topDroplet(), 1);
+    queue.eraseDroplet(1);
+    ASSERT_EQ(queue.size(), 2);
+    ASSERT_EQ(queue.topDroplet(), 3);
+    queue.clear();
+    ASSERT_TRUE(queue.empty());
+
+    // the events were created in a single chunk of the pool and their memory was returned to it
+    ASSERT_EQ(pool.getAllocations(), 6);
+    ASSERT_EQ(pool.getHeapAllocations(), 1);
+    ASSERT_EQ(pool.getObjects(), 0);
+
+    // a boundary that reuses the memory of a removed boundary has a new id, hence the events computed for the removed boundary are not kept
+    arch::Network<T> network;
+    auto node0 = network.addNode(0.0, 0.0, true);
+    auto node1 = network.addNode(1e-3, 0.0, false);
+    auto c1 = network.addChannel(node0->getId(), node1->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+    sim::Fluid<T> fluid(0, 1e3, 1e-3, 1.0);
+    sim::Droplet<T> droplet(0, 1e-13, &fluid, &pool);
+    droplet.addBoundary(c1, 0.6, false, sim::BoundaryState::NORMAL);
+    auto removedBoundary = droplet.getBoundaries()[0].get();
+    auto removedId = removedBoundary->getId();
+    droplet.removeBoundary(*removedBoundary);
+    droplet.addBoundary(c1, 0.6, false, sim::BoundaryState::NORMAL);
+    ASSERT_EQ(droplet.getBoundaries()[0].get(), removedBoundary);
+    ASSERT_NE(droplet.getBoundaries()[0]->getId(), removedId);
+}
+
+TEST(BigDroplet, channelBoundaryIndex) {
+    arch::Network<T> network;
+    auto node0 = network.addNode(0.0, 0.0, true);
+    auto node1 = network.addNode(1e-3, 0.0, false);
+    auto node2 = network.addNode(2e-3, 0.0, false);
+    auto c1 = network.addChannel(node0->getId(), node1->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+    auto c2 = network.addChannel(node1->getId(), node2->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+
+    sim::Fluid<T> fluid(0, 1e3, 1e-3, 1.0);
+    sim::ChannelBoundaryIndex<T> index;
+    sim::Droplet<T> droplet0(0, 1e-13, &fluid, nullptr, &index);
+    sim::Droplet<T> droplet1(1, 1e-13, &fluid, nullptr, &index);
+
+    // boundaries are only indexed while the droplet is inside the network
+    droplet0.addBoundary(c1, 0.6, false, sim::BoundaryState::NORMAL);
+    droplet0.addBoundary(c1, 0.8, true, sim::BoundaryState::NORMAL);
+    ASSERT_EQ(index.getChannelBoundaries().size(), 0);
+    droplet0.setDropletState(sim::DropletState::NETWORK);
+    droplet1.setDropletState(sim::DropletState::NETWORK);
+    droplet1.addBoundary(c1, 0.1, false, sim::BoundaryState::NORMAL);
+    droplet1.addBoundary(c1, 0.3, true, sim::BoundaryState::NORMAL);
+
+    // the boundaries of a channel are sorted by their position
+    auto& boundaries = index.getChannelBoundaries().at(c1->getId());
+    ASSERT_EQ(boundaries.size(), 4);
+    ASSERT_EQ(boundaries[0].droplet, &droplet1);
+    ASSERT_EQ(boundaries[1].droplet, &droplet1);
+    ASSERT_EQ(boundaries[2].droplet, &droplet0);
+    ASSERT_EQ(boundaries[3].droplet, &droplet0);
+    ASSERT_EQ(boundaries[3].boundary, droplet0.getBoundaries()[1].get());
+
+    // moving a boundary to the next channel updates both lists
+    droplet0.moveBoundary(*droplet0.getBoundaries()[1], c2, 0.0, false);
+    ASSERT_EQ(index.getChannelBoundaries().at(c1->getId()).size(), 3);
+    ASSERT_EQ(index.getChannelBoundaries().at(c2->getId()).size(), 1);
+    ASSERT_EQ(index.getChannelBoundaries().at(c2->getId())[0].boundary, droplet0.getBoundaries()[1].get());
+
+    // removed boundaries and droplets that left the network are removed from the index
+    droplet1.removeBoundary(*droplet1.getBoundaries()[0]);
+    ASSERT_EQ(index.getChannelBoundaries().at(c1->getId()).size(), 2);
+    droplet0.setDropletState(sim::DropletState::SINK);
+    ASSERT_EQ(index.getChannelBoundaries().at(c1->getId()).size(), 1);
+    ASSERT_EQ(index.getChannelBoundaries().at(c2->getId()).size(), 0);
+    ASSERT_EQ(index.getUpdates(), 9);
+}
+
+TEST(BigDroplet, nodeOccupancyIndex) {
+    arch::Network<T> network;
+    auto node0 = network.addNode(0.0, 0.0, true);
+    auto node1 = network.addNode(1e-3, 0.0, false);
+    auto node2 = network.addNode(2e-3, 0.0, false);
+    auto node3 = network.addNode(3e-3, 0.0, false);
+    auto c1 = network.addChannel(node0->getId(), node1->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+    auto c2 = network.addChannel(node1->getId(), node2->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+    auto c3 = network.addChannel(node2->getId(), node3->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+
+    sim::Fluid<T> fluid(0, 1e3, 1e-3, 1.0);
+    sim::NodeOccupancyIndex<T> index;
+    sim::Droplet<T> droplet(0, 1e-13, &fluid, nullptr, nullptr, &index);
+
+    // a droplet inside a single channel does not span over a node
+    droplet.addBoundary(c1, 0.6, false, sim::BoundaryState::NORMAL);
+    droplet.addBoundary(c1, 0.8, true, sim::BoundaryState::NORMAL);
+    droplet.setDropletState(sim::DropletState::NETWORK);
+    ASSERT_EQ(index.getDroplet(node0->getId()), nullptr);
+    ASSERT_EQ(index.getDroplet(node1->getId()), nullptr);
+
+    // the head moves into the next channel, hence the droplet spans over node1
+    droplet.moveBoundary(*droplet.getBoundaries()[1], c2, 0.0, true);
+    ASSERT_EQ(index.getDroplet(node1->getId()), &droplet);
+    ASSERT_EQ(index.getDroplet(node2->getId()), nullptr);
+
+    // the head moves on and c2 becomes fully occupied
+    droplet.addFullyOccupiedChannel(c2);
+    droplet.moveBoundary(*droplet.getBoundaries()[1], c3, 0.0, true);
+    ASSERT_EQ(index.getDroplet(node1->getId()), &droplet);
+    ASSERT_EQ(index.getDroplet(node2->getId()), &droplet);
+
+    // droplets that left the network are removed from the index
+    droplet.setDropletState(sim::DropletState::SINK);
+    ASSERT_EQ(index.getDroplet(node1->getId()), nullptr);
+    ASSERT_EQ(index.getDroplet(node2->getId()), nullptr);
+}
+
+TEST(BigDroplet, boundaryStore) {
+    arch::Network<T> network;
+    auto node0 = network.addNode(0.0, 0.0, true);
+    auto node1 = network.addNode(1e-3, 0.0, false);
+    auto c1 = network.addChannel(node0->getId(), node1->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+    auto c2 = network.addChannel(node0->getId(), node1->getId(), 30e-6, 200e-6, 2e-3, arch::ChannelType::NORMAL);
+
+    // the same boundaries are kept in the store and by themselves
+    sim::Fluid<T> fluid(0, 1e3, 1e-3, 1.0);
+    sim::BoundaryStore<T> store;
+    auto droplet = std::make_unique<sim::Droplet<T>>(0, 1e-13, &fluid, nullptr, nullptr, nullptr, &store);
+    sim::Droplet<T> reference(1, 1e-13, &fluid);
+    const std::vector<std::tuple<arch::RectangularChannel<T>*, T, bool, T>> boundaries = {
+        {c1, 0.2, false, 1e-11}, {c1, 0.4, true, -2e-11}, {c2, 0.9, true, 3e-11}, {c2, 0.5, false, 0.0}, {c2, 0.01, false, 4e-11}};
+    for (auto& [channel, position, volumeTowardsNodeA, flowRate] : boundaries) {
+        droplet->addBoundary(channel, position, volumeTowardsNodeA, sim::BoundaryState::NORMAL);
+        droplet->getBoundaries().back()->setFlowRate(flowRate);
+        reference.addBoundary(channel, position, volumeTowardsNodeA, sim::BoundaryState::NORMAL);
+        reference.getBoundaries().back()->setFlowRate(flowRate);
+    }
+    droplet->setDropletState(sim::DropletState::NETWORK);
+    ASSERT_EQ(store.size(), boundaries.size());
+    ASSERT_EQ(store.getSlots(), boundaries.size());
+
+    // the boundaries are views of their slots
+    for (size_t i = 0; i < boundaries.size(); ++i) {
+        auto& boundary = droplet->getBoundaries()[i];
+        ASSERT_EQ(boundary->getChannelPosition().getChannel(), store.getChannel(boundary->getSlot()));
+        ASSERT_EQ(boundary->getChannelPosition().getPosition(), store.getPosition(boundary->getSlot()));
+        ASSERT_EQ(boundary->getFlowRate(), store.getFlowRate(boundary->getSlot()));
+        ASSERT_EQ(boundary->isVolumeTowardsNodeA(), std::get<2>(boundaries[i]));
+    }
+
+    // the times until the channel ends are equal to the ones of the boundaries
+    store.computeTimes();
+    for (size_t i = 0; i < boundaries.size(); ++i) {
+        ASSERT_EQ(store.getTime(droplet->getBoundaries()[i]->getSlot()), reference.getBoundaries()[i]->getTime());
+        ASSERT_EQ(droplet->getBoundaries()[i]->getTime(), reference.getBoundaries()[i]->getTime());
+    }
+    ASSERT_EQ(store.getTime(droplet->getBoundaries()[3]->getSlot()), 0.0);
+
+    // the store moves the boundaries and keeps them inside their channels
+    const T timeStep = 0.05;
+    store.move(timeStep);
+    for (size_t i = 0; i < boundaries.size(); ++i) {
+        reference.getBoundaries()[i]->moveBoundary(timeStep);
+        ASSERT_EQ(droplet->getBoundaries()[i]->getChannelPosition().getPosition(), reference.getBoundaries()[i]->getChannelPosition().getPosition());
+    }
+    ASSERT_EQ(droplet->getBoundaries()[4]->getChannelPosition().getPosition(), 0.0);
+
+    // a copy of a boundary owns its position
+    sim::DropletBoundary<T> copy = *droplet->getBoundaries()[0];
+    droplet->moveBoundary(*droplet->getBoundaries()[0], c2, 0.5, true);
+    ASSERT_EQ(store.getChannel(droplet->getBoundaries()[0]->getSlot()), c2);
+    ASSERT_EQ(store.getPosition(droplet->getBoundaries()[0]->getSlot()), 0.5);
+    ASSERT_TRUE(droplet->getBoundaries()[0]->isVolumeTowardsNodeA());
+    ASSERT_EQ(copy.getId(), droplet->getBoundaries()[0]->getId());
+    ASSERT_EQ(copy.getChannelPosition().getChannel(), c1);
+    ASSERT_EQ(copy.getChannelPosition().getPosition(), reference.getBoundaries()[0]->getChannelPosition().getPosition());
+    ASSERT_FALSE(copy.isVolumeTowardsNodeA());
+
+    // the boundaries of droplets outside of the network (e.g., trapped droplets) are not moved
+    droplet->setDropletState(sim::DropletState::TRAPPED);
+    const T trappedPosition = droplet->getBoundaries()[1]->getChannelPosition().getPosition();
+    store.move(timeStep);
+    ASSERT_EQ(droplet->getBoundaries()[1]->getChannelPosition().getPosition(), trappedPosition);
+
+    // the slots of removed boundaries are reused, but not their ids
+    const size_t slot = droplet->getBoundaries()[2]->getSlot();
+    const uint64_t id = droplet->getBoundaries()[2]->getId();
+    droplet->removeBoundary(*droplet->getBoundaries()[2]);
+    ASSERT_EQ(store.size(), boundaries.size() - 1);
+    droplet->addBoundary(c1, 0.3, true, sim::BoundaryState::NORMAL);
+    ASSERT_EQ(droplet->getBoundaries().back()->getSlot(), slot);
+    ASSERT_NE(droplet->getBoundaries().back()->getId(), id);
+    ASSERT_EQ(droplet->getBoundaries().back()->getFlowRate(), 0.0);
+    ASSERT_EQ(store.getSlots(), boundaries.size());
+
+    // the boundaries free their slots with their droplet
+    droplet.reset();
+    ASSERT_EQ(store.size(), 0);
+}
+
+TEST(BigDroplet, nodeOccupancyIndexSimulation) {
+    // closely injected droplets, which merge at the bifurcation
+    DropletSimulation merging(40, 0.01);
+    auto& simulation = merging.simulation;
+
+    // the index agrees with a scan over all droplets at every node after every event
+    simulation.initialize();
+    int nEvents = 0;
+    while (simulation.step()) {
+        for (auto& [nodeId, node] : merging.network.getNodes()) {
+            ASSERT_EQ(simulation.getDropletAtNode(nodeId) == nullptr, simulation.scanDropletAtNode(nodeId) == nullptr);
+        }
+        nEvents++;
+    }
+    ASSERT_GT(nEvents, 100);
+
+    int nMerges = 0;
+    for (auto& [dropletId, droplet] : simulation.getRetiredDroplets()) {
+        nMerges += !droplet->getMergedDroplets().empty();
+    }
+    ASSERT_GT(nMerges, 5);
+}
+
+TEST(BigDroplet, retiredDroplets) {
+    // define simulation
+    sim::Simulation<T> testSimulation;
+    testSimulation.setType(sim::Type::Abstract);
+    testSimulation.setPlatform(sim::Platform::BigDroplet);
+    arch::Network<T> network;
+    testSimulation.setNetwork(&network);
+
+    // nodes
+    auto node0 = network.addNode(0.0, 0.0, false);
+    auto node1 = network.addNode(1e-3, 0.0, false);
+    auto node2 = network.addNode(2e-3, 0.0, false);
+
+    // channels
+    auto c1 = network.addChannel(node0->getId(), node1->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+    network.addChannel(node1->getId(), node2->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+
+    // flowRate pump, sink and ground
+    network.addFlowRatePump(node2->getId(), node0->getId(), 3e-11);
+    network.setSink(node2->getId());
+    network.setGround(node2->getId());
+
+    // fluids
+    auto fluid0 = testSimulation.addFluid(1e-3, 1e3, 1.0);
+    auto fluid1 = testSimulation.addFluid(3e-3, 1e3, 1.0);
+    testSimulation.setContinuousPhase(fluid0->getId());
+
+    // droplets
+    auto dropletVolume = 100e-6 * 100e-6 * 30e-6;
+    auto droplet0 = testSimulation.addDroplet(fluid1->getId(), dropletVolume);
+    testSimulation.addDropletInjection(droplet0->getId(), 0.0, c1->getId(), 0.5);
+    auto droplet1 = testSimulation.addDroplet(fluid1->getId(), dropletVolume);
+    testSimulation.addDropletInjection(droplet1->getId(), 0.5, c1->getId(), 0.5);
+
+    sim::ResistanceModel1D<T> resistanceModel = sim::ResistanceModel1D<T>(testSimulation.getContinuousPhase()->getViscosity());
+    testSimulation.setResistanceModel(&resistanceModel);
+    network.isNetworkValid();
+    network.sortGroups();
+    testSimulation.simulate();
+
+    // both droplets reached the sink and were retired, but can still be accessed for the results
+    ASSERT_EQ(testSimulation.getRetiredDroplets().size(), 2);
+    ASSERT_EQ(testSimulation.getDroplet(droplet0->getId()), droplet0);
+    ASSERT_EQ(droplet1->getDropletState(), sim::DropletState::SINK);
+
+    // retired droplets are not part of the states anymore
+    auto& states = testSimulation.getSimulationResults()->getStates();
+    ASSERT_EQ(states.back()->getDropletPositions().size(), 0);
+    bool inNetwork = false;
+    for (auto& state : states) {
+        inNetwork = inNetwork || state->getDropletPositions().count(droplet1->getId()) > 0;
+    }
+    ASSERT_TRUE(inNetwork);
+
+    // new droplets do not reuse the ids of retired droplets
+    ASSERT_EQ(testSimulation.addDroplet(fluid1->getId(), dropletVolume)->getId(), 2);
+}
+
+TEST(BigDroplet, dropletGenerator) {
+    // define simulation
+    sim::Simulation<T> testSimulation;
+    testSimulation.setType(sim::Type::Abstract);
+    testSimulation.setPlatform(sim::Platform::BigDroplet);
+    arch::Network<T> network;
+    testSimulation.setNetwork(&network);
+
+    // nodes
+    auto node0 = network.addNode(0.0, 0.0, false);
+    auto node1 = network.addNode(1e-3, 0.0, false);
+    auto node2 = network.addNode(2e-3, 0.0, false);
+
+    // channels
+    auto c1 = network.addChannel(node0->getId(), node1->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+    network.addChannel(node1->getId(), node2->getId(), 30e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+
+    // flowRate pump, sink and ground
+    network.addFlowRatePump(node2->getId(), node0->getId(), 3e-11);
+    network.setSink(node2->getId());
+    network.setGround(node2->getId());
+
+    // fluids
+    auto fluid0 = testSimulation.addFluid(1e-3, 1e3, 1.0);
+    auto fluid1 = testSimulation.addFluid(3e-3, 1e3, 1.0);
+    testSimulation.setContinuousPhase(fluid0->getId());
+
+    // generators, one with a number of droplets and one with an end time
+    auto dropletVolume = 100e-6 * 100e-6 * 30e-6;
+    auto generator0 = testSimulation.addDropletGenerator(fluid1->getId(), dropletVolume, c1->getId(), 0.5, 0.0, 0.5, 3);
+    auto generator1 = testSimulation.addDropletGenerator(fluid1->getId(), dropletVolume, c1->getId(), 0.5, 0.25, 0.5, -1, 1.0);
+    ASSERT_THROW(testSimulation.addDropletGenerator(fluid1->getId(), dropletVolume, c1->getId(), 0.5, 0.0, 0.5, -1), std::invalid_argument);
+    ASSERT_THROW(testSimulation.addDropletGenerator(fluid1->getId(), dropletVolume, c1->getId(), 0.5, 0.0, 0.0, 2), std::invalid_argument);
+    ASSERT_THROW(testSimulation.addDropletGenerator(fluid1->getId(), 2e3 * dropletVolume, c1->getId(), 0.5, 0.0, 0.5, 2), std::invalid_argument);
+
+    // the droplets are only created when they are injected
+    ASSERT_THROW(testSimulation.getDroplet(0), std::out_of_range);
+    ASSERT_EQ(testSimulation.getDropletGenerator(1), generator1);
+
+    sim::ResistanceModel1D<T> resistanceModel = sim::ResistanceModel1D<T>(testSimulation.getContinuousPhase()->getViscosity());
+    testSimulation.setResistanceModel(&resistanceModel);
+    network.isNetworkValid();
+    network.sortGroups();
+    testSimulation.simulate();
+
+    // three droplets of the first generator (t = 0.0, 0.5, 1.0) and two of the second one (t = 0.25, 0.75)
+    ASSERT_EQ(generator0->getInjectedDroplets(), 3);
+    ASSERT_EQ(generator1->getInjectedDroplets(), 2);
+    ASSERT_TRUE(generator0->isFinished());
+    ASSERT_TRUE(generator1->isFinished());
+
+    // all droplets reached the sink
+    ASSERT_EQ(testSimulation.getRetiredDroplets().size(), 5);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(testSimulation.getDroplet(i)->getVolume(), dropletVolume);
+        ASSERT_EQ(testSimulation.getDroplet(i)->getDropletState(), sim::DropletState::SINK);
+    }
+}
+
+TEST(BigDroplet, threadPool) {
+    sim::ThreadPool pool(4);
+    ASSERT_EQ(pool.getNumberOfThreads(), 4);
+
+    // the workers are reused by consecutive jobs, each index is visited once
+    std::vector<int> visits(1000, 0);
+    for (int job = 0; job < 100; ++job) {
+        pool.parallelFor(visits.size(), 0, 1, [&visits](size_t i) { visits[i]++; });
+    }
+    ASSERT_TRUE(std::all_of(visits.begin(), visits.end(), [](int v) { return v == 100; }));
+
+    // a job that is started from inside a job is called serially
+    std::vector<int> inner(16, 0);
+    pool.parallelFor(4, 4, 1, [&pool, &inner](size_t i) {
+        pool.parallelFor(4, 4, 1, [&inner, i](size_t j) { inner[4 * i + j]++; });
+    });
+    ASSERT_TRUE(std::all_of(inner.begin(), inner.end(), [](int v) { return v == 1; }));
+
+    // the first exception is rethrown after all threads finished
+    ASSERT_THROW(pool.parallelFor(100, 4, 1, [](size_t i) { if (i % 10 == 3) { throw std::invalid_argument("index"); } }), std::invalid_argument);
+    pool.parallelFor(visits.size(), 4, 1, [&visits](size_t i) { visits[i]++; });
+    ASSERT_EQ(visits[0], 101);
+}
+
+TEST(BigDroplet, parallelDroplets) {
+    // the same droplet simulation with many droplets for serial and parallel droplet updates
+    DropletSimulation serial(12, 0.15);
+    auto& serialSimulation = serial.simulation;
+    serialSimulation.simulate();
+
+    // every droplet is updated by its own chunk
+    DropletSimulation parallel(12, 0.15);
+    auto& parallelSimulation = parallel.simulation;
+    parallelSimulation.setDropletThreads(4, 1);
+    ASSERT_THROW(parallelSimulation.setDropletThreads(-1), std::invalid_argument);
+    ASSERT_THROW(parallelSimulation.setDropletThreads(4, 0), std::invalid_argument);
+    parallelSimulation.simulate();
+
+    // the results do not depend on the number of threads
+    ASSERT_EQ(parallelSimulation.getRetiredDroplets().size(), serialSimulation.getRetiredDroplets().size());
+    auto& serialStates = serialSimulation.getSimulationResults()->getStates();
+    auto& parallelStates = parallelSimulation.getSimulationResults()->getStates();
+    ASSERT_EQ(serialStates.size(), parallelStates.size());
+    for (size_t i = 0; i < serialStates.size(); ++i) {
+        ASSERT_EQ(serialStates.at(i)->getTime(), parallelStates.at(i)->getTime());
+        for (auto& [nodeId, pressure] : serialStates.at(i)->getPressures()) {
+            ASSERT_EQ(pressure, parallelStates.at(i)->getPressures().at(nodeId));
+        }
+        ASSERT_EQ(serialStates.at(i)->getDropletPositions().size(), parallelStates.at(i)->getDropletPositions().size());
+    }
+}
+
+TEST(BigDroplet, stepwiseSimulation) {
+    // the same droplet simulation for a complete and a stepwise execution
+    DropletSimulation complete(3, 0.5);
+    auto& simulation = complete.simulation;
+    simulation.simulate();
+    ASSERT_TRUE(simulation.isFinished());
+
+    // single steps lead to the same results as the complete simulation
+    DropletSimulation stepwise(3, 0.5);
+    auto& stepSimulation = stepwise.simulation;
+    stepSimulation.initialize();
+    ASSERT_FALSE(stepSimulation.isFinished());
+    ASSERT_EQ(stepSimulation.runEvents(2), 2);
+    ASSERT_EQ(stepSimulation.getSimulationResults()->getStates().size(), 2);
+    while (stepSimulation.step()) { }
+    ASSERT_TRUE(stepSimulation.isFinished());
+    ASSERT_EQ(stepSimulation.runEvents(1), 0);
+
+    auto& states = simulation.getSimulationResults()->getStates();
+    auto& stepStates = stepSimulation.getSimulationResults()->getStates();
+    ASSERT_EQ(states.size(), stepStates.size());
+    for (size_t i = 0; i < states.size(); ++i) {
+        ASSERT_EQ(states.at(i)->getTime(), stepStates.at(i)->getTime());
+        for (auto& [nodeId, pressure] : states.at(i)->getPressures()) {
+            ASSERT_EQ(pressure, stepStates.at(i)->getPressures().at(nodeId));
+        }
+    }
+
+    // pause the simulation and double the flow rate of the pump, the remaining droplets reach the sink earlier
+    DropletSimulation pause(3, 0.5);
+    auto& pauseNetwork = pause.network;
+    auto& pauseSimulation = pause.simulation;
+    pauseSimulation.runUntil(0.6);
+    ASSERT_EQ(pauseSimulation.getTime(), 0.6);
+    ASSERT_FALSE(pauseSimulation.isFinished());
+
+    auto pumpId = pauseNetwork.getFlowRatePumps().begin()->first;
+    pauseNetwork.getFlowRatePumps().at(pumpId)->setFlowRate(6e-11);
+    pauseSimulation.step();
+    ASSERT_NEAR(std::abs(pauseNetwork.getChannel(pause.inletChannel)->getFlowRate()), 6e-11, 1e-20);
+    pauseSimulation.runUntil(100.0);
+    ASSERT_TRUE(pauseSimulation.isFinished());
+    ASSERT_EQ(pauseSimulation.getRetiredDroplets().size(), 3);
+    ASSERT_LT(pauseSimulation.getSimulationResults()->getStates().back()->getTime(), states.back()->getTime());
+}
+
+TEST(BigDroplet, pausedSimulation) {
+    // the same droplet simulation with and without pauses
+    DropletSimulation complete(12, 0.15);
+    auto& simulation = complete.simulation;
+    simulation.simulate();
+    auto& states = simulation.getSimulationResults()->getStates();
+    const T endTime = states.back()->getTime();
+
+    // the pauses neither store additional states nor change the flow
+    DropletSimulation paused(12, 0.15);
+    auto& pausedSimulation = paused.simulation;
+    pausedSimulation.initialize();
+    const T pause = endTime / 50;
+    for (int k = 1; !pausedSimulation.isFinished(); ++k) {
+        pausedSimulation.runUntil(k * pause);
+    }
+    auto& pausedStates = pausedSimulation.getSimulationResults()->getStates();
+    ASSERT_EQ(states.size(), pausedStates.size());
+    for (size_t i = 0; i < states.size(); ++i) {
+        ASSERT_NEAR(states.at(i)->getTime(), pausedStates.at(i)->getTime(), 1e-12 * endTime);
+        for (auto& [nodeId, pressure] : states.at(i)->getPressures()) {
+            ASSERT_NEAR(pressure, pausedStates.at(i)->getPressures().at(nodeId), 1e-9 * std::abs(pressure));
+        }
+        for (auto& [edgeId, flowRate] : states.at(i)->getFlowRates()) {
+            ASSERT_NEAR(flowRate, pausedStates.at(i)->getFlowRates().at(edgeId), 1e-9 * std::abs(flowRate));
+        }
+        ASSERT_EQ(states.at(i)->getDropletPositions().size(), pausedStates.at(i)->getDropletPositions().size());
+    }
+}
+
+TEST(BigDroplet, deltaHistory) {
+    // the same droplet simulation with a full and a delta-encoded result
+    DropletSimulation full(12, 0.15);
+    auto& fullSimulation = full.simulation;
+    fullSimulation.simulate();
+
+    // lossless history with a keyframe every 4 states
+    DropletSimulation delta(12, 0.15);
+    auto& deltaSimulation = delta.simulation;
+    ASSERT_THROW(deltaSimulation.setDeltaHistory(0), std::invalid_argument);
+    ASSERT_THROW(deltaSimulation.setDeltaHistory(4, -1.0), std::invalid_argument);
+    deltaSimulation.setDeltaHistory(4);
+    deltaSimulation.simulate();
+
+    auto fullResult = fullSimulation.getSimulationResults();
+    auto deltaResult = deltaSimulation.getSimulationResults();
+    auto history = deltaResult->getDeltaHistory();
+    ASSERT_NE(history, nullptr);
+    ASSERT_TRUE(deltaResult->getStates().empty());
+    ASSERT_EQ(deltaResult->getNumberOfStates(), fullResult->getNumberOfStates());
+    ASSERT_THROW(deltaResult->getState(deltaResult->getNumberOfStates()), std::out_of_range);
+
+    // every state is reconstructed exactly, in any order
+    const size_t nStates = fullResult->getStates().size();
+    for (size_t k = 0; k < nStates; ++k) {
+        size_t i = (k * 7) % nStates;
+        auto& fullState = fullResult->getStates().at(i);
+        auto deltaState = deltaResult->getState(i);
+        ASSERT_EQ(fullState->getTime(), deltaState->getTime());
+        for (auto& [nodeId, pressure] : fullState->getPressures()) {
+            ASSERT_EQ(pressure, deltaState->getPressures().at(nodeId));
+        }
+        for (auto& [edgeId, flowRate] : fullState->getFlowRates()) {
+            ASSERT_EQ(flowRate, deltaState->getFlowRates().at(edgeId));
+        }
+        ASSERT_EQ(fullState->getDropletPositions().size(), deltaState->getDropletPositions().size());
+        for (auto& [dropletId, position] : fullState->getDropletPositions()) {
+            auto& deltaPosition = deltaState->getDropletPositions().at(dropletId);
+            ASSERT_EQ(position.channelIds, deltaPosition.channelIds);
+            ASSERT_EQ(position.boundaries.size(), deltaPosition.boundaries.size());
+            for (size_t b = 0; b < position.boundaries.size(); ++b) {
+                ASSERT_EQ(position.boundaries[b].getChannelPosition().getPosition(), deltaPosition.boundaries[b].getChannelPosition().getPosition());
+            }
+        }
+    }
+    // the JSON result is written from the reconstructed states (the droplets of a state are unordered)
+    auto fullJson = porting::resultToJSON<T>(&fullSimulation);
+    auto deltaJson = porting::resultToJSON<T>(&deltaSimulation);
+    ASSERT_EQ(fullJson["network"].size(), deltaJson["network"].size());
+    for (size_t i = 0; i < fullJson["network"].size(); ++i) {
+        ASSERT_EQ(fullJson["network"][i]["nodes"], deltaJson["network"][i]["nodes"]);
+        ASSERT_EQ(fullJson["network"][i]["channels"], deltaJson["network"][i]["channels"]);
+        ASSERT_EQ(fullJson["network"][i]["bigDroplets"].size(), deltaJson["network"][i]["bigDroplets"].size());
+    }
+
+    // only the changed values are stored
+    const size_t fullValues = nStates * (fullResult->getNodeIds().size() + fullResult->getEdgeIds().size());
+    ASSERT_LT(history->getStoredValues(), fullValues);
+
+    // a lossy history keeps the relative error of every value below its tolerance
+    DropletSimulation lossy(12, 0.15);
+    auto& lossySimulation = lossy.simulation;
+    lossySimulation.setDeltaHistory(16, 1e-3);
+    lossySimulation.simulate();
+
+    auto lossyResult = lossySimulation.getSimulationResults();
+    ASSERT_EQ(lossyResult->getNumberOfStates(), nStates);
+    ASSERT_LT(lossyResult->getDeltaHistory()->getStoredValues(), history->getStoredValues());
+    for (size_t i = 0; i < nStates; ++i) {
+        auto lossyState = lossyResult->getState(i);
+        for (auto& [edgeId, flowRate] : fullResult->getStates().at(i)->getFlowRates()) {
+            ASSERT_LE(std::abs(lossyState->getFlowRates().at(edgeId) - flowRate), 1e-3 * std::abs(flowRate) * (1.0 + 1e-3));
+        }
+    }
+}
+
+TEST(BigDroplet, resultSink) {
+    std::string file = "../examples/1D/Droplet/Network1.JSON";
+    std::string resultFile = (std::filesystem::temp_directory_path() / "mmft_result_sink.json").string();
+
+    // states kept in memory
+    DropletSimulation memory(file);
+    auto& memorySimulation = memory.simulation;
+    memorySimulation.simulate();
+    auto memoryJson = porting::resultToJSON<T>(&memorySimulation);
+
+    // states streamed into a file
+    DropletSimulation stream(file);
+    auto& streamSimulation = stream.simulation;
+    streamSimulation.setResultSink(std::make_unique<porting::JsonResultSink<T>>(resultFile, &streamSimulation));
+    auto sink = dynamic_cast<porting::JsonResultSink<T>*>(streamSimulation.getResultSink());
+    ASSERT_NE(sink, nullptr);
+
+    // the file is valid after every state, e.g., if the simulation is interrupted
+    streamSimulation.initialize();
+    for (int i = 0; i < 3; ++i) {
+        streamSimulation.step();
+        std::ifstream partialFile(resultFile);
+        auto partialJson = nlohmann::json::parse(partialFile);
+        ASSERT_EQ(partialJson["network"].size(), sink->getNumberOfStates());
+    }
+    streamSimulation.runUntil(std::numeric_limits<T>::max());
+
+    // the streamed file contains the same states, while no state is kept in memory
+    ASSERT_TRUE(streamSimulation.getSimulationResults()->getStates().empty());
+    std::ifstream streamFile(resultFile);
+    auto streamJson = nlohmann::ordered_json::parse(streamFile);
+    ASSERT_EQ(streamJson["network"], memoryJson["network"]);
+    ASSERT_EQ(streamJson["fluids"], memoryJson["fluids"]);
+    ASSERT_EQ(streamJson["platform"], memoryJson["platform"]);
+
+    // the memory sink is restored
+    streamSimulation.setResultSink(nullptr);
+    ASSERT_EQ(dynamic_cast<porting::JsonResultSink<T>*>(streamSimulation.getResultSink()), nullptr);
+
+    // the closing part is only written after every 4 states and when the simulation finished
+    DropletSimulation interval(file);
+    auto& intervalSimulation = interval.simulation;
+    intervalSimulation.setResultSink(std::make_unique<porting::JsonResultSink<T>>(resultFile, &intervalSimulation, 4));
+    auto intervalSink = dynamic_cast<porting::JsonResultSink<T>*>(intervalSimulation.getResultSink());
+    intervalSimulation.initialize();
+    while (intervalSink->getNumberOfStates() < 8) {
+        intervalSimulation.step();
+        if (intervalSink->getNumberOfStates() % 4 == 0) {
+            std::ifstream partialFile(resultFile);
+            auto partialJson = nlohmann::ordered_json::parse(partialFile);
+            ASSERT_EQ(partialJson["network"].size(), intervalSink->getNumberOfStates());
+            ASSERT_EQ(partialJson["fluids"], memoryJson["fluids"]);
+        }
+    }
+    intervalSimulation.runUntil(std::numeric_limits<T>::max());
+    std::ifstream intervalFile(resultFile);
+    auto intervalJson = nlohmann::ordered_json::parse(intervalFile);
+    ASSERT_EQ(intervalJson["network"], memoryJson["network"]);
+    ASSERT_EQ(intervalJson["fluids"], memoryJson["fluids"]);
+    ASSERT_THROW(porting::JsonResultSink<T>(resultFile, &intervalSimulation, 0), std::invalid_argument);
+    std::filesystem::remove(resultFile);
+}
+
+TEST(BigDroplet, binaryResult) {
+    std::string file = "../examples/1D/Droplet/Network1.JSON";
+    std::string resultFile = (std::filesystem::temp_directory_path() / "mmft_binary_result.bin").string();
+
+    // states kept in memory
+    DropletSimulation memory(file);
+    auto& memorySimulation = memory.simulation;
+    memorySimulation.simulate();
+    auto memoryResult = memorySimulation.getSimulationResults();
+
+    // states written into a binary file in chunks of 4 states
+    DropletSimulation binary(file);
+    auto& binarySimulation = binary.simulation;
+    binarySimulation.setResultSink(std::make_unique<porting::BinaryResultSink<T>>(resultFile, &binarySimulation, 4));
+
+    // an interrupted simulation contains the completed chunks
+    binarySimulation.initialize();
+    binarySimulation.runEvents(4);
+    {
+        porting::BinaryResultReader<T> reader(resultFile);
+        ASSERT_FALSE(reader.isComplete());
+        ASSERT_EQ(reader.getNumberOfChunks(), 1);
+        ASSERT_EQ(reader.getNumberOfStates(), 4);
+    }
+    binarySimulation.runUntil(std::numeric_limits<T>::max());
+
+    porting::BinaryResultReader<T> reader(resultFile);
+    const size_t nStates = memoryResult->getStates().size();
+    ASSERT_TRUE(reader.isComplete());
+    ASSERT_EQ(reader.getNumberOfStates(), nStates);
+    ASSERT_EQ(reader.getNumberOfChunks(), (nStates + 3) / 4);
+    ASSERT_EQ(reader.getNodeIds(), memoryResult->getNodeIds());
+    ASSERT_EQ(reader.getEdgeIds(), memoryResult->getEdgeIds());
+    ASSERT_EQ(reader.getPlatform(), "BigDroplet");
+
+    // the columns of single channels are read from the mapped file
+    for (size_t chunk = 0; chunk < reader.getNumberOfChunks(); ++chunk) {
+        auto times = reader.getTimes(chunk);
+        auto flowRates = reader.getFlowRates(chunk, 2);
+        ASSERT_EQ(flowRates.size(), reader.getChunk(chunk).nStates);
+        for (size_t s = 0; s < flowRates.size(); ++s) {
+            auto& state = memoryResult->getStates().at(reader.getChunk(chunk).firstState + s);
+            ASSERT_EQ(times[s], state->getTime());
+            ASSERT_EQ(flowRates[s], state->getFlowRates().at(2));
+        }
+    }
+    ASSERT_THROW(reader.getPressures(0, 100), std::out_of_range);
+
+    // the chunks of a time range
+    T lastTime = memoryResult->getStates().back()->getTime();
+    auto [firstChunk, lastChunk] = reader.findChunks(lastTime, lastTime);
+    ASSERT_EQ(firstChunk, reader.getNumberOfChunks() - 1);
+    ASSERT_EQ(lastChunk, reader.getNumberOfChunks());
+    ASSERT_EQ(reader.findChunks(0.0, lastTime).second - reader.findChunks(0.0, lastTime).first, reader.getNumberOfChunks());
+
+    // the converted file equals the JSON result
+    ASSERT_EQ(porting::binaryResultToJSON<T>(resultFile), porting::resultToJSON<T>(&memorySimulation));
+
+    // other files and value widths are rejected
+    ASSERT_THROW(porting::BinaryResultReader<T> jsonReader(file), std::invalid_argument);
+    ASSERT_THROW(porting::BinaryResultReader<float> floatReader(resultFile), std::invalid_argument);
+
+    // reads beyond a corrupted droplet section or a truncated file are rejected
+    std::string corruptFile = (std::filesystem::temp_directory_path() / "mmft_corrupt_result.bin").string();
+    const uint64_t lastOffset = reader.getChunk(reader.getNumberOfChunks() - 1).offset;
+    const uint64_t dropletOffset = reader.getChunk(0).offset + sizeof(porting::BinaryChunkHeader)
+        + sizeof(T) * reader.getChunk(0).nStates * (1 + reader.getNodeIds().size() + reader.getEdgeIds().size());
+    std::filesystem::copy_file(resultFile, corruptFile, std::filesystem::copy_options::overwrite_existing);
+    {
+        std::fstream corrupt(corruptFile, std::ios::in | std::ios::out | std::ios::binary);
+        const uint32_t nDroplets = std::numeric_limits<uint32_t>::max();
+        corrupt.seekp(dropletOffset);
+        corrupt.write(reinterpret_cast<const char*>(&nDroplets), sizeof(uint32_t));
+    }
+    {
+        porting::BinaryResultReader<T> corruptReader(corruptFile);
+        ASSERT_THROW(corruptReader.readDroplets(0), std::invalid_argument);
+        ASSERT_EQ(corruptReader.readDroplets(1).size(), reader.getChunk(1).nStates);
+    }
+    std::filesystem::copy_file(resultFile, corruptFile, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::resize_file(corruptFile, std::filesystem::file_size(resultFile) - 4);
+    {
+        porting::BinaryResultReader<T> truncatedReader(corruptFile);
+        ASSERT_EQ(truncatedReader.getNumberOfChunks(), reader.getNumberOfChunks());
+        ASSERT_THROW(truncatedReader.readFluids(), std::invalid_argument);
+    }
+    std::filesystem::resize_file(corruptFile, lastOffset + sizeof(porting::BinaryChunkHeader) + 8);
+    {
+        porting::BinaryResultReader<T> truncatedReader(corruptFile);
+        ASSERT_EQ(truncatedReader.getNumberOfChunks(), reader.getNumberOfChunks() - 1);
+        ASSERT_THROW(truncatedReader.readFluids(), std::invalid_argument);
+    }
+    std::filesystem::remove(corruptFile);
+    std::filesystem::remove(resultFile);
+}
+
+TEST(BigDroplet, recordingPolicies) {
+    json jsonString = json::parse(std::ifstream("../examples/1D/Droplet/Network1.JSON"));
+
+    // all states
+    DropletSimulation full(jsonString);
+    auto& fullSimulation = full.simulation;
+    fullSimulation.simulate();
+    auto& fullStates = fullSimulation.getSimulationResults()->getStates();
+    const size_t nStates = fullStates.size();
+    const T endTime = fullStates.back()->getTime();
+    ASSERT_GT(nStates, 3);
+
+    // every third state and the final state
+    DropletSimulation events(jsonString);
+    auto& eventSimulation = events.simulation;
+    eventSimulation.setRecordingPolicy(sim::RecordingPolicy::EventInterval, 3);
+    eventSimulation.simulate();
+    auto& eventStates = eventSimulation.getSimulationResults()->getStates();
+    ASSERT_EQ(eventStates.size(), (nStates + 2) / 3 + ((nStates - 1) % 3 != 0 ? 1 : 0));
+    for (size_t i = 0; i < eventStates.size(); ++i) {
+        size_t fullIndex = std::min(3 * i, nStates - 1);
+        ASSERT_EQ(eventStates[i]->getTime(), fullStates[fullIndex]->getTime());
+        ASSERT_EQ(eventStates[i]->getFlowRates().at(2), fullStates[fullIndex]->getFlowRates().at(2));
+    }
+
+    // fixed time intervals, the flow is constant between the events
+    const T interval = endTime / 7.5;
+    DropletSimulation samples(jsonString);
+    auto& timeSimulation = samples.simulation;
+    timeSimulation.setRecordingPolicy(sim::RecordingPolicy::TimeInterval, interval);
+    timeSimulation.simulate();
+    auto& timeStates = timeSimulation.getSimulationResults()->getStates();
+    ASSERT_EQ(timeStates.size(), 9);
+    for (size_t i = 0; i < timeStates.size(); ++i) {
+        T sampleTime = (i + 1 < timeStates.size()) ? i * interval : endTime;
+        ASSERT_EQ(timeStates[i]->getTime(), sampleTime);
+        auto fullState = std::find_if(fullStates.rbegin(), fullStates.rend(), [sampleTime](auto& state) { return state->getTime() <= sampleTime; });
+        ASSERT_EQ(timeStates[i]->getFlowRates().at(2), (*fullState)->getFlowRates().at(2));
+    }
+
+    // the boundaries move linearly between the events, hence the positions of the boundaries that stay in their channel are interpolated
+    int nInterpolated = 0;
+    for (size_t i = 1; i + 1 < timeStates.size(); ++i) {
+        T sampleTime = timeStates[i]->getTime();
+        auto next = std::find_if(fullStates.begin(), fullStates.end(), [sampleTime](auto& state) { return state->getTime() > sampleTime; });
+        auto& before = *(next - 1);
+        auto& after = *next;
+        for (auto& [dropletId, position] : timeStates[i]->getDropletPositions()) {
+            // droplets that left the network until the next event are not saved anymore
+            if (after->getDropletPositions().count(dropletId) == 0) {
+                continue;
+            }
+            auto& boundariesBefore = before->getDropletPositions().at(dropletId).boundaries;
+            auto& boundariesAfter = after->getDropletPositions().at(dropletId).boundaries;
+            ASSERT_EQ(position.boundaries.size(), boundariesBefore.size());
+            for (size_t k = 0; k < position.boundaries.size() && k < boundariesAfter.size(); ++k) {
+                auto& positionBefore = const_cast<sim::DropletBoundary<T>&>(boundariesBefore[k]).getChannelPosition();
+                auto& positionAfter = const_cast<sim::DropletBoundary<T>&>(boundariesAfter[k]).getChannelPosition();
+                if (positionBefore.getChannel() != positionAfter.getChannel()) {
+                    continue;
+                }
+                T fraction = (sampleTime - before->getTime()) / (after->getTime() - before->getTime());
+                T expected = positionBefore.getPosition() + fraction * (positionAfter.getPosition() - positionBefore.getPosition());
+                ASSERT_NEAR(const_cast<sim::DropletBoundary<T>&>(position.boundaries[k]).getChannelPosition().getPosition(), expected, 1e-9);
+                nInterpolated++;
+            }
+        }
+    }
+    ASSERT_GT(nInterpolated, 0);
+    ASSERT_THROW(timeSimulation.setRecordingPolicy(sim::RecordingPolicy::TimeInterval, 0.0), std::invalid_argument);
+    ASSERT_THROW(timeSimulation.setRecordingPolicy(sim::RecordingPolicy::EventInterval, 1.5), std::invalid_argument);
+
+    // only states with changed droplet channels or event types, but always the first and the final state
+    // the simulation is paused in fixed intervals (e.g., as in a hybrid simulation), which only moves the droplets inside their channels
+    const T pause = endTime / 32;
+    auto runPaused = [pause](sim::Simulation<T>& simulation) {
+        for (int k = 1; !simulation.isFinished(); ++k) {
+            simulation.runUntil(k * pause);
+        }
+    };
+    DropletSimulation paused(jsonString);
+    runPaused(paused.simulation);
+    auto& pausedStates = paused.simulation.getSimulationResults()->getStates();
+    DropletSimulation changes(jsonString);
+    auto& changeSimulation = changes.simulation;
+    changeSimulation.setRecordingPolicy(sim::RecordingPolicy::Change);
+    runPaused(changeSimulation);
+    auto& changeStates = changeSimulation.getSimulationResults()->getStates();
+
+    // the pauses do not store states, hence the same states are saved as without pauses
+    ASSERT_EQ(pausedStates.size(), nStates);
+    ASSERT_EQ(changeStates.size(), nStates);
+    for (size_t i = 0; i < changeStates.size(); ++i) {
+        ASSERT_NEAR(changeStates[i]->getTime(), fullStates[i]->getTime(), 1e-12 * endTime);
+    }
+    ASSERT_EQ(changeStates.front()->getTime(), 0.0);
+    ASSERT_EQ(changeStates.back()->getTime(), pausedStates.back()->getTime());
+
+    // a subset of the nodes and channels, defined in the JSON file
+    jsonString["simulation"]["recording"] = {{"policy", "EventInterval"}, {"interval", 2}, {"nodes", {1, 3}}, {"channels", {2}}};
+    DropletSimulation subset(jsonString);
+    auto& subsetSimulation = subset.simulation;
+    subsetSimulation.simulate();
+    auto subsetResult = subsetSimulation.getSimulationResults();
+    ASSERT_EQ(subsetSimulation.getRecordingPolicy(), sim::RecordingPolicy::EventInterval);
+    ASSERT_EQ(subsetResult->getNodeIds(), std::vector<int>({1, 3}));
+    ASSERT_EQ(subsetResult->getEdgeIds(), std::vector<int>({2}));
+    ASSERT_EQ(subsetResult->getStates().back()->getPressures().at(3), fullStates.back()->getPressures().at(3));
+    auto subsetJson = porting::resultToJSON<T>(&subsetSimulation);
+    ASSERT_EQ(subsetJson["network"][0]["nodes"].size(), 2);
+    ASSERT_EQ(subsetJson["network"][0]["channels"][0]["id"], 2);
+    ASSERT_EQ(subsetResult->getStates().back()->getDropletPositions().size(), fullStates.back()->getDropletPositions().size());
+
+    // the droplet positions are skipped or only saved for the recorded droplets
+    jsonString["simulation"]["recording"]["droplets"] = false;
+    DropletSimulation withoutDroplets(jsonString);
+    withoutDroplets.simulation.simulate();
+    for (auto& state : withoutDroplets.simulation.getSimulationResults()->getStates()) {
+        ASSERT_TRUE(state->getDropletPositions().empty());
+    }
+    jsonString["simulation"]["recording"]["droplets"] = {0, 100};
+    DropletSimulation someDroplets(jsonString);
+    someDroplets.simulation.simulate();
+    auto& someStates = someDroplets.simulation.getSimulationResults()->getStates();
+    for (size_t i = 0; i + 1 < someStates.size(); ++i) {
+        ASSERT_EQ(someStates[i]->getDropletPositions().size(), 1);
+        ASSERT_EQ(someStates[i]->getDropletPositions().count(0), 1);
+    }
+    jsonString["simulation"]["recording"].erase("droplets");
+
+    // unknown ids and policies are rejected
+    DropletSimulation invalid(jsonString);
+    auto& invalidSimulation = invalid.simulation;
+    invalidSimulation.setRecordedChannels({2, 100});
+    ASSERT_THROW(invalidSimulation.simulate(), std::invalid_argument);
+    jsonString["simulation"]["recording"]["policy"] = "Sometimes";
+    ASSERT_THROW(DropletSimulation policy(jsonString), std::invalid_argument);
+}
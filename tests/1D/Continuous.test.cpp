@@ -309,3 +309,117 @@ TEST(Continuous, Y_Network) {
                 result2->getStates().at(0)->getFlowRates().at(pump22->getId()), 1e-16);
 
 }
+
+TEST(Continuous, stepwiseSimulation) {
+    // define simulation
+    sim::Simulation<T> testSimulation;
+    testSimulation.setType(sim::Type::Abstract);
+    testSimulation.setPlatform(sim::Platform::Continuous);
+    arch::Network<T> network;
+    testSimulation.setNetwork(&network);
+
+    // nodes, pump and channel
+    auto node0 = network.addNode(0.0, 0.0, true);
+    auto node1 = network.addNode(1e-3, 0.0, false);
+    auto node2 = network.addNode(2e-3, 0.0, true);
+    auto pump = network.addPressurePump(node0->getId(), node1->getId(), 1e3);
+    auto c1 = network.addChannel(node1->getId(), node2->getId(), 100e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+
+    auto fluid0 = testSimulation.addFluid(1e-3, 997.0, 1.0);
+    testSimulation.setContinuousPhase(fluid0->getId());
+    sim::ResistanceModel1D<T> resistanceModel = sim::ResistanceModel1D<T>(testSimulation.getContinuousPhase()->getViscosity());
+    testSimulation.setResistanceModel(&resistanceModel);
+    network.isNetworkValid();
+    network.sortGroups();
+
+    // a continuous simulation consists of a single step
+    ASSERT_FALSE(testSimulation.isFinished());
+    ASSERT_TRUE(testSimulation.step());
+    ASSERT_TRUE(testSimulation.isFinished());
+    ASSERT_FALSE(testSimulation.step());
+    T flowRate = c1->getFlowRate();
+
+    // after modifying the pump, the simulation is initialized again
+    pump->setPressure(2e3);
+    testSimulation.initialize();
+    testSimulation.runUntil(1.0);
+    ASSERT_TRUE(testSimulation.isFinished());
+    ASSERT_NEAR(c1->getFlowRate(), 2 * flowRate, 1e-12 * std::abs(flowRate));
+    ASSERT_EQ(testSimulation.getSimulationResults()->getStates().size(), 2);
+}
+
+TEST(Continuous, resultStore) {
+    // a chunk of 8 values holds two states of two nodes and three edges
+    result::ResultStore<T> store(8);
+    ASSERT_FALSE(store.hasLayout());
+    store.setLayout({ 0, 2 }, { 1, 3, 4 });
+    ASSERT_EQ(store.getChunkStates(), 2);
+
+    std::vector<std::vector<T>> pressures;
+    std::vector<std::vector<T>> flowRates;
+    for (int i = 0; i < 5; ++i) {
+        pressures.push_back({ 1.0 * i, 2.0 * i });
+        flowRates.push_back({ 0.1 * i, 0.2 * i, 0.3 * i });
+        ASSERT_EQ(store.addState(0.5 * i, pressures.back().data(), flowRates.back().data()), i);
+    }
+    ASSERT_EQ(store.size(), 5);
+    ASSERT_EQ(store.getChunks(), 3);
+    ASSERT_EQ(store.getTimes().back(), 2.0);
+
+    // the views of the states can be used like the former maps from the ids to the values
+    auto state1 = store.getPressures(1);
+    for (int i = 0; i < 5; ++i) {
+        auto statePressures = store.getPressures(i);
+        auto stateFlowRates = store.getFlowRates(i);
+        ASSERT_EQ(statePressures.size(), 2);
+        ASSERT_EQ(statePressures.at(2), pressures[i][1]);
+        ASSERT_EQ(stateFlowRates.at(4), flowRates[i][2]);
+        ASSERT_EQ(stateFlowRates.count(3), 1);
+        ASSERT_EQ(stateFlowRates.count(2), 0);
+        ASSERT_THROW(stateFlowRates.at(2), std::out_of_range);
+        size_t k = 0;
+        for (auto& [id, flowRate] : stateFlowRates) {
+            ASSERT_EQ(id, store.getEdgeIds()[k]);
+            ASSERT_EQ(flowRate, flowRates[i][k]);
+            k++;
+        }
+        ASSERT_EQ(k, 3);
+    }
+    // the store grew without moving the earlier states
+    ASSERT_EQ(state1.at(0), 1.0);
+    ASSERT_EQ(state1.data(), store.getPressures(1).data());
+
+    // the layout is fixed once states were stored
+    store.setLayout({ 0, 2 }, { 1, 3, 4 });
+    ASSERT_THROW(store.setLayout({ 0, 1 }, { 2 }), std::invalid_argument);
+    store.clear();
+    ASSERT_EQ(store.size(), 0);
+    ASSERT_FALSE(store.hasLayout());
+
+    // the simulation stores all nodes and edges of the network
+    sim::Simulation<T> testSimulation;
+    testSimulation.setType(sim::Type::Abstract);
+    testSimulation.setPlatform(sim::Platform::Continuous);
+    arch::Network<T> network;
+    testSimulation.setNetwork(&network);
+    auto node0 = network.addNode(0.0, 0.0, true);
+    auto node1 = network.addNode(1e-3, 0.0, false);
+    auto node2 = network.addNode(2e-3, 0.0, true);
+    auto pump = network.addPressurePump(node0->getId(), node1->getId(), 1e3);
+    auto c1 = network.addChannel(node1->getId(), node2->getId(), 100e-6, 100e-6, 1e-3, arch::ChannelType::NORMAL);
+    auto fluid0 = testSimulation.addFluid(1e-3, 997.0, 1.0);
+    testSimulation.setContinuousPhase(fluid0->getId());
+    sim::ResistanceModel1D<T> resistanceModel = sim::ResistanceModel1D<T>(testSimulation.getContinuousPhase()->getViscosity());
+    testSimulation.setResistanceModel(&resistanceModel);
+    network.isNetworkValid();
+    network.sortGroups();
+    testSimulation.simulate();
+
+    auto result = testSimulation.getSimulationResults();
+    ASSERT_EQ(result->getStore().size(), 1);
+    ASSERT_EQ(result->getStore().getNodeIds(), std::vector<int>({ node0->getId(), node1->getId(), node2->getId() }));
+    ASSERT_EQ(result->getStore().getEdgeIds().size(), 2);
+    ASSERT_EQ(result->getStates().at(0)->getPressures().at(node1->getId()), node1->getPressure());
+    ASSERT_EQ(result->getStates().at(0)->getFlowRates().at(c1->getId()), c1->getFlowRate());
+    ASSERT_EQ(result->getStates().at(0)->getFlowRates().at(pump->getId()), pump->getFlowRate());
+}
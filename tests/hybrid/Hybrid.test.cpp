@@ -109,6 +109,239 @@ TEST(Continuous, Case1a) {
 
 }
 
+TEST(Hybrid, moduleParameters) {
+    // define network with a single module
+    arch::Network<T> network;
+    auto node0 = network.addNode(1.75e-3, 1e-3, false);
+    auto node1 = network.addNode(2.25e-3, 1e-3, true);
+    std::unordered_map<int, std::shared_ptr<arch::Node<T>>> Nodes;
+    Nodes.try_emplace(node0->getId(), network.getNode(node0->getId()));
+    Nodes.try_emplace(node1->getId(), network.getNode(node1->getId()));
+    std::unordered_map<int, arch::Opening<T>> Openings;
+    Openings.try_emplace(node0->getId(), arch::Opening<T>(network.getNode(node0->getId()), std::vector<T>({1.0, 0.0}), 1e-4));
+    Openings.try_emplace(node1->getId(), arch::Opening<T>(network.getNode(node1->getId()), std::vector<T>({-1.0, 0.0}), 1e-4));
+    auto module = network.addModule("straight", "../examples/STL/straight.stl", { 1.75e-3, 0.75e-3 }, { 5e-4, 5e-4 }, Nodes, Openings,
+                                    1e-4, 1e-1, 0.1, 20, 1e-1, 0.55);
+
+    ASSERT_EQ(module->getTheta(), 10);
+    ASSERT_FALSE(module->getAdaptiveTheta());
+
+    module->setTheta(100);
+    ASSERT_EQ(module->getTheta(), 100);
+    ASSERT_THROW(module->setTheta(0), std::invalid_argument);
+
+    // enabling the adaptive mode clamps theta to its bounds
+    module->setAdaptiveTheta(true, 5, 50);
+    ASSERT_TRUE(module->getAdaptiveTheta());
+    ASSERT_EQ(module->getTheta(), 50);
+    ASSERT_THROW(module->setAdaptiveTheta(true, 0, 50), std::invalid_argument);
+    ASSERT_THROW(module->setAdaptiveTheta(true, 50, 5), std::invalid_argument);
+    ASSERT_THROW(module->setAdaptiveTheta(true, 5, 50, 0.0), std::invalid_argument);
+
+    // vtk output and convergence tracing
+    ASSERT_EQ(module->getVtkOutput(), arch::VtkOutput::Interval);
+    module->setVtkOutput(arch::VtkOutput::Disabled);
+    ASSERT_EQ(module->getVtkOutput(), arch::VtkOutput::Disabled);
+    ASSERT_THROW(module->setVtkOutput(arch::VtkOutput::Interval, 0), std::invalid_argument);
+    ASSERT_THROW(module->setTraceInterval(0), std::invalid_argument);
+}
+
+TEST(Hybrid, adaptiveTheta) {
+    // define network with a single module
+    arch::Network<T> network;
+    auto node0 = network.addNode(1.75e-3, 1e-3, false);
+    auto node1 = network.addNode(2.25e-3, 1e-3, true);
+    std::unordered_map<int, std::shared_ptr<arch::Node<T>>> Nodes;
+    Nodes.try_emplace(node0->getId(), network.getNode(node0->getId()));
+    Nodes.try_emplace(node1->getId(), network.getNode(node1->getId()));
+    std::unordered_map<int, arch::Opening<T>> Openings;
+    Openings.try_emplace(node0->getId(), arch::Opening<T>(network.getNode(node0->getId()), std::vector<T>({1.0, 0.0}), 1e-4));
+    Openings.try_emplace(node1->getId(), arch::Opening<T>(network.getNode(node1->getId()), std::vector<T>({-1.0, 0.0}), 1e-4));
+    auto module = network.addModule("straight", "../examples/STL/straight.stl", { 1.75e-3, 0.75e-3 }, { 5e-4, 5e-4 }, Nodes, Openings,
+                                    1e-4, 1e-1, 0.1, 20, 1e-1, 0.55);
+    module->setAdaptiveTheta(true, 5, 80, 1e-3);
+
+    // one coupling exchange with the given boundary values
+    auto exchange = [&](T pressure) {
+        module->setPressures({{node0->getId(), pressure}, {node1->getId(), 0.0}});
+        module->setFlowRates({{node0->getId(), 1e-9}, {node1->getId(), 0.0}});
+        module->adaptTheta();
+        return module->getTheta();
+    };
+
+    // the first exchange has no previous values to compare with
+    ASSERT_EQ(exchange(100.0), 10);
+
+    // unchanged boundary values double theta up to its upper bound
+    ASSERT_EQ(exchange(100.0), 20);
+    ASSERT_EQ(exchange(100.0), 40);
+    ASSERT_EQ(exchange(100.0), 80);
+    ASSERT_EQ(exchange(100.0), 80);
+
+    // new values without setting them in an exchange do not change theta
+    module->setPressures({{node0->getId(), 150.0}, {node1->getId(), 0.0}});
+    ASSERT_EQ(module->getTheta(), 80);
+
+    // a significant change keeps theta, oscillating values halve it down to its lower bound
+    ASSERT_EQ(exchange(150.0), 80);
+    ASSERT_EQ(exchange(100.0), 40);
+    ASSERT_EQ(exchange(150.0), 20);
+    ASSERT_EQ(exchange(100.0), 10);
+    ASSERT_EQ(exchange(150.0), 5);
+    ASSERT_EQ(exchange(100.0), 5);
+
+    // small changes below the tolerance double theta again
+    ASSERT_EQ(exchange(100.01), 10);
+}
+
+TEST(Hybrid, boundaryValues) {
+    // define network with a single module
+    arch::Network<T> network;
+    auto node0 = network.addNode(1.75e-3, 1e-3, false);
+    auto node1 = network.addNode(2.25e-3, 1e-3, true);
+    std::unordered_map<int, std::shared_ptr<arch::Node<T>>> Nodes;
+    Nodes.try_emplace(node0->getId(), network.getNode(node0->getId()));
+    Nodes.try_emplace(node1->getId(), network.getNode(node1->getId()));
+    std::unordered_map<int, arch::Opening<T>> Openings;
+    Openings.try_emplace(node0->getId(), arch::Opening<T>(network.getNode(node0->getId()), std::vector<T>({1.0, 0.0}), 1e-4));
+    Openings.try_emplace(node1->getId(), arch::Opening<T>(network.getNode(node1->getId()), std::vector<T>({-1.0, 0.0}), 1e-4));
+    auto module = network.addModule("straight", "../examples/STL/straight.stl", { 1.75e-3, 0.75e-3 }, { 5e-4, 5e-4 }, Nodes, Openings,
+                                    1e-4, 1e-1, 0.1, 20, 1e-1, 0.55);
+    module->lbmInit(1e-3, 1e3);
+
+    // a velocity is applied at node0 and a density at node1
+    module->setGroundNodes({{node0->getId(), true}, {node1->getId(), false}});
+    module->prepareGeometry();
+    module->prepareLattice();
+    module->setPressures({{node0->getId(), 100.0}, {node1->getId(), 0.0}});
+    module->setFlowRates({{node0->getId(), 1e-9}, {node1->getId(), 0.0}});
+    module->setBoundaryValues(0);
+    ASSERT_EQ(module->getBoundaryUpdates(), 2);
+    auto velocity = module->getBoundaryValue(node0->getId());
+    auto density = module->getBoundaryValue(node1->getId());
+    ASSERT_NEAR(velocity->getValue(), 1.5e-9 / 1e-4, 1e-12);
+    ASSERT_NEAR(density->getValue(), 1.0, 1e-12);
+
+    // unchanged values are skipped
+    module->setBoundaryValues(1);
+    ASSERT_EQ(module->getBoundaryUpdates(), 2);
+
+    // only the changed value is applied again
+    module->setPressures({{node0->getId(), 100.0}, {node1->getId(), 50.0}});
+    module->setBoundaryValues(2);
+    ASSERT_EQ(module->getBoundaryUpdates(), 3);
+    module->setFlowRates({{node0->getId(), 2e-9}, {node1->getId(), 0.0}});
+    module->setBoundaryValues(3);
+    ASSERT_EQ(module->getBoundaryUpdates(), 4);
+
+    // the functors of the openings are updated in place
+    ASSERT_EQ(module->getBoundaryValue(node0->getId()), velocity);
+    ASSERT_EQ(module->getBoundaryValue(node1->getId()), density);
+    ASSERT_NEAR(velocity->getValue(), 3e-9 / 1e-4, 1e-12);
+    ASSERT_NEAR(density->getValue(), 51.0, 1e-12);
+
+    // a changed type of the boundary condition is applied again, although the coupled values did not change
+    module->setGroundNodes({{node0->getId(), false}, {node1->getId(), true}});
+    module->prepareLattice();
+    module->setBoundaryValues(4);
+    ASSERT_EQ(module->getBoundaryUpdates(), 6);
+    module->setBoundaryValues(5);
+    ASSERT_EQ(module->getBoundaryUpdates(), 6);
+}
+
+TEST(Hybrid, concurrentModules) {
+    // define two networks with two independent modules each
+    auto addModules = [](arch::Network<T>& network) {
+        for (int i = 0; i < 2; ++i) {
+            auto node0 = network.addNode(1.75e-3 + i * 1e-3, 1e-3, false);
+            auto node1 = network.addNode(2.25e-3 + i * 1e-3, 1e-3, true);
+            std::unordered_map<int, std::shared_ptr<arch::Node<T>>> Nodes;
+            Nodes.try_emplace(node0->getId(), network.getNode(node0->getId()));
+            Nodes.try_emplace(node1->getId(), network.getNode(node1->getId()));
+            std::unordered_map<int, arch::Opening<T>> Openings;
+            Openings.try_emplace(node0->getId(), arch::Opening<T>(network.getNode(node0->getId()), std::vector<T>({1.0, 0.0}), 1e-4));
+            Openings.try_emplace(node1->getId(), arch::Opening<T>(network.getNode(node1->getId()), std::vector<T>({-1.0, 0.0}), 1e-4));
+            auto module = network.addModule("straight" + std::to_string(i), "../examples/STL/straight.stl", { 1.75e-3 + i * 1e-3, 0.75e-3 }, { 5e-4, 5e-4 },
+                                            Nodes, Openings, 1e-4, 1e-1, 0.1, 20, 1e-1, 0.55);
+            module->setVtkOutput(arch::VtkOutput::Disabled);
+            module->setGroundNodes({{node0->getId(), true}, {node1->getId(), false}});
+            module->lbmInit(1e-3, 1e3);
+            module->prepareGeometry();
+            module->prepareLattice();
+            module->setPressures({{node0->getId(), 100.0}, {node1->getId(), 0.0}});
+            module->setFlowRates({{node0->getId(), 1e-9}, {node1->getId(), 0.0}});
+        }
+    };
+    arch::Network<T> serialNetwork;
+    arch::Network<T> concurrentNetwork;
+    addModules(serialNetwork);
+    addModules(concurrentNetwork);
+
+    // the modules are stepped on the threads of a pool with the same results as serially
+    sim::ThreadPool pool(2);
+    bool serialConverged = sim::conductCFDSimulation(&serialNetwork, nullptr, 1);
+    bool concurrentConverged = sim::conductCFDSimulation(&concurrentNetwork, &pool, 0);
+    ASSERT_EQ(serialConverged, concurrentConverged);
+    for (auto& [key, module] : concurrentNetwork.getModules()) {
+        auto& serialModule = serialNetwork.getModules().at(key);
+        ASSERT_EQ(module->getStep(), module->getTheta());
+        ASSERT_EQ(module->getStep(), serialModule->getStep());
+        ASSERT_EQ(module->getPressures(), serialModule->getPressures());
+        ASSERT_EQ(module->getFlowRates(), serialModule->getFlowRates());
+    }
+}
+
+TEST(Hybrid, couplingAccelerators) {
+    // Linear fixed-point problem x = G(x) = M x + b with a spectral radius close to 1, as a model of the 1D-CFD coupling
+    const std::vector<std::vector<T>> M = { { 0.9, 0.05, 0.0 }, { 0.05, 0.8, 0.1 }, { 0.0, 0.1, 0.85 } };
+    const std::vector<T> b = { 100.0, 50.0, 20.0 };
+    const std::vector<T> relaxation(3, 1.0);
+    const std::vector<T> scales(3, 1.0);
+
+    auto solve = [&](nodal::CouplingAccelerator<T>& accelerator, std::vector<T>& x) {
+        for (int iteration = 0; iteration < 1000; ++iteration) {
+            std::vector<T> g(3);
+            T residual = 0.0;
+            for (int i = 0; i < 3; ++i) {
+                g[i] = b[i] + M[i][0] * x[0] + M[i][1] * x[1] + M[i][2] * x[2];
+                residual = std::max(residual, std::abs(g[i] - x[i]));
+            }
+            if (residual < 1e-8) {
+                return accelerator.getIterations();
+            }
+            x = accelerator.update(x, g, relaxation, scales);
+        }
+        return -1;
+    };
+
+    nodal::ConstantRelaxation<T> constant;
+    nodal::AitkenRelaxation<T> aitken;
+    nodal::AndersonMixing<T> anderson(3);
+    std::vector<T> xConstant(3, 0.0);
+    std::vector<T> xAitken(3, 0.0);
+    std::vector<T> xAnderson(3, 0.0);
+    int nConstant = solve(constant, xConstant);
+    int nAitken = solve(aitken, xAitken);
+    int nAnderson = solve(anderson, xAnderson);
+
+    ASSERT_GT(nConstant, 0);
+    ASSERT_GT(nAitken, 0);
+    ASSERT_GT(nAnderson, 0);
+    ASSERT_LT(nAitken, nConstant);
+    ASSERT_LT(nAnderson, nAitken);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_NEAR(xAitken[i], xConstant[i], 1e-6);
+        ASSERT_NEAR(xAnderson[i], xConstant[i], 1e-6);
+    }
+
+    // The constant relaxation reproduces the relaxation of the former nodal analysis
+    std::vector<T> values = constant.update({ 0.0, 200.0 }, { 100.0, 100.0 }, { 0.1, 0.5 }, { 1.0, 1.0 });
+    ASSERT_DOUBLE_EQ(values[0], 100.0);
+    ASSERT_DOUBLE_EQ(values[1], 200.0 + 0.5 * (100.0 - 200.0));
+
+    ASSERT_THROW(nodal::AndersonMixing<T>(0), std::invalid_argument);
+}
+
 // TEST(Continuous, Case1aJSON) {
     
 //     std::string file = "../examples/Hybrid/Network1a.JSON";